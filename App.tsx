@@ -4,12 +4,18 @@ import { ParameterType } from './types';
 import { synthManager } from './services/SynthManager';
 import Visualizer from './components/Visualizer';
 import BubbleXYPad from './components/BubbleXYPad';
+import TouchSurface from './components/TouchSurface';
 import GearSequencer from './components/GearSequencer';
 import EchoVesselUI from './components/EchoVesselUI';
 import VocoderUI from './components/VocoderUI';
 import BreitemaUI from './components/BreitemaUI';
+import GranularUI from './components/GranularUI';
+import SamplerUI from './components/SamplerUI';
 import EngineSelector from './components/EngineSelector';
 import ControlsPanel from './components/ControlsPanel';
+import DiagnosticsPanel from './components/DiagnosticsPanel';
+import RenderPanel from './components/RenderPanel';
+import PitchReadout from './components/PitchReadout';
 import { useSynth } from './hooks/useSynth';
 
 const NOTES = [
@@ -79,9 +85,27 @@ const PARAM_LABELS_BREITEMA: Record<string, string> = {
   diffusion: "REVERBERACIÓN"
 };
 
+const PARAM_LABELS_GRANS: Record<string, string> = {
+  pressure: "DENSIDADE",
+  resonance: "TONO",
+  viscosity: "POSICIÓN",
+  turbulence: "DISPERSIÓN",
+  diffusion: "TAMAÑO GRAN"
+};
+
+const PARAM_LABELS_SAMPLER: Record<string, string> = {
+  pressure: "BRILLO",
+  resonance: "RESONANCIA",
+  viscosity: "INICIO",
+  turbulence: "FUNDIDO",
+  diffusion: "LIBERACIÓN"
+};
+
 function App() {
   const [apiKey, setApiKey] = useState('');
   const [isSettingsOpen, setIsSettingsOpen] = useState(false);
+  const [isDiagnosticsOpen, setIsDiagnosticsOpen] = useState(false);
+  const [isRenderOpen, setIsRenderOpen] = useState(false);
   const [isMobileMenuOpen, setIsMobileMenuOpen] = useState(false);
   const [echoVial, setEchoVial] = useState<'neutral' | 'mercury' | 'amber'>('neutral');
 
@@ -94,15 +118,28 @@ function App() {
     isAiLoading,
     playingFrequencies,
     switchEngine,
+    isLayered,
+    toggleLayer,
     toggleEngine,
     updateParam,
     toggleNote,
     generateAIPatch,
+    generateAIScene,
+    variationCount,
+    variationIndex,
+    variationMorph,
+    nextVariation,
+    prevVariation,
+    morphVariation,
     setAiPrompt,
     handleStart,
     restoreAudio
   } = useSynth('criosfera', apiKey);
 
+  // Criosfera pad: global XY parameters, or the multi-touch surface (a voice per finger)
+  const [isTouchSurface, setIsTouchSurface] = useState(false);
+  // Keyboard voices follow the pitch sung into the microphone
+  const [isVoiceFollow, setIsVoiceFollow] = useState(false);
   const [xyParams, setXyParams] = useState({
     x: ParameterType.RESONANCE,
     y: ParameterType.PRESSURE
@@ -120,6 +157,8 @@ function App() {
         return PARAM_LABELS_ECHO_NEUTRAL;
       case 'vocoder': return PARAM_LABELS_VOCODER;
       case 'breitema': return PARAM_LABELS_BREITEMA;
+      case 'grans': return PARAM_LABELS_GRANS;
+      case 'sampler': return PARAM_LABELS_SAMPLER;
       default: return PARAM_LABELS_CRIOSFERA;
     }
   }
@@ -135,6 +174,10 @@ function App() {
       return { bg: 'bg-[#0d1117]', text: 'text-emerald-100', accent: 'text-emerald-400', border: 'border-emerald-900/30' };
     } else if (currentEngine === 'breitema') {
       return { bg: 'bg-[#0f1318]', text: 'text-[#9faab8]', accent: 'text-[#8be9fd]', border: 'border-[#44475a]/40' };
+    } else if (currentEngine === 'grans') {
+      return { bg: 'bg-[#14110d]', text: 'text-amber-100', accent: 'text-amber-300', border: 'border-amber-900/30' };
+    } else if (currentEngine === 'sampler') {
+      return { bg: 'bg-[#100d16]', text: 'text-violet-100', accent: 'text-violet-300', border: 'border-violet-900/30' };
     } else {
       return { bg: 'bg-[#0a0f14]', text: 'text-slate-200', accent: 'text-cyan-500', border: 'border-cyan-900/30' };
     }
@@ -201,6 +244,20 @@ function App() {
               onChange={(e) => setApiKey(e.target.value)}
             />
             <div className="flex justify-end gap-2">
+              <button
+                onClick={() => { setIsSettingsOpen(false); setIsDiagnosticsOpen(true); }}
+                className="mr-auto px-2 py-2 text-[10px] uppercase tracking-widest text-stone-500 hover:text-stone-300"
+                title="Histogramas de precisión dos disparos"
+              >
+                Diagnóstico
+              </button>
+              <button
+                onClick={() => { setIsSettingsOpen(false); setIsRenderOpen(true); }}
+                className="px-2 py-2 text-[10px] uppercase tracking-widest text-stone-500 hover:text-stone-300"
+                title="Render longo do motor actual a un ficheiro WAV"
+              >
+                Exportar
+              </button>
               <button onClick={() => setIsSettingsOpen(false)} className="px-4 py-2 text-stone-400">Cancelar</button>
               <button onClick={() => saveApiKey(apiKey)} className="px-4 py-2 bg-orange-600 rounded">Gardar</button>
             </div>
@@ -208,6 +265,9 @@ function App() {
         </div>
       )}
 
+      <DiagnosticsPanel isOpen={isDiagnosticsOpen} onClose={() => setIsDiagnosticsOpen(false)} />
+      <RenderPanel isOpen={isRenderOpen} onClose={() => setIsRenderOpen(false)} engine={currentEngine} state={state} />
+
       <EngineSelector currentEngine={currentEngine} onEngineChange={switchEngine} />
 
       <aside className={`hidden md:flex w-80 h-full bg-black/20 backdrop-blur-xl border-r ${theme.border} p-8 z-30`}>
@@ -222,9 +282,16 @@ function App() {
           setAiPrompt={setAiPrompt}
           apiKey={apiKey}
           generateAIPatch={generateAIPatch}
+          generateAIScene={generateAIScene}
           isAiLoading={isAiLoading}
           titanReport={titanReport}
           setIsSettingsOpen={setIsSettingsOpen}
+          variationCount={variationCount}
+          variationIndex={variationIndex}
+          variationMorph={variationMorph}
+          prevVariation={prevVariation}
+          nextVariation={nextVariation}
+          morphVariation={morphVariation}
         />
       </aside>
 
@@ -248,9 +315,16 @@ function App() {
               setAiPrompt={setAiPrompt}
               apiKey={apiKey}
               generateAIPatch={generateAIPatch}
+              generateAIScene={generateAIScene}
               isAiLoading={isAiLoading}
               titanReport={titanReport}
               setIsSettingsOpen={setIsSettingsOpen}
+              variationCount={variationCount}
+              variationIndex={variationIndex}
+              variationMorph={variationMorph}
+              prevVariation={prevVariation}
+              nextVariation={nextVariation}
+              morphVariation={morphVariation}
             />
           </ControlsContentWrapper>
         </div>
@@ -265,12 +339,16 @@ function App() {
           >
             <span className={`w-2 h-2 rounded-full ${isCurrentActive ? 'bg-green-500 shadow-[0_0_8px_rgba(34,197,94,0.6)]' : 'bg-gray-600'}`} />
             <h1 className={`text-xl font-bold tracking-tighter uppercase ${isCurrentActive ? theme.accent : 'opacity-50'}`}>
-              {{ 'criosfera': 'Criosfera', 'gearheart': 'Gearheart', 'echo-vessel': 'Echo Vessel', 'vocoder': 'Vocoder', 'breitema': 'Brétema' }[currentEngine] || currentEngine}
+              {{ 'criosfera': 'Criosfera', 'gearheart': 'Gearheart', 'echo-vessel': 'Echo Vessel', 'vocoder': 'Vocoder', 'breitema': 'Brétema', 'grans': 'Nube de Grans', 'sampler': 'Arquivo Sonoro' }[currentEngine] || currentEngine}
             </h1>
           </button>
           <div className="flex gap-2 pointer-events-auto">
             <button
-              onClick={restoreAudio}
+              onClick={async () => {
+                await restoreAudio();
+                // Following resumes on the new context unless the mic is refused
+                setIsVoiceFollow(synthManager.isVoiceFollowEnabled());
+              }}
               className={`p-3 bg-black/40 border ${theme.border} rounded-full opacity-70 active:scale-95 transition-transform`}
               title="Restaurar Audio"
             >
@@ -311,28 +389,48 @@ function App() {
               <div className="mt-auto w-full max-w-md flex flex-col items-center z-10">
                 <div className="w-full mb-4">
                   <div className="flex justify-between mb-2 px-2">
-                    <select
+                    {isTouchSurface ? <span /> : <select
                       value={xyParams.y}
                       onChange={(e) => setXyParams(prev => ({ ...prev, y: e.target.value as ParameterType }))}
                       className={`bg-black/60 border ${theme.border} text-[10px] ${theme.accent} uppercase tracking-widest p-1 rounded`}
                     >
                       {Object.values(ParameterType).map(p => <option key={p} value={p}>{labels[p]}</option>)}
-                    </select>
-                    <select
+                    </select>}
+                    <div className="flex gap-2">
+                      <button
+                        onClick={() => setIsTouchSurface(!isTouchSurface)}
+                        className={`bg-black/60 border ${theme.border} text-[10px] ${theme.accent} uppercase tracking-widest px-2 py-1 rounded`}
+                      >
+                        {isTouchSurface ? 'XY' : 'Superficie'}
+                      </button>
+                      <button
+                        onClick={async () => setIsVoiceFollow(await synthManager.setVoiceFollow(!synthManager.isVoiceFollowEnabled()))}
+                        className={`border ${theme.border} text-[10px] ${theme.accent} uppercase tracking-widest px-2 py-1 rounded ${isVoiceFollow ? 'bg-orange-900/50' : 'bg-black/60'}`}
+                      >
+                        Seguir voz{isVoiceFollow && <PitchReadout read={() => synthManager.getVoicePitch()} className="ml-2" />}
+                      </button>
+                      <button
+                        onClick={toggleLayer}
+                        className={`border ${theme.border} text-[10px] ${theme.accent} uppercase tracking-widest px-2 py-1 rounded ${isLayered ? 'bg-orange-900/50' : 'bg-black/60'}`}
+                      >
+                        Capa
+                      </button>
+                    </div>
+                    {isTouchSurface ? <span /> : <select
                       value={xyParams.x}
                       onChange={(e) => setXyParams(prev => ({ ...prev, x: e.target.value as ParameterType }))}
                       className={`bg-black/60 border ${theme.border} text-[10px] ${theme.accent} uppercase tracking-widest p-1 rounded`}
                     >
                       {Object.values(ParameterType).map(p => <option key={p} value={p}>{labels[p]}</option>)}
-                    </select>
+                    </select>}
                   </div>
-                  <BubbleXYPad
+                  {isTouchSurface ? <TouchSurface /> : <BubbleXYPad
                     xValue={state[xyParams.x]}
                     yValue={state[xyParams.y]}
                     xLabel={labels[xyParams.x]}
                     yLabel={labels[xyParams.y]}
                     onChange={(x, y) => { updateParam(xyParams.x, x); updateParam(xyParams.y, y); }}
-                  />
+                  />}
                 </div>
                 <div className="w-full grid grid-cols-7 gap-2">
                   {NOTES.map((note) => {
@@ -374,6 +472,20 @@ function App() {
                 theme={theme}
               />
             </div>
+          ) : currentEngine === 'grans' ? (
+            <div className="w-full h-full relative">
+              <GranularUI
+                isActive={isCurrentActive}
+                engine={isCurrentActive ? synthManager.getGranularEngine() : undefined}
+              />
+            </div>
+          ) : currentEngine === 'sampler' ? (
+            <div className="w-full h-full relative">
+              <SamplerUI
+                isActive={isCurrentActive}
+                engine={isCurrentActive ? synthManager.getSamplerEngine() : undefined}
+              />
+            </div>
           ) : (
             <div className="w-full h-full relative">
               <EchoVesselUI
@@ -0,0 +1,335 @@
+/**
+ * Frame-time benchmark for the canvas draw routines in components/draw.
+ *
+ * Every scenario renders the real draw function into an OffscreenCanvas with
+ * synthetic audio/gear data and a seeded random source, so runs are repeatable.
+ * Each frame is closed with a 1-pixel readback to force rasterization, so the
+ * timings include the raster cost and not just command recording. A second,
+ * untimed pass through a counting proxy reports per-frame allocations of
+ * gradients and parsed style strings.
+ *
+ * Query parameters: ?frames=300&warmup=30&scene=gear&seed=1
+ */
+import type { Gear } from '../services/engines/GearheartEngine';
+import { Canvas2D, RandomFn } from '../components/draw/canvas';
+import { createTitanParticles, drawTitanFrame } from '../components/draw/titanScene';
+import { drawGearBackground, drawGearFrame, GearParticle } from '../components/draw/gearScene';
+import { createCaveScene, drawCaveFrame } from '../components/draw/caveScene';
+import { drawVesselFrame } from '../components/draw/vesselScene';
+
+type FrameFn = (ctx: Canvas2D, frame: number) => void;
+
+interface Scenario {
+    scene: 'titan' | 'gear' | 'cave' | 'vessel';
+    load: string;
+    // Builds fresh state; the returned function draws one frame
+    setup: (width: number, height: number, random: RandomFn) => FrameFn;
+}
+
+interface AllocCounts {
+    gradients: number;
+    styleStrings: number;
+}
+
+export interface BenchResult {
+    scene: string;
+    load: string;
+    resolution: string;
+    frames: number;
+    mean: number;
+    p50: number;
+    p90: number;
+    p99: number;
+    max: number;
+    gradientsPerFrame: number;
+    styleStringsPerFrame: number;
+    heapKBPerFrame: number | null;
+}
+
+const RESOLUTIONS = [
+    { name: 'móbil', width: 412, height: 549 },
+    { name: 'tablet', width: 1024, height: 768 },
+    { name: 'fullhd', width: 1920, height: 1080 }
+];
+
+function mulberry32(seed: number): RandomFn {
+    let a = seed >>> 0;
+    return () => {
+        a = (a + 0x6d2b79f5) >>> 0;
+        let t = a;
+        t = Math.imul(t ^ (t >>> 15), t | 1);
+        t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+        return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+    };
+}
+
+// --- Synthetic inputs ---
+
+function makeGears(count: number, width: number, height: number): Gear[] {
+    const materials: Gear['material'][] = ['iron', 'bronze', 'copper', 'gold', 'platinum'];
+    const cols = Math.ceil(Math.sqrt(count));
+    const rows = Math.ceil(count / cols);
+    const gears: Gear[] = [];
+    for (let i = 0; i < count; i++) {
+        const radius = 25 + (i * 7) % 35;
+        gears.push({
+            id: i,
+            x: ((i % cols) + 0.5) * width / cols,
+            y: (Math.floor(i / cols) + 0.5) * height / rows,
+            radius,
+            teeth: Math.max(5, Math.round(radius / 5)),
+            angle: 0,
+            speed: (i % 2 === 0 ? 1 : -1) * 0.02,
+            isDragging: false,
+            isConnected: true,
+            material: materials[i % materials.length],
+            lastRotation: 0,
+            depth: i
+        });
+    }
+    return gears;
+}
+
+// Slowly breathing band levels, roughly what a sung phrase gives the vocoder
+function fillBands(bands: number[], frame: number) {
+    for (let i = 0; i < bands.length; i++) {
+        bands[i] = 0.05 + 0.35 * (0.5 + 0.5 * Math.sin(frame * 0.05 + i * 0.7));
+    }
+}
+
+// Unsigned-byte time-domain data, as AnalyserNode.getByteTimeDomainData writes it
+function fillWaveform(data: Uint8Array, frame: number, random: RandomFn) {
+    for (let i = 0; i < data.length; i++) {
+        const phase = (i / data.length) * Math.PI * 2;
+        const v = 0.5 * Math.sin(phase * 3 + frame * 0.1) + 0.2 * Math.sin(phase * 17) + 0.1 * (random() - 0.5);
+        data[i] = Math.max(0, Math.min(255, Math.round(128 + v * 127)));
+    }
+}
+
+const SCENARIOS: Scenario[] = [
+    ...[50, 200, 1000].map((count): Scenario => ({
+        scene: 'titan',
+        load: `${count} partículas`,
+        setup: (width, height, random) => {
+            const particles = createTitanParticles(count, width, height, random);
+            const params = { turbulence: 0.6, viscosity: 0.4, pressure: 0.7 };
+            let time = 0;
+            return (ctx) => {
+                time += 0.01 * (1 + params.turbulence * 5);
+                drawTitanFrame(ctx, width, height, time, particles, params);
+            };
+        }
+    })),
+    ...[3, 8, 16].map((count): Scenario => ({
+        scene: 'gear',
+        load: `${count} engrenaxes`,
+        setup: (width, height, random) => {
+            const gears = makeGears(count, width, height);
+            const particles: GearParticle[] = [];
+            return (ctx, frame) => {
+                gears.forEach(g => { g.angle += g.speed; });
+                drawGearBackground(ctx, width, height);
+                drawGearFrame(ctx, width, height, {
+                    gears,
+                    vibration: 0.5 + 0.5 * Math.sin(frame * 0.2),
+                    isMotorActive: true,
+                    diffusion: 0.8
+                }, particles, random);
+            };
+        }
+    })),
+    ...[0, 200, 800].map((seeded): Scenario => ({
+        scene: 'cave',
+        load: `${seeded} partículas iniciais`,
+        setup: (width, height, random) => {
+            const scene = createCaveScene(12);
+            for (let i = 0; i < seeded; i++) {
+                scene.particles.push({
+                    x: random() * width, y: random() * height, z: random() * 100,
+                    vx: random() - 0.5, vy: random() - 0.5, vz: random() - 0.5,
+                    life: 100, maxLife: 100, size: 1 + random() * 4,
+                    color: { r: 120, g: 230, b: 200 },
+                    type: 'fluid'
+                });
+            }
+            return (ctx, frame) => {
+                fillBands(scene.bands, frame);
+                drawCaveFrame(ctx, width, height, frame / 60, scene, true, random);
+            };
+        }
+    })),
+    ...[128, 1024, 4096].map((bins): Scenario => ({
+        scene: 'vessel',
+        load: `${bins} mostras`,
+        setup: (width, height, random) => {
+            const data = new Uint8Array(bins);
+            return (ctx, frame) => {
+                fillWaveform(data, frame, random);
+                drawVesselFrame(ctx, width, height, data, 'mercury');
+            };
+        }
+    }))
+];
+
+// --- Measurement ---
+
+function createContext(width: number, height: number): Canvas2D {
+    if (typeof OffscreenCanvas !== 'undefined') {
+        const ctx = new OffscreenCanvas(width, height).getContext('2d');
+        if (ctx) return ctx;
+    }
+    const canvas = document.createElement('canvas');
+    canvas.width = width;
+    canvas.height = height;
+    const ctx = canvas.getContext('2d');
+    if (!ctx) throw new Error('Canvas 2D non dispoñible');
+    return ctx;
+}
+
+const ALLOCATING_METHODS = new Set<PropertyKey>(['createRadialGradient', 'createLinearGradient', 'createConicGradient', 'createPattern']);
+const STYLE_PROPS = new Set<PropertyKey>(['fillStyle', 'strokeStyle', 'shadowColor']);
+
+/**
+ * Wrap a context to count gradient objects and style strings the browser has to parse
+ */
+function countingContext(ctx: Canvas2D, counts: AllocCounts): Canvas2D {
+    return new Proxy(ctx, {
+        get(target, prop) {
+            const value = Reflect.get(target, prop, target);
+            if (typeof value !== 'function') return value;
+            if (ALLOCATING_METHODS.has(prop)) {
+                return (...args: unknown[]) => {
+                    counts.gradients++;
+                    return value.apply(target, args);
+                };
+            }
+            return value.bind(target);
+        },
+        set(target, prop, value) {
+            if (typeof value === 'string' && STYLE_PROPS.has(prop)) counts.styleStrings++;
+            return Reflect.set(target, prop, value, target);
+        }
+    });
+}
+
+function percentile(sorted: Float64Array, p: number): number {
+    const index = Math.min(sorted.length - 1, Math.floor(p * sorted.length));
+    return sorted[index];
+}
+
+function usedHeap(): number | null {
+    const memory = (performance as unknown as { memory?: { usedJSHeapSize: number } }).memory;
+    return memory ? memory.usedJSHeapSize : null;
+}
+
+function runScenario(scenario: Scenario, width: number, height: number, frames: number, warmup: number, seed: number) {
+    // Timed pass
+    const ctx = createContext(width, height);
+    const draw = scenario.setup(width, height, mulberry32(seed));
+    for (let f = 0; f < warmup; f++) {
+        draw(ctx, f);
+        ctx.getImageData(0, 0, 1, 1);
+    }
+
+    const times = new Float64Array(frames);
+    const heapBefore = usedHeap();
+    for (let f = 0; f < frames; f++) {
+        const t0 = performance.now();
+        draw(ctx, warmup + f);
+        ctx.getImageData(0, 0, 1, 1);
+        times[f] = performance.now() - t0;
+    }
+    const heapAfter = usedHeap();
+
+    // Counting pass on fresh state, so both passes see the same frames
+    const counts: AllocCounts = { gradients: 0, styleStrings: 0 };
+    const counted = countingContext(createContext(width, height), counts);
+    const countedDraw = scenario.setup(width, height, mulberry32(seed));
+    for (let f = 0; f < warmup + frames; f++) {
+        if (f === warmup) {
+            counts.gradients = 0;
+            counts.styleStrings = 0;
+        }
+        countedDraw(counted, f);
+    }
+
+    let total = 0;
+    for (let f = 0; f < frames; f++) total += times[f];
+    const sorted = times.slice().sort();
+
+    return {
+        frames,
+        mean: total / frames,
+        p50: percentile(sorted, 0.5),
+        p90: percentile(sorted, 0.9),
+        p99: percentile(sorted, 0.99),
+        max: sorted[sorted.length - 1],
+        gradientsPerFrame: counts.gradients / frames,
+        styleStringsPerFrame: counts.styleStrings / frames,
+        // Heap delta is a lower bound: a GC during the run can make it shrink
+        heapKBPerFrame: heapBefore !== null && heapAfter !== null
+            ? Math.max(0, heapAfter - heapBefore) / 1024 / frames
+            : null
+    };
+}
+
+// --- Page ---
+
+const params = new URLSearchParams(location.search);
+const FRAMES = Number(params.get('frames') ?? 300);
+const WARMUP = Number(params.get('warmup') ?? 30);
+const SEED = Number(params.get('seed') ?? 1);
+const SCENE_FILTER = params.get('scene');
+
+const statusEl = document.getElementById('status')!;
+const tableBody = document.querySelector('#table tbody')!;
+const resultsEl = document.getElementById('results')!;
+
+function addRow(result: BenchResult) {
+    const row = document.createElement('tr');
+    const heap = result.heapKBPerFrame === null ? '–' : result.heapKBPerFrame.toFixed(2);
+    [
+        result.scene, result.load, result.resolution,
+        result.p50.toFixed(2), result.p90.toFixed(2), result.p99.toFixed(2), result.max.toFixed(2),
+        result.gradientsPerFrame.toFixed(1), result.styleStringsPerFrame.toFixed(1), heap
+    ].forEach(text => {
+        const cell = document.createElement('td');
+        cell.textContent = text;
+        row.appendChild(cell);
+    });
+    tableBody.appendChild(row);
+}
+
+async function main() {
+    const results: BenchResult[] = [];
+    const scenarios = SCENARIOS.filter(s => !SCENE_FILTER || s.scene === SCENE_FILTER);
+    const total = scenarios.length * RESOLUTIONS.length;
+
+    for (const scenario of scenarios) {
+        for (const resolution of RESOLUTIONS) {
+            statusEl.textContent = `Medindo ${results.length + 1}/${total}: ${scenario.scene} · ${scenario.load} · ${resolution.name}`;
+            // Yield so the status paints and the page stays responsive between scenarios
+            await new Promise(resolve => setTimeout(resolve, 0));
+
+            const result: BenchResult = {
+                scene: scenario.scene,
+                load: scenario.load,
+                resolution: `${resolution.name} ${resolution.width}×${resolution.height}`,
+                ...runScenario(scenario, resolution.width, resolution.height, FRAMES, WARMUP, SEED)
+            };
+            results.push(result);
+            addRow(result);
+        }
+    }
+
+    statusEl.textContent = `Feito: ${results.length} escenarios, ${FRAMES} fotogramas cada un.`;
+    resultsEl.textContent = JSON.stringify(results, null, 2);
+    console.table(results);
+    (window as unknown as { __benchResults?: BenchResult[] }).__benchResults = results;
+    document.title = 'bench: feito';
+}
+
+main().catch(err => {
+    statusEl.textContent = `Erro: ${err instanceof Error ? err.message : String(err)}`;
+    console.error(err);
+});
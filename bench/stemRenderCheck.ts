@@ -0,0 +1,145 @@
+/**
+ * Check for multi-stem scene rendering (services/StemRenderer).
+ *
+ * Renders a scene whose two stems have very different tails: Criosfera with
+ * its delay at full feedback and length (pre-roll at the 60 s cap) and Brétema
+ * (default 8 s). Chunk size follows the pre-roll, so this catches stems whose
+ * chunks drift apart. Every file must have the full length, and the mixdown
+ * must equal the equal-power sum of the stems at every frame, to within the
+ * 16-bit rounding of the three files.
+ *
+ * Query parameters: ?seconds=75&seed=1
+ */
+import { SynthState } from '../types';
+import { RENDER_SAMPLE_RATE, RenderPiece, preRollSeconds } from '../services/OfflineRenderer';
+import { SceneScore, MIX_NAME, renderStems } from '../services/StemRenderer';
+import { BreitemaEngine } from '../services/engines/BreitemaEngine';
+
+export interface CheckResult {
+    name: string;
+    ok: boolean;
+    detail: string;
+}
+
+const params = new URLSearchParams(location.search);
+const SECONDS = Number(params.get('seconds') ?? 75);
+const SEED = Number(params.get('seed') ?? 1);
+
+// Three 16-bit roundings (two stems, the mix) plus the mix gain
+const TOLERANCE = 4 / 32768;
+
+const LONG_TAIL: SynthState = { pressure: 0.7, resonance: 1, viscosity: 0.3, turbulence: 0.2, diffusion: 1 };
+const SHORT_TAIL: SynthState = { pressure: 0.5, resonance: 0.6, viscosity: 0.3, turbulence: 0.2, diffusion: 0.4 };
+
+function buildScene(): SceneScore {
+    return {
+        duration: SECONDS,
+        seed: SEED,
+        stems: [
+            { name: 'criosfera', engine: 'criosfera' },
+            { name: 'breitema', engine: 'breitema', start: (engine) => (engine as BreitemaEngine).startSequencer() }
+        ],
+        events: [
+            { time: 0, type: 'state' as const, state: LONG_TAIL, stem: 'criosfera' },
+            { time: 0, type: 'state' as const, state: SHORT_TAIL, stem: 'breitema' },
+            { time: 0, type: 'noteOn' as const, note: 0, frequency: 65.41, velocity: 0.6, stem: 'criosfera' },
+            { time: 0, type: 'noteOn' as const, note: 1, frequency: 98.0, velocity: 0.6, stem: 'criosfera' },
+            { time: SECONDS - 10, type: 'noteOff' as const, note: 0, stem: 'criosfera' },
+            { time: SECONDS - 10, type: 'noteOff' as const, note: 1, stem: 'criosfera' }
+        ]
+    };
+}
+
+/** Planar channels of a 16-bit PCM WAV as written by WavWriter */
+async function readWav(file: File): Promise<Float32Array[]> {
+    const bytes = await file.arrayBuffer();
+    const view = new DataView(bytes);
+    const channels = view.getUint16(22, true);
+    const frames = view.getUint32(40, true) / (2 * channels);
+    const out = Array.from({ length: channels }, () => new Float32Array(frames));
+    for (let i = 0; i < frames; i++) {
+        for (let ch = 0; ch < channels; ch++) {
+            out[ch][i] = view.getInt16(44 + (i * channels + ch) * 2, true) / 32768;
+        }
+    }
+    return out;
+}
+
+function rms(data: Float32Array, from: number, to: number): number {
+    let sum = 0;
+    for (let i = from; i < to; i++) sum += data[i] * data[i];
+    return Math.sqrt(sum / Math.max(1, to - from));
+}
+
+async function run(): Promise<CheckResult[]> {
+    const scene = buildScene();
+    const results: CheckResult[] = [];
+
+    const pieces: RenderPiece[] = scene.stems.map(stem => ({
+        engine: stem.engine,
+        duration: scene.duration,
+        seed: scene.seed,
+        events: scene.events.filter(event => event.stem === stem.name)
+    }));
+    const tails = pieces.map(preRollSeconds);
+    results.push({
+        name: 'pre-rolls differ',
+        ok: tails[0] !== tails[1],
+        detail: scene.stems.map((stem, i) => `${stem.name} ${tails[i]} s`).join(', ')
+    });
+
+    const files = await renderStems(scene, 'check', RENDER_SAMPLE_RATE, (fraction) => {
+        statusEl.textContent = `Renderizando… ${Math.round(fraction * 100)}%`;
+    });
+    const stems = await Promise.all(files.stems.map(readWav));
+    const mix = await readWav(files.mix);
+    const expected = Math.round(SECONDS * RENDER_SAMPLE_RATE);
+
+    [...scene.stems.map(stem => stem.name), MIX_NAME].forEach((name, i) => {
+        const frames = (i < stems.length ? stems[i] : mix)[0].length;
+        results.push({ name: `${name}: full length`, ok: frames === expected, detail: `${frames} / ${expected} frames` });
+    });
+
+    // Past the first chunk (at least 20 s) every stem must still sound
+    const from = Math.round(25 * RENDER_SAMPLE_RATE);
+    scene.stems.forEach((stem, i) => {
+        const level = stems[i][0].length > from ? rms(stems[i][0], from, stems[i][0].length) : 0;
+        results.push({ name: `${stem.name}: sounds after the first chunk`, ok: level > 1e-4, detail: `rms ${level.toExponential(2)}` });
+    });
+
+    const gain = 1 / Math.sqrt(stems.length);
+    let worst = 0;
+    let worstFrame = -1;
+    const length = Math.min(mix[0].length, ...stems.map(stem => stem[0].length));
+    for (let ch = 0; ch < 2; ch++) {
+        for (let i = 0; i < length; i++) {
+            let sum = 0;
+            for (const stem of stems) sum += stem[ch][i];
+            const error = Math.abs(Math.max(-1, Math.min(1, sum * gain)) - mix[ch][i]);
+            if (!(error <= worst)) {
+                worst = error;
+                worstFrame = i;
+            }
+        }
+    }
+    results.push({
+        name: 'mix is the sum of the stems',
+        ok: worst <= TOLERANCE,
+        detail: `max error ${worst.toExponential(2)} at frame ${worstFrame}`
+    });
+    return results;
+}
+
+const statusEl = document.getElementById('status')!;
+const resultsEl = document.getElementById('results')!;
+
+run().then((results) => {
+    const failed = results.filter(result => !result.ok).length;
+    statusEl.textContent = failed === 0 ? `Correcto: ${results.length} comprobacións.` : `Fallou: ${failed} de ${results.length}.`;
+    resultsEl.textContent = JSON.stringify(results, null, 2);
+    console.table(results);
+    (window as unknown as { __renderCheck?: CheckResult[] }).__renderCheck = results;
+}).catch((err) => {
+    console.error('[stemRenderCheck]', err);
+    statusEl.textContent = `Erro: ${err instanceof Error ? err.message : String(err)}`;
+});
@@ -52,6 +52,7 @@ const BreitemaUI: React.FC<BreitemaUIProps> = ({ isActive, theme }) => {
             setCurrentStep(state.currentStep);
             setProbabilities(state.probabilities);
             setIsPlaying(engine.isSequencerPlaying());
+            setRhythmMode(engine.getRhythmMode() as 'libre' | 'muineira' | 'ribeirada');
             setFogDensity(state.fogDensity);
             setFogMovement(state.fogMovement);
             setFmDepth(state.fmDepth);
@@ -10,7 +10,7 @@ interface Theme {
 }
 
 interface ControlsPanelProps {
-  currentEngine: 'criosfera' | 'gearheart' | 'echo-vessel' | 'vocoder' | 'breitema';
+  currentEngine: 'criosfera' | 'gearheart' | 'echo-vessel' | 'vocoder' | 'breitema' | 'grans' | 'sampler';
   theme: Theme;
   state: SynthState;
   isActive: boolean;
@@ -20,9 +20,16 @@ interface ControlsPanelProps {
   setAiPrompt: (val: string) => void;
   apiKey: string;
   generateAIPatch: () => void;
+  generateAIScene: () => void;
   isAiLoading: boolean;
   titanReport: string;
   setIsSettingsOpen: (isOpen: boolean) => void;
+  variationCount: number;
+  variationIndex: number;
+  variationMorph: number;
+  prevVariation: () => void;
+  nextVariation: () => void;
+  morphVariation: (t: number) => void;
 }
 
 const ControlsPanel = ({
@@ -36,21 +43,30 @@ const ControlsPanel = ({
   setAiPrompt,
   apiKey,
   generateAIPatch,
+  generateAIScene,
   isAiLoading,
   titanReport,
-  setIsSettingsOpen
+  setIsSettingsOpen,
+  variationCount,
+  variationIndex,
+  variationMorph,
+  prevVariation,
+  nextVariation,
+  morphVariation
 }: ControlsPanelProps) => (
   <div className="flex flex-col h-full pt-4 md:pt-8">
     <header className="mb-8 md:mb-12 flex justify-between items-start">
       <div>
         <h1 className={`text-2xl md:text-3xl font-bold tracking-tighter ${theme.accent} mb-1 uppercase`}>
-          {{ 'criosfera': 'Criosfera', 'gearheart': 'Gearheart', 'echo-vessel': 'Echo Vessel', 'vocoder': 'Vocoder', 'breitema': 'Brétema' }[currentEngine] || currentEngine}
+          {{ 'criosfera': 'Criosfera', 'gearheart': 'Gearheart', 'echo-vessel': 'Echo Vessel', 'vocoder': 'Vocoder', 'breitema': 'Brétema', 'grans': 'Nube de Grans', 'sampler': 'Arquivo Sonoro' }[currentEngine] || currentEngine}
         </h1>
         <h2 className="text-[9px] md:text-[10px] uppercase tracking-[0.3em] opacity-50">
           {currentEngine === 'criosfera' ? 'Modulador Atmosférico' :
             currentEngine === 'gearheart' ? 'Matriz de Ritmo' :
               currentEngine === 'echo-vessel' ? 'Transmutador Vocal' :
-                currentEngine === 'breitema' ? 'Reixa Generativa' : 'Sintese Espectral'}
+                currentEngine === 'breitema' ? 'Reixa Generativa' :
+                  currentEngine === 'grans' ? 'Nube Granular' :
+                    currentEngine === 'sampler' ? 'Mostras en Fluxo' : 'Sintese Espectral'}
         </h2>
       </div>
       <button onClick={() => setIsSettingsOpen(true)} className="hidden md:block p-2 opacity-50 hover:opacity-100">
@@ -71,26 +87,52 @@ const ControlsPanel = ({
         {currentEngine === 'criosfera' ? 'Xerador de atmósferas' :
           currentEngine === 'gearheart' ? 'Xerador de Maquinaria' :
             currentEngine === 'echo-vessel' ? 'Xerador de Profecías' :
-              currentEngine === 'breitema' ? 'Xerador de Patróns' : 'Xerador de Covas'}
+              currentEngine === 'breitema' ? 'Xerador de Patróns' :
+                currentEngine === 'grans' ? 'Xerador de Po' :
+                  currentEngine === 'sampler' ? 'Xerador de Arquivos' : 'Xerador de Covas'}
       </div>
       <div className="relative">
         <input
           type="text"
-          placeholder={apiKey ? "Descrición..." : "Configura a API Key"}
+          placeholder={apiKey ? "Descrición..." : "Descrición (oráculo local)..."}
           value={aiPrompt}
           onChange={(e) => setAiPrompt(e.target.value)}
-          disabled={!apiKey}
           className={`w-full bg-black/40 border ${theme.border} p-3 text-sm focus:outline-none transition-colors disabled:opacity-50 ${theme.text}`}
           onKeyDown={(e) => e.key === 'Enter' && generateAIPatch()}
         />
         <button
           onClick={generateAIPatch}
-          disabled={isAiLoading || !isActive || !apiKey}
+          disabled={isAiLoading || !isActive}
           className={`absolute right-2 top-1.5 p-2 ${theme.accent} disabled:opacity-30`}
         >
           {isAiLoading ? '...' : '→'}
         </button>
       </div>
+      <button
+        onClick={generateAIScene}
+        disabled={isAiLoading || !isActive || !apiKey || !aiPrompt}
+        className={`mt-3 w-full py-1.5 border ${theme.border} text-[10px] uppercase tracking-widest ${theme.accent} opacity-70 hover:opacity-100 disabled:opacity-30`}
+        title="Configura todos os instrumentos cunha soa consulta"
+      >
+        ✦ Escena completa
+      </button>
+      {variationCount > 1 && (
+        <div className={`mt-3 flex items-center gap-2 ${!isActive ? 'opacity-40 pointer-events-none' : ''}`}>
+          <button onClick={prevVariation} className={`px-2 py-1 ${theme.accent} opacity-70 hover:opacity-100`} title="Variación anterior">◀</button>
+          <span className="text-[10px] font-mono opacity-60 w-8 text-center">{variationIndex + 1}/{variationCount}</span>
+          <button onClick={nextVariation} className={`px-2 py-1 ${theme.accent} opacity-70 hover:opacity-100`} title="Seguinte variación">▶</button>
+          <input
+            type="range"
+            min={0}
+            max={1}
+            step={0.01}
+            value={variationMorph}
+            onChange={(e) => morphVariation(parseFloat(e.target.value))}
+            className="flex-1 accent-current"
+            title="Transición cara á seguinte variación"
+          />
+        </div>
+      )}
       <p className="mt-4 text-[11px] leading-relaxed italic opacity-60 min-h-[4em] max-h-[8em] overflow-y-auto font-mono">
         {titanReport}
       </p>
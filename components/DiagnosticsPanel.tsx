@@ -0,0 +1,225 @@
+import React, { useEffect, useState } from 'react';
+import { synthManager } from '../services/SynthManager';
+import { timingTelemetry, TimingSnapshot, TimingMetric, HistogramSnapshot } from '../services/TimingTelemetry';
+import { watchdog, StallRecord, QualityTier } from '../services/Watchdog';
+
+interface DiagnosticsPanelProps {
+    isOpen: boolean;
+    onClose: () => void;
+}
+
+const SOURCE_LABELS: Record<string, string> = {
+    'master': 'Mestre',
+    'criosfera': 'Criosfera',
+    'gearheart': 'Gearheart',
+    'echo-vessel': 'Echo Vessel',
+    'vocoder': 'Vocoder',
+    'breitema': 'Brétema',
+    'grans': 'Grans',
+    'sampler': 'Arquivo'
+};
+
+const METRICS: { id: TimingMetric; label: string; hint: string }[] = [
+    { id: 'error', label: 'Atraso do disparo', hint: 'Programado − previsto' },
+    { id: 'slack', label: 'Marxe de anticipación', hint: 'Programado − tempo actual' },
+    { id: 'onset', label: 'Atraso na saída', hint: 'Detectado − programado (sonda)' }
+];
+
+const CULPRIT_LABELS: Record<StallRecord['culprit'], string> = {
+    'render': 'Render de React',
+    'canvas': 'Debuxo do canvas',
+    'ir': 'Xeración de IR',
+    'oracle': 'Análise do Oráculo',
+    'unknown': 'Descoñecido'
+};
+
+const TIER_LABELS: Record<QualityTier, string> = {
+    'high': 'Alta',
+    'medium': 'Media',
+    'low': 'Baixa'
+};
+
+const REFRESH_MS = 250;
+
+const Histogram = ({ data }: { data: HistogramSnapshot }) => {
+    const peak = Math.max(1, ...data.bins);
+    return (
+        <div>
+            <div className="flex items-end gap-px h-12 bg-black/40 border border-stone-800 px-px">
+                {data.bins.map((count, i) => (
+                    <div
+                        key={i}
+                        className="flex-1 bg-orange-500/80"
+                        style={{ height: `${(count / peak) * 100}%` }}
+                        title={`${data.min + i * data.binWidth}…${data.min + (i + 1) * data.binWidth} ms: ${count}`}
+                    />
+                ))}
+            </div>
+            <div className="flex justify-between text-[9px] text-stone-500 mt-0.5">
+                <span>{data.min} ms</span>
+                <span>{data.min + data.bins.length * data.binWidth} ms</span>
+            </div>
+            <div className="text-[10px] text-stone-400 font-mono">
+                n={data.count} · media {data.mean.toFixed(1)} · p50 {data.p50} · p95 {data.p95} · máx {data.max.toFixed(1)}
+            </div>
+        </div>
+    );
+};
+
+const DiagnosticsPanel = ({ isOpen, onClose }: DiagnosticsPanelProps) => {
+    const [snapshot, setSnapshot] = useState<TimingSnapshot>({});
+    const [probeEnabled, setProbeEnabled] = useState(synthManager.isOnsetProbeEnabled());
+    const [stalls, setStalls] = useState<StallRecord[]>([]);
+    const [tier, setTier] = useState<QualityTier>(watchdog.getQualityTier());
+    const [autoTier, setAutoTier] = useState(watchdog.isAutoDowngradeEnabled());
+    const [loudness, setLoudness] = useState(synthManager.getLoudnessReadings());
+    const [autoGain, setAutoGain] = useState(synthManager.isAutoGainEnabled());
+
+    useEffect(() => {
+        if (!isOpen) return;
+        const refresh = () => {
+            setSnapshot(timingTelemetry.getSnapshot());
+            setStalls(watchdog.getStalls());
+            setTier(watchdog.getQualityTier());
+            setLoudness(synthManager.getLoudnessReadings());
+        };
+        refresh();
+        const timer = window.setInterval(refresh, REFRESH_MS);
+        return () => window.clearInterval(timer);
+    }, [isOpen]);
+
+    if (!isOpen) return null;
+
+    const toggleProbe = () => {
+        synthManager.setOnsetProbeEnabled(!probeEnabled);
+        setProbeEnabled(!probeEnabled);
+    };
+
+    const toggleAutoTier = () => {
+        watchdog.setAutoDowngrade(!autoTier);
+        setAutoTier(!autoTier);
+    };
+
+    const toggleAutoGain = () => {
+        synthManager.setAutoGainEnabled(!autoGain);
+        setAutoGain(!autoGain);
+    };
+
+    const sources = Object.keys(snapshot);
+    const now = performance.now();
+
+    return (
+        <div className="fixed inset-0 z-[210] bg-black/80 backdrop-blur-sm flex items-center justify-center p-6 text-stone-100">
+            <div className="bg-stone-900 border border-stone-700 p-6 w-full max-w-lg max-h-full overflow-y-auto rounded-lg shadow-2xl">
+                <h3 className="text-lg font-bold text-orange-500 mb-1">Diagnóstico</h3>
+                <p className="text-xs text-stone-400 mb-4">Precisión dos disparos dos secuenciadores, en milisegundos.</p>
+
+                <label className="flex items-center gap-2 text-xs text-stone-300 mb-4">
+                    <input type="checkbox" checked={probeEnabled} onChange={toggleProbe} />
+                    Sonda de ataques na saída
+                </label>
+
+                {sources.length === 0 && (
+                    <p className="text-xs text-stone-500 mb-4">Aínda non hai disparos. Activa Brétema ou Gearheart.</p>
+                )}
+
+                {sources.map(source => (
+                    <div key={source} className="mb-5">
+                        <h4 className="text-xs uppercase tracking-widest text-stone-300 mb-2">{SOURCE_LABELS[source] || source}</h4>
+                        {METRICS.filter(metric => snapshot[source][metric.id].count > 0).map(metric => (
+                            <div key={metric.id} className="mb-3">
+                                <div className="flex justify-between text-[10px] text-stone-400 mb-1">
+                                    <span>{metric.label}</span>
+                                    <span className="text-stone-600">{metric.hint}</span>
+                                </div>
+                                <Histogram data={snapshot[source][metric.id]} />
+                            </div>
+                        ))}
+                    </div>
+                ))}
+
+                <h4 className="text-xs uppercase tracking-widest text-stone-300 mb-2">Sonoridade (LUFS)</h4>
+                <label className="flex items-center gap-2 text-xs text-stone-300 mb-2">
+                    <input type="checkbox" checked={autoGain} onChange={toggleAutoGain} />
+                    Igualar a sonoridade dos motores
+                </label>
+                <table className="w-full text-[10px] font-mono text-stone-400 mb-4">
+                    <thead>
+                        <tr className="text-stone-500 text-left">
+                            <th className="font-normal">motor</th>
+                            <th className="font-normal" title="Xanela de 400 ms">M</th>
+                            <th className="font-normal" title="Xanela de 3 s">S</th>
+                            <th className="font-normal">axuste</th>
+                        </tr>
+                    </thead>
+                    <tbody>
+                        {loudness.map(row => (
+                            <tr key={row.name}>
+                                <td>{SOURCE_LABELS[row.name] || row.name}</td>
+                                <td>{row.momentary <= -100 ? '—' : row.momentary.toFixed(1)}</td>
+                                <td>{row.shortTerm <= -100 ? '—' : row.shortTerm.toFixed(1)}</td>
+                                <td>{row.name === 'master' ? '' : `${row.trimDb >= 0 ? '+' : ''}${row.trimDb.toFixed(1)} dB`}</td>
+                            </tr>
+                        ))}
+                    </tbody>
+                </table>
+
+                <h4 className="text-xs uppercase tracking-widest text-stone-300 mb-2">Bloqueos do fío principal</h4>
+                <div className="flex items-center gap-3 text-xs text-stone-300 mb-2">
+                    <span>Calidade</span>
+                    <select
+                        value={tier}
+                        onChange={(e) => { watchdog.setQualityTier(e.target.value as QualityTier); setTier(e.target.value as QualityTier); }}
+                        className="bg-black/50 border border-stone-600 px-2 py-1 text-xs"
+                    >
+                        {(Object.keys(TIER_LABELS) as QualityTier[]).map(id => (
+                            <option key={id} value={id}>{TIER_LABELS[id]}</option>
+                        ))}
+                    </select>
+                    <label className="flex items-center gap-2">
+                        <input type="checkbox" checked={autoTier} onChange={toggleAutoTier} />
+                        Baixar automaticamente
+                    </label>
+                </div>
+                {stalls.length === 0 ? (
+                    <p className="text-xs text-stone-500 mb-4">Sen bloqueos rexistrados.</p>
+                ) : (
+                    <table className="w-full text-[10px] font-mono text-stone-400 mb-4">
+                        <thead>
+                            <tr className="text-stone-500 text-left">
+                                <th className="font-normal">hai</th>
+                                <th className="font-normal">dur.</th>
+                                <th className="font-normal">causa</th>
+                                <th className="font-normal" title="Pasos programados tarde">fallos</th>
+                                <th className="font-normal" title="Ocos no fío de audio">ocos</th>
+                            </tr>
+                        </thead>
+                        <tbody>
+                            {stalls.map(stall => (
+                                <tr key={stall.start} className={stall.schedulerMisses + stall.underruns > 0 ? 'text-orange-400' : ''}>
+                                    <td>{((now - stall.start) / 1000).toFixed(1)} s</td>
+                                    <td>{Math.round(stall.duration)} ms</td>
+                                    <td>{CULPRIT_LABELS[stall.culprit]}</td>
+                                    <td>{stall.schedulerMisses}</td>
+                                    <td>{stall.underruns}</td>
+                                </tr>
+                            ))}
+                        </tbody>
+                    </table>
+                )}
+
+                <div className="flex justify-end gap-2">
+                    <button
+                        onClick={() => { timingTelemetry.reset(); watchdog.clear(); setSnapshot(timingTelemetry.getSnapshot()); setStalls([]); }}
+                        className="mr-auto px-2 py-2 text-[10px] uppercase tracking-widest text-stone-500 hover:text-stone-300"
+                    >
+                        Borrar
+                    </button>
+                    <button onClick={onClose} className="px-4 py-2 bg-orange-600 rounded">Pechar</button>
+                </div>
+            </div>
+        </div>
+    );
+};
+
+export default DiagnosticsPanel;
@@ -2,6 +2,10 @@ import React, { useEffect, useRef, useState } from 'react';
 import { synthManager } from '../services/SynthManager';
 import { EchoVesselEngine } from '../services/engines/EchoVesselEngine';
 import { useCanvasDimensions } from '../hooks/useCanvasDimensions';
+import { drawVesselFrame, Vial } from './draw/vesselScene';
+import { watchdog } from '../services/Watchdog';
+import { NotchInfo } from '../services/FeedbackSuppressor';
+import LoopControls from './LoopControls';
 
 interface EchoVesselUIProps {
     isActive: boolean;
@@ -11,13 +15,15 @@ interface EchoVesselUIProps {
     hasApiKey: boolean;
     report: string;
     isAiLoading: boolean;
-    onVialChange?: (vial: 'neutral' | 'mercury' | 'amber') => void;
+    onVialChange?: (vial: Vial) => void;
 }
 
 const EchoVesselUI: React.FC<EchoVesselUIProps> = ({ isActive, engine, aiPrompt, onGenerate, hasApiKey, report, isAiLoading, onVialChange }) => {
     const canvasRef = useRef<HTMLCanvasElement>(null);
     const [status, setStatus] = useState<'idle' | 'recording' | 'playing'>('idle');
-    const [selectedVial, setSelectedVial] = useState<'neutral' | 'mercury' | 'amber'>('neutral');
+    const [selectedVial, setSelectedVial] = useState<Vial>('neutral');
+    const [openMic, setOpenMic] = useState(false);
+    const [notches, setNotches] = useState<NotchInfo[]>([]);
 
     // Canvas dimensions with resize handling (using shared hook)
     const dimensions = useCanvasDimensions(0.6);
@@ -49,8 +55,25 @@ const EchoVesselUI: React.FC<EchoVesselUIProps> = ({ isActive, engine, aiPrompt,
         }
     };
 
+    // Howl suppressor readout
+    useEffect(() => {
+        const suppressor = engine?.getFeedbackSuppressor();
+        if (!suppressor || !isActive) return;
+        setOpenMic(engine!.getIsOpenMic());
+        setNotches(suppressor.getNotches());
+        suppressor.setListener(setNotches);
+        return () => suppressor.setListener(null);
+    }, [engine, isActive]);
+
+    const toggleOpenMic = async () => {
+        if (!engine || !isActive) return;
+        await synthManager.resume();
+        await engine.setOpenMic(!openMic);
+        setOpenMic(engine.getIsOpenMic());
+    };
+
     // Handle Vial Change
-    const selectVial = (vial: 'neutral' | 'mercury' | 'amber') => {
+    const selectVial = (vial: Vial) => {
         if (!engine || !isActive) return;
 
         engine.setVial(vial);
@@ -87,9 +110,13 @@ const EchoVesselUI: React.FC<EchoVesselUIProps> = ({ isActive, engine, aiPrompt,
         let analyser = engine ? engine.getAnalyser() : null;
         let dataArray = new Uint8Array(analyser ? analyser.frequencyBinCount : 128);
         let animationId: number;
+        let frame = 0;
 
         const render = () => {
             animationId = requestAnimationFrame(render);
+            // Lower quality tiers draw every 2nd/3rd frame (see Watchdog)
+            if (frame++ % watchdog.getFrameStride() !== 0) return;
+            const drawStart = performance.now();
 
             // Try to get analyser again if we didn't have it
             if (!analyser && engine) {
@@ -109,55 +136,8 @@ const EchoVesselUI: React.FC<EchoVesselUIProps> = ({ isActive, engine, aiPrompt,
             const ctx = canvas.getContext('2d');
             if (!ctx) return;
 
-            const w = canvas.width;
-            const h = canvas.height;
-            const cx = w / 2;
-            const cy = h / 2;
-            const radius = Math.min(w, h) * 0.4;
-
-            // Clear with trail
-            ctx.fillStyle = 'rgba(10, 15, 20, 0.2)';
-            ctx.fillRect(0, 0, w, h);
-
-            // Draw Container Ring
-            ctx.beginPath();
-            ctx.arc(cx, cy, radius, 0, 2 * Math.PI);
-            ctx.strokeStyle = '#334455';
-            ctx.lineWidth = 2;
-            ctx.stroke();
-
-            // Draw Plasma Wave
-            ctx.beginPath();
-            ctx.lineWidth = 4;
-
-            let rBase = radius * 0.9;
-            if (selectedVial === 'mercury') {
-                ctx.strokeStyle = '#00ffff'; // Cyan
-                ctx.shadowColor = '#00ffff';
-            } else if (selectedVial === 'amber') {
-                ctx.strokeStyle = '#ffaa00'; // Amber
-                ctx.shadowColor = '#ffaa00';
-            } else {
-                ctx.strokeStyle = '#ffffff';
-                ctx.shadowColor = '#ffffff';
-            }
-            ctx.shadowBlur = 15;
-
-            for (let i = 0; i < dataArray.length; i++) {
-                const v = dataArray[i] / 128.0; // 0..2 (1 is silence)
-                const angle = (i / dataArray.length) * 2 * Math.PI;
-
-                // Polar conversion with modulation
-                const r = rBase + (v - 1) * 100; // Amplitude affects radius
-                const x = cx + r * Math.cos(angle);
-                const y = cy + r * Math.sin(angle);
-
-                if (i === 0) ctx.moveTo(x, y);
-                else ctx.lineTo(x, y);
-            }
-            ctx.closePath();
-            ctx.stroke();
-            ctx.shadowBlur = 0;
+            drawVesselFrame(ctx, canvas.width, canvas.height, dataArray, selectedVial);
+            watchdog.span('canvas', drawStart);
         };
         render();
 
@@ -264,6 +244,32 @@ const EchoVesselUI: React.FC<EchoVesselUIProps> = ({ isActive, engine, aiPrompt,
                     </button>
                 </div>
 
+                {/* Loop tempo and pitch */}
+                {status === 'playing' && <LoopControls engine={engine} accent="cyan" />}
+
+                {/* Open mic and its feedback suppressor */}
+                <div className="flex items-center gap-3 text-[10px] font-mono uppercase tracking-widest">
+                    <button
+                        onClick={toggleOpenMic}
+                        className={`px-3 py-1 rounded-full border transition-all ${openMic
+                            ? 'border-cyan-500 bg-cyan-900/30 text-cyan-400'
+                            : 'border-slate-700 text-slate-600 bg-black/40'
+                            }`}
+                    >
+                        Micro aberto
+                    </button>
+                    {openMic && (
+                        <>
+                            <span className="text-slate-500 truncate">
+                                Antiacople: {notches.length === 0 ? 'limpo' : notches.map(n => `${(n.frequency / 1000).toFixed(2)}k`).join(' ')}
+                            </span>
+                            {notches.length > 0 && (
+                                <button onClick={() => engine?.getFeedbackSuppressor()?.reset()} className="text-slate-500 hover:text-slate-300">↺</button>
+                            )}
+                        </>
+                    )}
+                </div>
+
                 {/* Vial Selectors (unchanged logic, just layout context) */}
                 <div className="flex justify-between items-center bg-black/40 p-2 rounded-full border border-slate-800 backdrop-blur-sm">
                     <button
@@ -2,7 +2,7 @@ import React from 'react';
 
 interface EngineSelectorProps {
     currentEngine: string;
-    onEngineChange: (engine: 'criosfera' | 'gearheart' | 'echo-vessel' | 'vocoder' | 'breitema') => void;
+    onEngineChange: (engine: 'criosfera' | 'gearheart' | 'echo-vessel' | 'vocoder' | 'breitema' | 'grans' | 'sampler') => void;
 }
 
 const ENGINES = [
@@ -11,6 +11,8 @@ const ENGINES = [
     { id: 'echo-vessel', label: 'Echo Vessel', activeClass: 'bg-cyan-900 text-cyan-400' },
     { id: 'vocoder', label: 'Vocoder', activeClass: 'bg-emerald-900 text-emerald-400' },
     { id: 'breitema', label: 'Brétema', activeClass: 'bg-[#1e2430] text-[#8be9fd]' },
+    { id: 'grans', label: 'Grans', activeClass: 'bg-[#2a2114] text-amber-300' },
+    { id: 'sampler', label: 'Arquivo', activeClass: 'bg-[#221a30] text-violet-300' },
 ] as const;
 
 const EngineSelector = ({ currentEngine, onEngineChange }: EngineSelectorProps) => {
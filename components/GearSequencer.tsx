@@ -1,19 +1,8 @@
 import React, { useRef, useEffect, useState } from 'react';
 import { synthManager } from '../services/SynthManager';
-import { Gear } from '../services/engines/GearheartEngine';
 import { useCanvasDimensions } from '../hooks/useCanvasDimensions';
-
-interface Particle {
-    x: number;
-    y: number;
-    vx: number;
-    vy: number;
-    life: number;
-    maxLife: number;
-    size: number;
-    type: 'smoke' | 'oil' | 'spark';
-    color: string;
-}
+import { drawGearBackground, drawGearFrame, GearParticle } from './draw/gearScene';
+import { watchdog } from '../services/Watchdog';
 
 interface GearSequencerProps {
     diffusion?: number;
@@ -24,8 +13,9 @@ interface GearSequencerProps {
 
 const GearSequencer = ({ gearConfig, diffusion = 0.5, onConfigApplied, isActive = true }: GearSequencerProps) => {
     const canvasRef = useRef<HTMLCanvasElement>(null);
-    const particlesRef = useRef<Particle[]>([]);
+    const particlesRef = useRef<GearParticle[]>([]);
     const requestRef = useRef<number>(0);
+    const frameRef = useRef(0);
     const dragInfo = useRef<{ id: number, offsetX: number, offsetY: number } | null>(null);
     const hasStartedAudio = useRef(false);
 
@@ -42,56 +32,6 @@ const GearSequencer = ({ gearConfig, diffusion = 0.5, onConfigApplied, isActive
         }
     }, [gearConfig, onConfigApplied]);
 
-    const spawnSmoke = (x: number, y: number, amount: number) => {
-        for (let i = 0; i < amount; i++) {
-            const angle = (Math.random() - 0.5) * 0.5; // Narrower cone
-            const speed = Math.random() * 0.5 + 0.2;
-            particlesRef.current.push({
-                x: x,
-                y: y,
-                vx: angle,
-                vy: -Math.random() * 1.5 - 0.5,
-                life: 1.0,
-                maxLife: 1.0 + Math.random() * 0.5,
-                size: Math.random() * 8 + 4,
-                type: 'smoke',
-                color: '200, 200, 200' // Store base color components
-            });
-        }
-    };
-
-    const spawnOil = (x: number, y: number) => {
-        particlesRef.current.push({
-            x: x,
-            y: y,
-            vx: (Math.random() - 0.5) * 0.5,
-            vy: Math.random() * 1 + 0.5,
-            life: 1.0,
-            maxLife: 2.0,
-            size: Math.random() * 2 + 1,
-            type: 'oil',
-            color: '40, 30, 20' // Dark oil color
-        });
-    };
-
-    const getGradientColors = (material: string): [string, string, string] => {
-        switch (material) {
-            case 'bronze': return ['#cd7f32', '#8b4513', '#5a2e0c'];
-            case 'copper': return ['#b87333', '#8b4513', '#4a2505'];
-            case 'gold': return ['#ffd700', '#daa520', '#8b6914'];
-            case 'platinum': return ['#e5e4e2', '#a9a9a9', '#696969'];
-            case 'iron': return ['#71797E', '#4A4A4A', '#2F2F2F'];
-            default: return ['#888', '#555', '#222'];
-        }
-    };
-
-    const getRGB = (hex: string): string => {
-        const r = parseInt(hex.slice(1, 3), 16);
-        const g = parseInt(hex.slice(3, 5), 16);
-        const b = parseInt(hex.slice(5, 7), 16);
-        return `${r}, ${g}, ${b}`;
-    };
-
     const update = () => {
         const canvas = canvasRef.current;
         if (!canvas) {
@@ -104,17 +44,14 @@ const GearSequencer = ({ gearConfig, diffusion = 0.5, onConfigApplied, isActive
             return;
         }
 
-        // Background - Rusty Iron (always draw background)
-        const bgGradient = ctx.createRadialGradient(
-            canvas.width / 2, canvas.height / 2, 0,
-            canvas.width / 2, canvas.height / 2, canvas.width
-        );
-        bgGradient.addColorStop(0, '#2b1d14'); // Dark rusty brown
-        bgGradient.addColorStop(0.6, '#1a120b');
-        bgGradient.addColorStop(1, '#0f0a06');
+        // Lower quality tiers draw every 2nd/3rd frame (see Watchdog)
+        if (frameRef.current++ % watchdog.getFrameStride() !== 0) {
+            requestRef.current = requestAnimationFrame(update);
+            return;
+        }
+        const drawStart = performance.now();
 
-        ctx.fillStyle = bgGradient;
-        ctx.fillRect(0, 0, canvas.width, canvas.height);
+        drawGearBackground(ctx, canvas.width, canvas.height);
 
         const engine = synthManager.getGearheartEngine();
         if (!engine || !engine.isReady()) {
@@ -123,250 +60,13 @@ const GearSequencer = ({ gearConfig, diffusion = 0.5, onConfigApplied, isActive
             return;
         }
 
-        // Vibration/Shake from Engine - Enhanced for impact
-        const vibration = engine.vibration;
-        if (vibration > 0.1) {
-            const shakeX = (Math.random() - 0.5) * vibration * 2;
-            const shakeY = (Math.random() - 0.5) * vibration * 2;
-            ctx.save();
-            ctx.translate(shakeX, shakeY);
-        } else {
-            ctx.save();
-        }
-
-        const gears = engine.getGears();
-
-        // Draw Gears
-        gears.forEach(g => {
-            // Mechanical Link Visualization
-            if (g.isConnected) {
-                gears.forEach(other => {
-                    if (g.id !== other.id && other.isConnected && !g.isDragging && !other.isDragging) {
-                        const dx = g.x - other.x;
-                        const dy = g.y - other.y;
-                        const dist = Math.sqrt(dx * dx + dy * dy);
-                        if (dist < g.radius + other.radius + 18) {
-                            ctx.beginPath();
-                            ctx.moveTo(g.x, g.y);
-                            ctx.lineTo(other.x, other.y);
-                            ctx.strokeStyle = "rgba(100, 80, 50, 0.4)";
-                            ctx.lineWidth = 10;
-                            ctx.stroke();
-                            ctx.strokeStyle = "rgba(180, 140, 90, 0.2)";
-                            ctx.lineWidth = 4;
-                            ctx.stroke();
-                        }
-                    }
-                });
-            }
-
-            if (g.isConnected && Math.abs(g.speed) > 0.01) {
-                // Smoke from connection points or top
-                if (Math.random() < 0.01 * (diffusion || 0.5)) {
-                    spawnSmoke(g.x, g.y - g.radius, 1);
-                }
-                // Oil leaks from moving gears - increased frequency
-                if (Math.random() < 0.02) {
-                    spawnOil(g.x + (Math.random() - 0.5) * g.radius, g.y + g.radius * 0.5);
-                }
-            }
-
-            ctx.save();
-            ctx.translate(g.x, g.y);
-
-            // --- Visual Coordinate Axes (Trembling) ---
-            const [axisLight, axisMid, axisDark] = getGradientColors(g.material);
-            ctx.save();
-
-            // Independent Jitter for Holographic Effect
-            if (engine.vibration > 0) {
-                const axisJitterX = (Math.random() - 0.5) * engine.vibration * 0.5;
-                const axisJitterY = (Math.random() - 0.5) * engine.vibration * 0.5;
-                ctx.translate(axisJitterX, axisJitterY);
-            }
-
-            // Infinite length (enough to cover mostly any mobile screen from center)
-            const axisLen = Math.max(canvas.width, canvas.height);
-
-            ctx.lineWidth = 1;
-            ctx.globalAlpha = 0.5;
-
-            // X Axis Gradient (Fade out ends)
-            const xGrad = ctx.createLinearGradient(-axisLen, 0, axisLen, 0);
-            xGrad.addColorStop(0, "transparent");
-            xGrad.addColorStop(0.2, "transparent");
-            xGrad.addColorStop(0.4, `rgba(${getRGB(axisLight)}, 0.1)`);
-            xGrad.addColorStop(0.5, axisLight);
-            xGrad.addColorStop(0.6, `rgba(${getRGB(axisLight)}, 0.1)`);
-            xGrad.addColorStop(0.8, "transparent");
-            xGrad.addColorStop(1, "transparent");
-
-            ctx.strokeStyle = xGrad;
-            ctx.beginPath();
-            ctx.moveTo(-axisLen, 0);
-            ctx.lineTo(axisLen, 0);
-            ctx.stroke();
-
-            // Y Axis Gradient
-            const yGrad = ctx.createLinearGradient(0, -axisLen, 0, axisLen);
-            yGrad.addColorStop(0, "transparent");
-            yGrad.addColorStop(0.2, "transparent");
-            yGrad.addColorStop(0.4, `rgba(${getRGB(axisLight)}, 0.1)`);
-            yGrad.addColorStop(0.5, axisLight);
-            yGrad.addColorStop(0.6, `rgba(${getRGB(axisLight)}, 0.1)`);
-            yGrad.addColorStop(0.8, "transparent");
-            yGrad.addColorStop(1, "transparent");
-
-            ctx.strokeStyle = yGrad;
-            ctx.beginPath();
-            ctx.moveTo(0, -axisLen);
-            ctx.lineTo(0, axisLen);
-            ctx.stroke();
-
-            // Center Crosshair (Solid)
-            ctx.beginPath();
-            ctx.strokeStyle = axisDark;
-            ctx.lineWidth = 1.5;
-            ctx.globalAlpha = 0.9;
-            ctx.moveTo(-5, 0);
-            ctx.lineTo(5, 0);
-            ctx.moveTo(0, -5);
-            ctx.lineTo(0, 5);
-            ctx.stroke();
-
-            ctx.restore();
-            // ------------------------------------------
-
-            ctx.rotate(g.angle);
-
-            // Halo for Motor
-            if (g.id === 0) {
-                if (engine.isMotorActive) {
-                    ctx.shadowColor = "#ff2200";
-                    ctx.shadowBlur = 40 + Math.random() * 10;
-                } else {
-                    ctx.shadowColor = "rgba(100, 200, 255, 0.5)";
-                    ctx.shadowBlur = 15;
-                }
-            } else if (g.isDragging) {
-                ctx.shadowColor = "#ffbf69";
-                ctx.shadowBlur = 20;
-            } else {
-                ctx.shadowBlur = 0;
-            }
-
-            // Material Gradients
-            const [light, mid, dark] = getGradientColors(g.material);
-            const gearGradient = ctx.createRadialGradient(0, 0, g.radius * 0.2, 0, 0, g.radius);
-            gearGradient.addColorStop(0, light);
-            gearGradient.addColorStop(0.5, mid);
-            gearGradient.addColorStop(1, dark);
-
-            ctx.fillStyle = gearGradient;
-
-            // Draw Gear Teeth (3D effect)
-            const outerRadius = g.radius;
-            const innerRadius = g.radius - 8;
-
-            ctx.beginPath();
-            for (let i = 0; i < g.teeth * 2; i++) {
-                const a = (Math.PI * 2 * i) / (g.teeth * 2);
-                const r = (i % 2 === 0) ? outerRadius : innerRadius;
-                ctx.lineTo(Math.cos(a) * r, Math.sin(a) * r);
-            }
-            ctx.closePath();
-            ctx.fill();
-
-            // Inner rim stroke
-            ctx.strokeStyle = dark;
-            ctx.lineWidth = 1;
-            ctx.stroke();
-
-            // Highlight reflection (Fake 3D)
-            ctx.beginPath();
-            ctx.arc(0, 0, innerRadius - 5, 0, Math.PI * 2);
-            ctx.fillStyle = "rgba(255,255,255,0.05)";
-            ctx.fill();
-
-            // Wooden Axle
-            const axleRadius = 15;
-            const woodGradient = ctx.createRadialGradient(0, 0, 2, 0, 0, axleRadius);
-            woodGradient.addColorStop(0, '#8b5a2b'); // Light wood
-            woodGradient.addColorStop(0.8, '#5c3a1e'); // Dark wood
-            woodGradient.addColorStop(1, '#362312'); // Bark/Edge
-
-            ctx.beginPath();
-            ctx.arc(0, 0, axleRadius, 0, Math.PI * 2);
-            ctx.fillStyle = woodGradient;
-            ctx.fill();
-
-            // Wood grain rings
-            ctx.strokeStyle = "rgba(40, 20, 10, 0.3)";
-            ctx.lineWidth = 1;
-            ctx.beginPath();
-            ctx.arc(0, 0, 5, 0, Math.PI * 2);
-            ctx.stroke();
-            ctx.beginPath();
-            ctx.arc(0, 0, 10, 0, Math.PI * 2);
-            ctx.stroke();
-
-            // Center Bolt
-            ctx.beginPath();
-            ctx.arc(0, 0, 4, 0, Math.PI * 2);
-            ctx.fillStyle = '#b87333'; // Copper bolt
-            ctx.fill();
-            ctx.strokeStyle = '#4a2505';
-            ctx.stroke();
-
-            // Trigger Marker (Rivet)
-            if (g.isConnected) {
-                ctx.beginPath();
-                ctx.arc(0, -innerRadius + 8, 4, 0, Math.PI * 2);
-                const rivetGrad = ctx.createRadialGradient(0, -innerRadius + 8, 1, 0, -innerRadius + 8, 4);
-                rivetGrad.addColorStop(0, '#fff');
-                rivetGrad.addColorStop(1, '#555');
-                ctx.fillStyle = rivetGrad;
-                ctx.fill();
-            }
-
-            ctx.restore();
-        });
-
-        // Update and Draw Particles
-        for (let i = particlesRef.current.length - 1; i >= 0; i--) {
-            const p = particlesRef.current[i];
-            p.x += p.vx;
-            p.y += p.vy;
-            p.life -= 0.01;
-
-            if (p.type === 'smoke') {
-                p.size += 0.1;
-                p.vx *= 0.95;
-            } else {
-                p.vy += 0.1;
-            }
-
-            if (p.life <= 0) {
-                particlesRef.current.splice(i, 1);
-                continue;
-            }
-
-            ctx.beginPath();
-            ctx.arc(p.x, p.y, p.size, 0, Math.PI * 2);
-
-            if (p.type === 'smoke') {
-                ctx.fillStyle = `rgba(${p.color}, ${p.life * 0.3})`;
-            } else if (p.type === 'oil') {
-                ctx.fillStyle = `rgba(${p.color}, ${p.life * 0.8})`;
-            } else {
-                ctx.fillStyle = `rgba(0, 0, 0, ${p.life})`;
-            }
-
-            ctx.fill();
-        }
-
-        // Restore from shake transform
-        ctx.restore();
+        drawGearFrame(ctx, canvas.width, canvas.height, {
+            gears: engine.getGears(),
+            vibration: engine.vibration,
+            isMotorActive: engine.isMotorActive,
+            diffusion
+        }, particlesRef.current);
+        watchdog.span('canvas', drawStart);
 
         requestRef.current = requestAnimationFrame(update);
     };
@@ -0,0 +1,207 @@
+import React, { useRef, useEffect, useState } from 'react';
+import { synthManager } from '../services/SynthManager';
+import { GranularEngine, GranularSource } from '../services/engines/GranularEngine';
+import { takeRegistry } from '../services/TakeRegistry';
+import { useCanvasDimensions } from '../hooks/useCanvasDimensions';
+
+interface GranularUIProps {
+    isActive: boolean;
+    engine: GranularEngine | undefined;
+}
+
+const SOURCES: { id: GranularSource; label: string }[] = [
+    { id: 'latest', label: 'Última' },
+    { id: 'echo-vessel', label: 'Echo Vessel' },
+    { id: 'vocoder', label: 'Vocoder' },
+];
+
+const GranularUI: React.FC<GranularUIProps> = ({ isActive, engine }) => {
+    const canvasRef = useRef<HTMLCanvasElement>(null);
+    const [source, setSource] = useState<GranularSource>('latest');
+    const [isRunning, setIsRunning] = useState(false);
+    const [hasTake, setHasTake] = useState(false);
+
+    // Min/max peaks per pixel column, recomputed only when the take or width changes
+    const peaksRef = useRef<{ buffer: AudioBuffer | null; width: number; min: Float32Array; max: Float32Array }>({
+        buffer: null, width: 0, min: new Float32Array(0), max: new Float32Array(0)
+    });
+
+    const dimensions = useCanvasDimensions(0.6);
+
+    // Sync state from engine prop
+    useEffect(() => {
+        if (engine && isActive) {
+            setSource(engine.getSource());
+            setIsRunning(engine.isCloudRunning());
+        } else {
+            setIsRunning(false);
+        }
+    }, [engine, isActive]);
+
+    // Track whether there is anything to granulate
+    useEffect(() => {
+        const update = () => setHasTake(!!(source === 'latest' ? takeRegistry.getLatest() : takeRegistry.get(source)));
+        update();
+        return takeRegistry.subscribe(update);
+    }, [source]);
+
+    const selectSource = (next: GranularSource) => {
+        setSource(next);
+        engine?.setSource(next);
+    };
+
+    const toggleCloud = async () => {
+        if (!engine || !isActive) return;
+        if (isRunning) {
+            engine.stopCloud();
+            setIsRunning(false);
+        } else {
+            await synthManager.resume();
+            engine.startCloud();
+            setIsRunning(true);
+        }
+    };
+
+    // Main render loop
+    useEffect(() => {
+        const canvas = canvasRef.current;
+        if (!canvas) return;
+
+        const ctx = canvas.getContext('2d');
+        if (!ctx) return;
+
+        let animationId: number;
+
+        const render = () => {
+            animationId = requestAnimationFrame(render);
+
+            const w = canvas.width;
+            const h = canvas.height;
+            const cy = h / 2;
+
+            ctx.fillStyle = 'rgba(20, 17, 13, 0.35)';
+            ctx.fillRect(0, 0, w, h);
+
+            const take = engine?.getTake();
+            if (!take) return;
+
+            const peaks = peaksRef.current;
+            if (peaks.buffer !== take.buffer || peaks.width !== w) {
+                const data = take.buffer.getChannelData(0);
+                const min = new Float32Array(w);
+                const max = new Float32Array(w);
+                const step = data.length / w;
+                for (let x = 0; x < w; x++) {
+                    let lo = 0, hi = 0;
+                    const end = Math.min(data.length, Math.floor((x + 1) * step));
+                    for (let i = Math.floor(x * step); i < end; i++) {
+                        if (data[i] < lo) lo = data[i];
+                        if (data[i] > hi) hi = data[i];
+                    }
+                    min[x] = lo;
+                    max[x] = hi;
+                }
+                peaksRef.current = { buffer: take.buffer, width: w, min, max };
+            }
+
+            // Waveform
+            const { min, max } = peaksRef.current;
+            ctx.fillStyle = 'rgba(180, 140, 80, 0.5)';
+            for (let x = 0; x < w; x++) {
+                const top = cy - max[x] * cy * 0.8;
+                const bottom = cy - min[x] * cy * 0.8;
+                ctx.fillRect(x, top, 1, Math.max(1, bottom - top));
+            }
+
+            // Read window: centre plus spray range
+            const { position, spray } = engine!.getReadWindow();
+            const px = position * w;
+            const halfSpray = spray * 0.5 * w;
+            ctx.fillStyle = 'rgba(252, 211, 77, 0.12)';
+            ctx.fillRect(px - halfSpray, 0, halfSpray * 2, h);
+            ctx.strokeStyle = 'rgba(252, 211, 77, 0.9)';
+            ctx.lineWidth = 2;
+            ctx.beginPath();
+            ctx.moveTo(px, 0);
+            ctx.lineTo(px, h);
+            ctx.stroke();
+
+            // Dust: one speck per live grain around the read window
+            if (isRunning) {
+                const grains = engine!.getLiveGrainCount();
+                ctx.fillStyle = 'rgba(253, 230, 138, 0.7)';
+                for (let i = 0; i < grains; i++) {
+                    const gx = px + (Math.random() * 2 - 1) * (halfSpray + 4);
+                    const gy = cy + (Math.random() * 2 - 1) * cy * 0.6;
+                    ctx.fillRect(gx, gy, 2, 2);
+                }
+            }
+        };
+
+        render();
+        return () => cancelAnimationFrame(animationId);
+    }, [isActive, engine, isRunning]);
+
+    return (
+        <div className="w-full h-full flex flex-col items-center justify-center bg-[#14110d] overflow-hidden relative">
+            <canvas
+                ref={canvasRef}
+                width={dimensions.width}
+                height={dimensions.height}
+                className="absolute top-0 left-0 w-full h-full z-0"
+            />
+
+            {/* Header */}
+            <div className="absolute top-4 w-full text-center z-10 pointer-events-none">
+                <h2 className="text-amber-900 font-mono tracking-[0.5em] text-[10px] uppercase opacity-60">
+                    Nube de Grans
+                </h2>
+            </div>
+
+            {!hasTake && (
+                <div className="absolute inset-0 flex items-center justify-center z-10 pointer-events-none">
+                    <p className="text-amber-200/50 text-xs font-mono uppercase tracking-widest text-center px-8">
+                        Sen toma gravada — grava en Echo Vessel ou Vocoder
+                    </p>
+                </div>
+            )}
+
+            {/* Controls Overlay */}
+            <div className={`absolute bottom-8 w-full max-w-lg px-4 z-20 flex flex-col gap-6 transition-opacity duration-500 ${!isActive ? 'opacity-30 pointer-events-none grayscale' : ''}`}>
+                <div className="flex justify-center gap-2">
+                    {SOURCES.map(s => (
+                        <button
+                            key={s.id}
+                            onClick={() => selectSource(s.id)}
+                            className={`px-3 py-1 rounded-full text-[9px] uppercase tracking-widest border transition-all ${source === s.id
+                                ? 'border-amber-400 text-amber-300 bg-amber-900/30'
+                                : 'border-amber-900/40 text-amber-700 bg-black/40'
+                                }`}
+                        >
+                            {s.label}
+                        </button>
+                    ))}
+                </div>
+
+                <div className="flex justify-center">
+                    <button
+                        onClick={toggleCloud}
+                        disabled={!hasTake}
+                        className={`w-20 h-20 rounded-full border-2 flex items-center justify-center transition-all disabled:opacity-30 ${isRunning
+                            ? 'border-amber-400 bg-amber-900/30 text-amber-300 shadow-[0_0_20px_rgba(251,191,36,0.4)]'
+                            : 'border-amber-800 text-amber-700 bg-black/40 backdrop-blur-sm'
+                            }`}
+                    >
+                        <span className="text-3xl">{isRunning ? '⏹️' : '✨'}</span>
+                    </button>
+                </div>
+
+                <div className="text-center text-amber-500/60 text-xs font-mono uppercase tracking-widest">
+                    {isRunning ? 'Esparexendo grans...' : 'Iniciar Nube'}
+                </div>
+            </div>
+        </div>
+    );
+};
+
+export default GranularUI;
@@ -0,0 +1,96 @@
+import React, { useEffect, useState } from 'react';
+import { synthManager } from '../services/SynthManager';
+
+/** Engines that loop a recorded take through a LoopPlayer */
+interface LoopEngine {
+    setLoopTimeStretch(speed: number): void;
+    setLoopPitch(semitones: number): void;
+    fitLoopToTempo(bpm: number, beats: number): number;
+}
+
+interface LoopControlsProps {
+    engine: LoopEngine | undefined;
+    /** Tailwind colour name for the active state (cyan, emerald, ...) */
+    accent: 'cyan' | 'emerald';
+}
+
+const BEAT_CHOICES = [4, 8, 16];
+
+/**
+ * Tempo and pitch of the recorded loop, set independently, plus fitting one
+ * pass of the loop to a number of beats at the shared (Brétema) tempo.
+ */
+const LoopControls: React.FC<LoopControlsProps> = ({ engine, accent }) => {
+    const [speed, setSpeed] = useState(1);
+    const [semitones, setSemitones] = useState(0);
+    const [fittedBeats, setFittedBeats] = useState<number | null>(null);
+
+    // A new take starts at its own tempo and key
+    useEffect(() => {
+        setSpeed(1);
+        setSemitones(0);
+        setFittedBeats(null);
+    }, [engine]);
+
+    const changeSpeed = (value: number) => {
+        engine?.setLoopTimeStretch(value);
+        setSpeed(value);
+        setFittedBeats(null);
+    };
+
+    const changePitch = (value: number) => {
+        engine?.setLoopPitch(value);
+        setSemitones(value);
+    };
+
+    const fit = (beats: number) => {
+        if (!engine) return;
+        setSpeed(engine.fitLoopToTempo(synthManager.getTempo(), beats));
+        setFittedBeats(beats);
+    };
+
+    const activeText = accent === 'cyan' ? 'text-cyan-400' : 'text-emerald-400';
+    const activeButton = accent === 'cyan'
+        ? 'border-cyan-500 bg-cyan-900/30 text-cyan-400'
+        : 'border-emerald-500 bg-emerald-900/30 text-emerald-400';
+
+    return (
+        <div className="flex flex-col gap-2 text-[10px] font-mono uppercase tracking-widest text-slate-500">
+            <label className="flex items-center gap-3">
+                <span className="w-12">Tempo</span>
+                <input
+                    type="range" min={0.25} max={2} step={0.01} value={speed}
+                    onChange={(e) => changeSpeed(parseFloat(e.target.value))}
+                    className="flex-1"
+                />
+                <span className={`w-12 text-right ${activeText}`}>×{speed.toFixed(2)}</span>
+            </label>
+            <label className="flex items-center gap-3">
+                <span className="w-12">Altura</span>
+                <input
+                    type="range" min={-12} max={12} step={1} value={semitones}
+                    onChange={(e) => changePitch(parseInt(e.target.value, 10))}
+                    className="flex-1"
+                />
+                <span className={`w-12 text-right ${activeText}`}>{semitones > 0 ? '+' : ''}{semitones} st</span>
+            </label>
+            <div className="flex items-center gap-2">
+                <span>Axustar a {Math.round(synthManager.getTempo())} BPM:</span>
+                {BEAT_CHOICES.map(beats => (
+                    <button
+                        key={beats}
+                        onClick={() => fit(beats)}
+                        className={`px-2 py-0.5 rounded-full border transition-all ${fittedBeats === beats
+                            ? activeButton
+                            : 'border-slate-700 text-slate-600 bg-black/40'
+                            }`}
+                    >
+                        {beats}
+                    </button>
+                ))}
+            </div>
+        </div>
+    );
+};
+
+export default LoopControls;
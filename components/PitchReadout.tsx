@@ -0,0 +1,42 @@
+import React, { useEffect, useRef, useState } from 'react';
+import { PitchEstimate } from '../services/PitchTracker';
+
+interface PitchReadoutProps {
+    /** Latest estimate, or null while nothing is tracked */
+    read: () => PitchEstimate | null;
+    className?: string;
+}
+
+const NOTE_NAMES = ['C', 'C#', 'D', 'D#', 'E', 'F', 'F#', 'G', 'G#', 'A', 'A#', 'B'];
+// Below this the tracker is holding its last pitch rather than hearing one
+const VOICED_CONFIDENCE = 0.5;
+const POLL_MS = 100;
+
+function noteName(frequency: number): string {
+    const midi = Math.round(69 + 12 * Math.log2(frequency / 440));
+    return `${NOTE_NAMES[((midi % 12) + 12) % 12]}${Math.floor(midi / 12) - 1}`;
+}
+
+/**
+ * Tracked pitch as note and Hz, dimmed while unvoiced (the held value is shown)
+ */
+const PitchReadout: React.FC<PitchReadoutProps> = ({ read, className = '' }) => {
+    const [pitch, setPitch] = useState<PitchEstimate | null>(null);
+    const readRef = useRef(read);
+    readRef.current = read;
+
+    useEffect(() => {
+        const id = window.setInterval(() => setPitch(readRef.current()), POLL_MS);
+        return () => window.clearInterval(id);
+    }, []);
+
+    if (!pitch) return null;
+    const voiced = pitch.confidence >= VOICED_CONFIDENCE;
+    return (
+        <span className={`font-mono tabular-nums transition-opacity ${voiced ? 'opacity-100' : 'opacity-40'} ${className}`}>
+            {noteName(pitch.frequency)} {Math.round(pitch.frequency)} Hz
+        </span>
+    );
+};
+
+export default PitchReadout;
@@ -0,0 +1,270 @@
+import React, { useEffect, useRef, useState } from 'react';
+import { SynthState } from '../types';
+import { synthManager } from '../services/SynthManager';
+import { performanceLog, decodePerformance, performanceToScene, engineTypeOf, Performance } from '../services/PerformanceLog';
+import { RenderPiece, ScoreEvent, renderToFile } from '../services/OfflineRenderer';
+import { SceneScore, renderStems } from '../services/StemRenderer';
+import { BreitemaEngine } from '../services/engines/BreitemaEngine';
+
+interface RenderPanelProps {
+    isOpen: boolean;
+    onClose: () => void;
+    engine: string;
+    state: SynthState;
+}
+
+const ENGINE_LABELS: Record<string, string> = {
+    'criosfera': 'Criosfera',
+    'breitema': 'Brétema'
+};
+
+// Criosfera plays a held drone; its release runs out before the end of the file
+const DRONE = [65.41, 98.00, 130.81];
+const DRONE_RELEASE_SECONDS = 8;
+
+/**
+ * Score for an ambient piece on the current settings
+ */
+function buildEvents(engine: string, state: SynthState, duration: number): ScoreEvent[] {
+    const events: ScoreEvent[] = [{ time: 0, type: 'state', state }];
+    if (engine === 'criosfera') {
+        const off = Math.max(1, duration - DRONE_RELEASE_SECONDS);
+        DRONE.forEach((frequency, note) => events.push({ time: 0, type: 'noteOn', note, frequency, velocity: 0.6 }));
+        DRONE.forEach((_, note) => events.push({ time: off, type: 'noteOff', note }));
+    }
+    return events;
+}
+
+function startFor(engine: string): RenderPiece['start'] {
+    return engine === 'breitema' ? (instance) => (instance as BreitemaEngine).startSequencer() : undefined;
+}
+
+function buildPiece(engine: string, state: SynthState, duration: number, seed: number): RenderPiece {
+    return { engine, duration, seed, events: buildEvents(engine, state, duration), start: startFor(engine) };
+}
+
+/**
+ * Every renderable engine as one stem of a scene
+ */
+function buildScene(state: SynthState, duration: number, seed: number): SceneScore {
+    const engines = Object.keys(ENGINE_LABELS);
+    return {
+        duration,
+        seed,
+        stems: engines.map(engine => ({ name: engine, engine, start: startFor(engine) })),
+        events: engines
+            .flatMap(engine => buildEvents(engine, state, duration).map(event => ({ ...event, stem: engine })))
+            .sort((a, b) => a.time - b.time)
+    };
+}
+
+function download(file: Blob, name: string) {
+    const url = URL.createObjectURL(file);
+    const link = document.createElement('a');
+    link.href = url;
+    link.download = name;
+    link.click();
+    setTimeout(() => URL.revokeObjectURL(url), 1000);
+}
+
+const RenderPanel = ({ isOpen, onClose, engine, state }: RenderPanelProps) => {
+    const [minutes, setMinutes] = useState(5);
+    const [asStems, setAsStems] = useState(false);
+    const [progress, setProgress] = useState<number | null>(null);
+    const [error, setError] = useState<string | null>(null);
+    const [recording, setRecording] = useState(false);
+    const [recordedBytes, setRecordedBytes] = useState(0);
+    const [take, setTake] = useState<{ bytes: Uint8Array; performance: Performance } | null>(null);
+    const cancelReplay = useRef<(() => void) | null>(null);
+    const [replaying, setReplaying] = useState(false);
+
+    // The log keeps growing while the panel is closed; show its size when open
+    useEffect(() => {
+        if (!recording || !isOpen) return;
+        const id = setInterval(() => setRecordedBytes(performanceLog.getByteLength()), 500);
+        return () => clearInterval(id);
+    }, [recording, isOpen]);
+
+    if (!isOpen) return null;
+
+    const toggleRecording = () => {
+        setError(null);
+        if (recording) {
+            const bytes = synthManager.stopRecording();
+            setRecording(false);
+            if (bytes) setTake({ bytes, performance: decodePerformance(bytes) });
+            return;
+        }
+        if (!synthManager.startRecording((Date.now() & 0x7fffffff) >>> 0)) {
+            setError('O audio aínda non está activo');
+            return;
+        }
+        // Log where the performance starts from
+        synthManager.updateParameters(state);
+        setRecordedBytes(0);
+        setRecording(true);
+    };
+
+    const toggleReplay = () => {
+        if (cancelReplay.current) {
+            cancelReplay.current();
+            cancelReplay.current = null;
+            setReplaying(false);
+            return;
+        }
+        if (!take) return;
+        setReplaying(true);
+        cancelReplay.current = synthManager.replay(take.performance, () => {
+            cancelReplay.current = null;
+            setReplaying(false);
+        });
+    };
+
+    const stamp = () => new Date().toISOString().replace(/[:.]/g, '-');
+    const renderableInTake = take
+        ? take.performance.events.some(event => engineTypeOf(event.engine) in ENGINE_LABELS)
+        : false;
+
+    const renderTake = async () => {
+        if (!take) return;
+        setError(null);
+        setProgress(0);
+        try {
+            const scene = performanceToScene(take.performance, Object.keys(ENGINE_LABELS));
+            const files = await renderStems(scene, 'performance', undefined, setProgress);
+            const at = stamp();
+            files.stems.forEach((file, i) => download(file, `fantagal-actuacion-${at}-${scene.stems[i].name}.wav`));
+            download(files.mix, `fantagal-actuacion-${at}-mestura.wav`);
+        } catch (err) {
+            console.error('[RenderPanel] Performance render failed:', err);
+            setError('Non se puido renderizar a actuación');
+        }
+        setProgress(null);
+    };
+
+    const supported = asStems || engine in ENGINE_LABELS;
+
+    const render = async () => {
+        setError(null);
+        setProgress(0);
+        try {
+            const seed = (Date.now() & 0x7fffffff) >>> 0;
+            const at = stamp();
+            if (asStems) {
+                const scene = buildScene(state, minutes * 60, seed);
+                const files = await renderStems(scene, 'scene', undefined, setProgress);
+                files.stems.forEach((file, i) => download(file, `fantagal-${at}-${scene.stems[i].name}.wav`));
+                download(files.mix, `fantagal-${at}-mestura.wav`);
+            } else {
+                const file = await renderToFile(buildPiece(engine, state, minutes * 60, seed), `${engine}.wav`, undefined, setProgress);
+                download(file, `fantagal-${engine}-${at}.wav`);
+            }
+        } catch (err) {
+            console.error('[RenderPanel] Render failed:', err);
+            setError('Non se puido renderizar');
+        }
+        setProgress(null);
+    };
+
+    const busy = progress !== null;
+
+    return (
+        <div className="fixed inset-0 z-[210] bg-black/80 backdrop-blur-sm flex items-center justify-center p-6 text-stone-100">
+            <div className="bg-stone-900 border border-stone-700 p-6 w-full max-w-md rounded-lg shadow-2xl">
+                <h3 className="text-lg font-bold text-orange-500 mb-1">Exportar audio</h3>
+                <p className="text-xs text-stone-400 mb-4">
+                    Render sen conexión da peza ambiental co axuste actual, gravado en WAV por anacos.
+                </p>
+
+                <label className="flex items-center gap-2 text-xs text-stone-300 mb-3">
+                    <input type="checkbox" checked={asStems} disabled={busy} onChange={() => setAsStems(!asStems)} />
+                    Escena por pistas ({Object.values(ENGINE_LABELS).join(' + ')}) e mestura
+                </label>
+
+                {supported ? (
+                    <label className="flex items-center gap-3 text-xs text-stone-300 mb-4">
+                        <span>{asStems ? 'Escena' : ENGINE_LABELS[engine]}</span>
+                        <input
+                            type="number"
+                            min={1}
+                            max={60}
+                            value={minutes}
+                            disabled={busy}
+                            onChange={(e) => setMinutes(Math.max(1, Math.min(60, Number(e.target.value) || 1)))}
+                            className="w-16 bg-black/50 border border-stone-600 px-2 py-1 text-xs"
+                        />
+                        <span>minutos</span>
+                    </label>
+                ) : (
+                    <p className="text-xs text-stone-500 mb-4">Só Criosfera e Brétema se poden renderizar sen conexión.</p>
+                )}
+
+                <div className="border-t border-stone-700 pt-4 mb-4">
+                    <h4 className="text-sm font-bold text-orange-400 mb-1">Actuación</h4>
+                    <p className="text-xs text-stone-400 mb-3">
+                        Grava o que toques (notas, parámetros, pasos, engrenaxes) nun rexistro compacto que se pode reproducir ou renderizar.
+                    </p>
+                    <div className="flex flex-wrap items-center gap-2">
+                        <button
+                            onClick={toggleRecording}
+                            disabled={busy || replaying}
+                            className={`px-3 py-1 text-xs rounded disabled:opacity-30 ${recording ? 'bg-red-600' : 'bg-stone-700'}`}
+                        >
+                            {recording ? 'Parar' : 'Gravar'}
+                        </button>
+                        {recording && (
+                            <span className="text-[10px] font-mono text-red-400">● {(recordedBytes / 1024).toFixed(1)} kB</span>
+                        )}
+                        {take && !recording && (
+                            <>
+                                <span className="text-[10px] font-mono text-stone-400">
+                                    {take.performance.duration.toFixed(1)} s · {(take.bytes.length / 1024).toFixed(1)} kB
+                                </span>
+                                <button onClick={toggleReplay} disabled={busy} className="px-3 py-1 text-xs bg-stone-700 rounded disabled:opacity-30">
+                                    {replaying ? 'Deter' : 'Reproducir'}
+                                </button>
+                                <button
+                                    onClick={() => download(new Blob([take.bytes]), `fantagal-actuacion-${stamp()}.fgpl`)}
+                                    disabled={busy}
+                                    className="px-3 py-1 text-xs bg-stone-700 rounded disabled:opacity-30"
+                                >
+                                    Descargar
+                                </button>
+                                <button
+                                    onClick={renderTake}
+                                    disabled={busy || replaying || !renderableInTake}
+                                    className="px-3 py-1 text-xs bg-stone-700 rounded disabled:opacity-30"
+                                >
+                                    Renderizar
+                                </button>
+                            </>
+                        )}
+                    </div>
+                </div>
+
+                {busy && (
+                    <div className="mb-4">
+                        <div className="h-1 bg-black/40">
+                            <div className="h-full bg-orange-500" style={{ width: `${progress! * 100}%` }} />
+                        </div>
+                        <p className="text-[10px] font-mono text-stone-400 mt-1">Renderizando {Math.round(progress! * 100)}%</p>
+                    </div>
+                )}
+                {error && <p className="text-xs text-red-400 mb-4">{error}</p>}
+
+                <div className="flex justify-end gap-2">
+                    <button onClick={onClose} disabled={busy} className="px-4 py-2 text-stone-400 disabled:opacity-30">Pechar</button>
+                    <button
+                        onClick={render}
+                        disabled={!supported || busy}
+                        className="px-4 py-2 bg-orange-600 rounded disabled:opacity-30"
+                    >
+                        Renderizar
+                    </button>
+                </div>
+            </div>
+        </div>
+    );
+};
+
+export default RenderPanel;
@@ -0,0 +1,225 @@
+import React, { useRef, useEffect, useState, useCallback } from 'react';
+import { synthManager } from '../services/SynthManager';
+import { SamplerEngine, SamplerStats } from '../services/engines/SamplerEngine';
+import { isLibrarySupported, listInstruments, importInstrument, deleteInstrument } from '../services/sampler/SampleLibrary';
+
+interface SamplerUIProps {
+    isActive: boolean;
+    engine: SamplerEngine | undefined;
+}
+
+// One chromatic octave, C3 to C4
+const PAD_NAMES = ['Do', 'Do#', 'Re', 'Re#', 'Mi', 'Fa', 'Fa#', 'Sol', 'Sol#', 'La', 'La#', 'Si', 'Do'];
+const PADS = PAD_NAMES.map((label, i) => ({ label, freq: 130.81 * Math.pow(2, i / 12) }));
+
+const SamplerUI: React.FC<SamplerUIProps> = ({ isActive, engine }) => {
+    const [instruments, setInstruments] = useState<string[]>([]);
+    const [current, setCurrent] = useState<string | null>(null);
+    const [zoneCount, setZoneCount] = useState(0);
+    const [status, setStatus] = useState<string | null>(null);
+    const [newName, setNewName] = useState('');
+    const [stats, setStats] = useState<SamplerStats>({ voices: 0, underruns: 0 });
+    const [heldPads, setHeldPads] = useState<Set<number>>(new Set());
+
+    const fileInputRef = useRef<HTMLInputElement>(null);
+    // Note id sounding on each pad
+    const notesRef = useRef<Map<number, number>>(new Map());
+
+    const supported = isLibrarySupported();
+
+    const refresh = useCallback(async () => {
+        if (!supported) return;
+        try {
+            setInstruments(await listInstruments());
+        } catch (err) {
+            console.error('[SamplerUI] Could not list instruments:', err);
+        }
+    }, [supported]);
+
+    useEffect(() => {
+        refresh();
+    }, [refresh]);
+
+    // Sync state from engine prop
+    useEffect(() => {
+        if (engine && isActive) {
+            setCurrent(engine.getInstrument());
+            setZoneCount(engine.getZones().length);
+        }
+    }, [engine, isActive]);
+
+    // Poll voice and underrun counts while visible
+    useEffect(() => {
+        if (!engine || !isActive) return;
+        const id = window.setInterval(() => setStats({ ...engine.getStats() }), 250);
+        return () => window.clearInterval(id);
+    }, [engine, isActive]);
+
+    const load = async (name: string) => {
+        if (!engine) return;
+        setStatus('Abrindo...');
+        try {
+            const zones = await engine.loadInstrument(name);
+            setCurrent(name);
+            setZoneCount(zones.length);
+            setStatus(null);
+        } catch (err) {
+            console.error('[SamplerUI] Load failed:', err);
+            setStatus('Erro ao abrir o instrumento');
+        }
+    };
+
+    const onFiles = async (e: React.ChangeEvent<HTMLInputElement>) => {
+        const files = Array.from(e.target.files ?? []);
+        e.target.value = '';
+        const ctx = synthManager.getAudioContext();
+        if (files.length === 0 || !ctx) return;
+
+        try {
+            const manifest = await importInstrument(ctx, newName, files, (done, total) => {
+                setStatus(`Importando ${done}/${total}...`);
+            });
+            setNewName('');
+            await refresh();
+            await load(manifest.name);
+        } catch (err) {
+            console.error('[SamplerUI] Import failed:', err);
+            setStatus('Erro na importación');
+        }
+    };
+
+    const remove = async (name: string) => {
+        await deleteInstrument(name);
+        if (current === name) {
+            engine?.reset();
+            setCurrent(null);
+            setZoneCount(0);
+        }
+        await refresh();
+    };
+
+    const padDown = async (index: number) => {
+        if (!engine || !isActive) return;
+        await synthManager.resume();
+        const id = engine.playNote(PADS[index].freq, 0.8);
+        if (id === undefined) return;
+        notesRef.current.set(index, id);
+        setHeldPads(prev => new Set(prev).add(index));
+    };
+
+    const padUp = (index: number) => {
+        const id = notesRef.current.get(index);
+        if (id === undefined) return;
+        engine?.stopNote(id);
+        notesRef.current.delete(index);
+        setHeldPads(prev => {
+            const next = new Set(prev);
+            next.delete(index);
+            return next;
+        });
+    };
+
+    return (
+        <div className="w-full h-full flex flex-col items-center justify-center bg-[#100d16] overflow-hidden relative">
+            {/* Header */}
+            <div className="absolute top-4 w-full text-center z-10 pointer-events-none">
+                <h2 className="text-violet-900 font-mono tracking-[0.5em] text-[10px] uppercase opacity-60">
+                    Arquivo Sonoro
+                </h2>
+            </div>
+
+            <div className={`w-full max-w-lg px-4 z-20 flex flex-col gap-6 transition-opacity duration-500 ${!isActive ? 'opacity-30 pointer-events-none grayscale' : ''}`}>
+                {!supported ? (
+                    <p className="text-violet-200/50 text-xs font-mono uppercase tracking-widest text-center px-8">
+                        Este dispositivo non permite almacenar mostras
+                    </p>
+                ) : (
+                    <>
+                        {/* Library */}
+                        <div className="flex flex-col gap-2 max-h-40 overflow-y-auto">
+                            {instruments.length === 0 && (
+                                <p className="text-violet-200/40 text-[10px] font-mono uppercase tracking-widest text-center">
+                                    Arquivo baleiro — importa mostras para comezar
+                                </p>
+                            )}
+                            {instruments.map(name => (
+                                <div key={name} className="flex items-center gap-2">
+                                    <button
+                                        onClick={() => load(name)}
+                                        className={`flex-1 px-3 py-1 rounded-full text-[10px] uppercase tracking-widest border text-left transition-all ${current === name
+                                            ? 'border-violet-400 text-violet-300 bg-violet-900/30'
+                                            : 'border-violet-900/40 text-violet-600 bg-black/40'
+                                            }`}
+                                    >
+                                        {name}
+                                    </button>
+                                    <button
+                                        onClick={() => remove(name)}
+                                        className="px-2 py-1 rounded-full text-[10px] border border-violet-900/40 text-violet-700 bg-black/40"
+                                        title="Borrar"
+                                    >
+                                        ✕
+                                    </button>
+                                </div>
+                            ))}
+                        </div>
+
+                        {/* Import */}
+                        <div className="flex gap-2">
+                            <input
+                                type="text"
+                                value={newName}
+                                onChange={e => setNewName(e.target.value)}
+                                placeholder="Nome do instrumento"
+                                className="flex-1 bg-black/40 border border-violet-900/40 rounded-full px-3 py-1 text-[10px] text-violet-200 font-mono placeholder:text-violet-800 focus:outline-none focus:border-violet-500"
+                            />
+                            <button
+                                onClick={() => fileInputRef.current?.click()}
+                                className="px-3 py-1 rounded-full text-[10px] uppercase tracking-widest border border-violet-700 text-violet-300 bg-violet-900/20"
+                            >
+                                Importar
+                            </button>
+                            <input
+                                ref={fileInputRef}
+                                type="file"
+                                multiple
+                                accept="audio/*"
+                                className="hidden"
+                                onChange={onFiles}
+                            />
+                        </div>
+
+                        {/* Pads */}
+                        <div className="grid grid-cols-7 gap-2">
+                            {PADS.map((pad, i) => (
+                                <button
+                                    key={i}
+                                    disabled={!current}
+                                    onPointerDown={() => padDown(i)}
+                                    onPointerUp={() => padUp(i)}
+                                    onPointerLeave={() => padUp(i)}
+                                    className={`h-12 rounded border text-[9px] font-mono uppercase transition-all touch-none select-none disabled:opacity-30 ${heldPads.has(i)
+                                        ? 'border-violet-300 bg-violet-700/40 text-violet-100 shadow-[0_0_12px_rgba(167,139,250,0.4)]'
+                                        : pad.label.includes('#')
+                                            ? 'border-violet-900/60 bg-black/60 text-violet-700'
+                                            : 'border-violet-800/60 bg-violet-950/40 text-violet-400'
+                                        }`}
+                                >
+                                    {pad.label}
+                                </button>
+                            ))}
+                        </div>
+                    </>
+                )}
+
+                <div className="text-center text-violet-500/60 text-[10px] font-mono uppercase tracking-widest">
+                    {status ?? (current
+                        ? `${zoneCount} zonas · ${stats.voices} voces · ${stats.underruns} baleiros`
+                        : 'Sen instrumento')}
+                </div>
+            </div>
+        </div>
+    );
+};
+
+export default SamplerUI;
@@ -1,4 +1,5 @@
 import React from 'react';
+import { tracer } from '../services/Tracer';
 
 interface SettingsModalProps {
     isOpen: boolean;
@@ -24,6 +25,15 @@ const SettingsModal = ({ isOpen, onClose, apiKey, onSave, setApiKey }: SettingsM
                     onChange={(e) => setApiKey(e.target.value)}
                 />
                 <div className="flex justify-end gap-2">
+                    {__TRACE__ && (
+                        <button
+                            onClick={() => tracer.download()}
+                            className="mr-auto px-2 py-2 text-[10px] uppercase tracking-widest text-stone-500 hover:text-stone-300"
+                            title="Garda os últimos eventos de audio para chrome://tracing"
+                        >
+                            Exportar traza
+                        </button>
+                    )}
                     <button onClick={onClose} className="px-4 py-2 text-stone-400">Cancelar</button>
                     <button onClick={() => onSave(apiKey)} className="px-4 py-2 bg-orange-600 rounded">Gardar</button>
                 </div>
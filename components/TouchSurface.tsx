@@ -0,0 +1,133 @@
+import React, { useEffect, useRef } from 'react';
+import { synthManager } from '../services/SynthManager';
+import { EXPRESSION_LANES } from '../services/dsp/AdditiveBank';
+
+interface TouchSurfaceProps {
+  /** Pitch at the left and right edges (Hz); X is exponential in between */
+  lowHz?: number;
+  highHz?: number;
+}
+
+interface Finger {
+  lane: number;
+  noteId: number | undefined;
+}
+
+// Octave lines: C2, C3, C4
+const GUIDES = [{ label: 'C2', hz: 65.41 }, { label: 'C3', hz: 130.81 }, { label: 'C4', hz: 261.63 }];
+
+/**
+ * Polyphonic touch surface for Criosfera: every finger plays its own voice,
+ * X is pitch, Y brightness and touch pressure the voice's level. Moves are
+ * written into the engine's expression lanes through SynthManager (which logs
+ * them for replay) and the finger markers are moved directly, so no React
+ * state changes while playing.
+ */
+const TouchSurface: React.FC<TouchSurfaceProps> = ({ lowHz = 65.41, highHz = 261.63 }) => {
+  const containerRef = useRef<HTMLDivElement>(null);
+  const markerRefs = useRef<(HTMLDivElement | null)[]>([]);
+  const fingers = useRef<Map<number, Finger>>(new Map());
+
+  const frequencyAt = (x: number) => lowHz * Math.pow(highHz / lowHz, x);
+
+  // Pressure-less pointers (mouse, most touch screens) report 0.5 or 0 / 1
+  const pressureOf = (e: React.PointerEvent) =>
+    e.pointerType === 'pen' || (e.pressure > 0 && e.pressure !== 0.5 && e.pressure !== 1) ? e.pressure : 0.7;
+
+  const write = (finger: Finger, e: React.PointerEvent) => {
+    const rect = containerRef.current!.getBoundingClientRect();
+    const x = Math.max(0, Math.min(1, (e.clientX - rect.left) / rect.width));
+    const y = Math.max(0, Math.min(1, 1 - (e.clientY - rect.top) / rect.height));
+    const pressure = pressureOf(e);
+    synthManager.setExpression(finger.lane, frequencyAt(x), y, pressure);
+
+    const marker = markerRefs.current[finger.lane];
+    if (marker) {
+      marker.style.left = `${x * 100}%`;
+      marker.style.top = `${(1 - y) * 100}%`;
+      marker.style.transform = `scale(${0.6 + pressure * 0.8})`;
+      marker.style.opacity = '1';
+    }
+  };
+
+  const release = (pointerId: number) => {
+    const finger = fingers.current.get(pointerId);
+    if (!finger) return;
+    fingers.current.delete(pointerId);
+    if (finger.noteId !== undefined) synthManager.stopNote(finger.noteId, 'criosfera');
+    const marker = markerRefs.current[finger.lane];
+    if (marker) marker.style.opacity = '0';
+  };
+
+  const onPointerDown = (e: React.PointerEvent) => {
+    const engine = synthManager.getCriosferaEngine();
+    if (!engine?.getExpression()) return;
+
+    const used = new Set([...fingers.current.values()].map(f => f.lane));
+    let lane = 0;
+    while (lane < EXPRESSION_LANES && used.has(lane)) lane++;
+    if (lane === EXPRESSION_LANES) return;
+
+    e.currentTarget.setPointerCapture(e.pointerId);
+    const finger: Finger = { lane, noteId: undefined };
+    write(finger, e);
+    finger.noteId = synthManager.playExpressive(lane);
+    fingers.current.set(e.pointerId, finger);
+  };
+
+  const onPointerMove = (e: React.PointerEvent) => {
+    const finger = fingers.current.get(e.pointerId);
+    if (finger) write(finger, e);
+  };
+
+  const onPointerUp = (e: React.PointerEvent) => release(e.pointerId);
+
+  // Leaving the view releases whatever is still held
+  useEffect(() => () => {
+    [...fingers.current.keys()].forEach(release);
+  }, []);
+
+  return (
+    <div className="flex flex-col items-center w-full max-w-[320px] mx-auto select-none touch-none">
+      <div className="flex justify-between w-full text-[10px] text-orange-500 mb-1 tracking-widest uppercase font-mono">
+        <span>Y: Brillo</span>
+        <span>X: Altura</span>
+      </div>
+
+      <div
+        ref={containerRef}
+        className="relative w-full aspect-square bg-stone-900/30 border border-stone-800/50 rounded-xl overflow-hidden backdrop-blur-sm shadow-inner cursor-crosshair touch-none"
+        onPointerDown={onPointerDown}
+        onPointerMove={onPointerMove}
+        onPointerUp={onPointerUp}
+        onPointerCancel={onPointerUp}
+      >
+        {/* Octave guides */}
+        {GUIDES.filter(g => g.hz >= lowHz && g.hz <= highHz).map(g => {
+          const left = `${(Math.log(g.hz / lowHz) / Math.log(highHz / lowHz)) * 100}%`;
+          return (
+            <div key={g.label} className="absolute top-0 bottom-0 pointer-events-none" style={{ left }}>
+              <div className="w-[1px] h-full bg-orange-500/10" />
+              <span className="absolute bottom-2 left-1 text-[9px] text-orange-500/30 font-bold">{g.label}</span>
+            </div>
+          );
+        })}
+
+        {/* One marker per lane, moved directly by the pointer handlers */}
+        {Array.from({ length: EXPRESSION_LANES }, (_, lane) => (
+          <div
+            key={lane}
+            ref={el => { markerRefs.current[lane] = el; }}
+            className="absolute w-16 h-16 -ml-8 -mt-8 rounded-full pointer-events-none opacity-0 transition-opacity duration-150"
+          >
+            <div className="absolute inset-0 bg-orange-500/25 rounded-full blur-xl" />
+            <div className="absolute inset-4 bg-orange-400/40 rounded-full blur-md" />
+            <div className="absolute inset-[38%] bg-orange-100/80 rounded-full blur-[1px] shadow-[0_0_15px_rgba(249,115,22,0.8)]" />
+          </div>
+        ))}
+      </div>
+    </div>
+  );
+};
+
+export default TouchSurface;
@@ -0,0 +1,10 @@
+/**
+ * Pure canvas draw routines shared by the visual components and the
+ * frame-time benchmark (bench.html). They only touch the 2D context and the
+ * state passed in, so they run the same on an on-screen canvas and on an
+ * OffscreenCanvas.
+ */
+export type Canvas2D = CanvasRenderingContext2D | OffscreenCanvasRenderingContext2D;
+
+/** Random source; the benchmark passes a seeded one for repeatable frames */
+export type RandomFn = () => number;
@@ -0,0 +1,243 @@
+import { Canvas2D, RandomFn } from './canvas';
+
+export interface CaveParticle {
+    x: number;
+    y: number;
+    z: number;
+    vx: number;
+    vy: number;
+    vz: number;
+    life: number;
+    maxLife: number;
+    size: number;
+    color: { r: number; g: number; b: number };
+    type: 'stalactite' | 'fluid' | 'spark';
+}
+
+export interface CaveWave {
+    radius: number;
+    intensity: number;
+    frequency: number;
+}
+
+/** Mutable per-canvas state: particles, expanding waves and smoothed band levels */
+export interface CaveScene {
+    particles: CaveParticle[];
+    waves: CaveWave[];
+    bands: number[];
+}
+
+export function createCaveScene(bandCount: number = 12): CaveScene {
+    return { particles: [], waves: [], bands: Array(bandCount).fill(0) };
+}
+
+/**
+ * Vocoder cave: walls, concentric waves, spectral bars, central crystal and particles.
+ * `bands` must already hold the smoothed RMS per vocoder band.
+ */
+export function drawCaveFrame(ctx: Canvas2D, w: number, h: number, time: number, scene: CaveScene, playing: boolean, random: RandomFn = Math.random) {
+    const cx = w / 2;
+    const cy = h / 2;
+
+    // Update concentric waves
+    scene.waves = scene.waves
+        .map(wave => ({
+            ...wave,
+            radius: wave.radius + (wave.frequency * 2),
+            intensity: wave.intensity * 0.95
+        }))
+        .filter(wave => wave.intensity > 0.01);
+
+    // Add new waves based on audio activity
+    const totalAmplitude = scene.bands.reduce((sum, val) => sum + val, 0) / scene.bands.length;
+    if (totalAmplitude > 0.1 && random() < totalAmplitude * 5) {
+        const avgFreq = scene.bands.reduce((sum, val, idx) => sum + val * idx, 0) /
+            Math.max(0.001, scene.bands.reduce((sum, val) => sum + val, 0));
+
+        scene.waves.push({
+            radius: 50,
+            intensity: totalAmplitude,
+            frequency: 2 + avgFreq * 3
+        });
+    }
+
+    // Clear with cave-like background
+    const gradient = ctx.createRadialGradient(cx, cy, 0, cx, cy, Math.max(w, h) / 2);
+    gradient.addColorStop(0, 'rgba(5, 10, 15, 0.9)');
+    gradient.addColorStop(0.7, 'rgba(10, 20, 15, 0.7)');
+    gradient.addColorStop(1, 'rgba(0, 5, 10, 0.9)');
+    ctx.fillStyle = gradient;
+    ctx.fillRect(0, 0, w, h);
+
+    // Draw cave walls with depth effect
+    ctx.save();
+    ctx.globalCompositeOperation = 'overlay';
+    for (let i = 0; i < 50; i++) {
+        const angle = (i / 50) * Math.PI * 2;
+        const distance = 100 + Math.sin(time * 0.5 + i * 0.3) * 20;
+        const x = cx + Math.cos(angle) * distance;
+        const y = cy + Math.sin(angle) * distance;
+
+        const size = 5 + Math.sin(time * 2 + i) * 3;
+        const alpha = 0.1 + Math.sin(time * 0.3 + i) * 0.05;
+
+        ctx.beginPath();
+        ctx.arc(x, y, size, 0, Math.PI * 2);
+        ctx.fillStyle = `rgba(20, 100, 80, ${alpha})`;
+        ctx.fill();
+    }
+    ctx.restore();
+
+    // Draw concentric waves
+    scene.waves.forEach(wave => {
+        const radius = wave.radius;
+        const intensity = wave.intensity;
+
+        if (radius < Math.min(w, h) / 2) {
+            ctx.beginPath();
+            ctx.arc(cx, cy, radius, 0, Math.PI * 2);
+            ctx.strokeStyle = `rgba(100, 255, 200, ${intensity * 0.4})`;
+            ctx.lineWidth = 2 + intensity * 4;
+            ctx.stroke();
+
+            // Inner glow
+            ctx.beginPath();
+            ctx.arc(cx, cy, radius - 2, 0, Math.PI * 2);
+            ctx.strokeStyle = `rgba(50, 200, 150, ${intensity * 0.2})`;
+            ctx.lineWidth = 1;
+            ctx.stroke();
+        }
+    });
+
+    // Draw spectral bars around the edge
+    const barCount = scene.bands.length;
+    for (let i = 0; i < barCount; i++) {
+        const amplitude = scene.bands[i];
+        const angle = (i / barCount) * Math.PI * 2;
+        const innerRadius = Math.min(w, h) * 0.35;
+        const outerRadius = innerRadius + amplitude * 50;
+
+        const x1 = cx + Math.cos(angle) * innerRadius;
+        const y1 = cy + Math.sin(angle) * innerRadius;
+        const x2 = cx + Math.cos(angle) * outerRadius;
+        const y2 = cy + Math.sin(angle) * outerRadius;
+
+        // Color based on frequency band (green to blue)
+        const hue = 120 + (i / barCount) * 60; // Green to cyan
+        ctx.strokeStyle = `hsla(${hue}, 80%, 60%, ${0.3 + amplitude * 0.7})`;
+        ctx.lineWidth = 3 + amplitude * 5;
+        ctx.lineCap = 'round';
+        ctx.beginPath();
+        ctx.moveTo(x1, y1);
+        ctx.lineTo(x2, y2);
+        ctx.stroke();
+    }
+
+    // Draw central crystal formation
+    const crystalSize = 30 + totalAmplitude * 40;
+    ctx.save();
+    ctx.translate(cx, cy);
+    ctx.rotate(time * 0.5);
+
+    // Crystal core
+    const coreGradient = ctx.createRadialGradient(0, 0, 0, 0, 0, crystalSize);
+    coreGradient.addColorStop(0, `rgba(100, 255, 200, ${0.3 + totalAmplitude * 0.4})`);
+    coreGradient.addColorStop(0.5, `rgba(50, 200, 150, ${0.2 + totalAmplitude * 0.3})`);
+    coreGradient.addColorStop(1, `rgba(20, 100, 80, 0.1)`);
+
+    ctx.fillStyle = coreGradient;
+    ctx.beginPath();
+    for (let i = 0; i < 6; i++) {
+        const angle = (i / 6) * Math.PI * 2;
+        const x = Math.cos(angle) * crystalSize;
+        const y = Math.sin(angle) * crystalSize;
+        if (i === 0) ctx.moveTo(x, y);
+        else ctx.lineTo(x, y);
+    }
+    ctx.closePath();
+    ctx.fill();
+
+    // Crystal glow
+    ctx.shadowColor = 'rgba(100, 255, 200, 0.8)';
+    ctx.shadowBlur = 20 + totalAmplitude * 30;
+    ctx.strokeStyle = `rgba(100, 255, 200, ${0.5 + totalAmplitude * 0.5})`;
+    ctx.lineWidth = 2;
+    ctx.stroke();
+    ctx.restore();
+
+    // Draw floating particles that respond to audio
+    for (let i = scene.particles.length - 1; i >= 0; i--) {
+        const p = scene.particles[i];
+
+        // Update position
+        p.x += p.vx;
+        p.y += p.vy;
+        p.z += p.vz;
+        p.life -= 0.005;
+
+        // Physics
+        if (p.type === 'stalactite') {
+            p.vy += 0.05; // Gravity
+        } else if (p.type === 'fluid') {
+            p.vx *= 0.98;
+            p.vy *= 0.98;
+            p.vz *= 0.98;
+        }
+
+        // Remove dead particles
+        if (p.life <= 0 || p.y > h + 50 || p.x < -50 || p.x > w + 50) {
+            scene.particles.splice(i, 1);
+            continue;
+        }
+
+        // 3D projection (simple perspective)
+        const scale = 200 / (200 + p.z);
+        const screenX = p.x * scale + (1 - scale) * w / 2;
+        const screenY = p.y * scale + (1 - scale) * h / 2;
+        const screenSize = p.size * scale;
+
+        // Draw particle
+        const alpha = p.life * 0.8;
+        ctx.beginPath();
+        ctx.arc(screenX, screenY, screenSize, 0, Math.PI * 2);
+
+        // Glow effect
+        const gradient = ctx.createRadialGradient(screenX, screenY, 0, screenX, screenY, screenSize * 2);
+        gradient.addColorStop(0, `rgba(${p.color.r}, ${p.color.g}, ${p.color.b}, ${alpha})`);
+        gradient.addColorStop(0.5, `rgba(${p.color.r}, ${p.color.g}, ${p.color.b}, ${alpha * 0.5})`);
+        gradient.addColorStop(1, `rgba(${p.color.r}, ${p.color.g}, ${p.color.b}, 0)`);
+
+        ctx.fillStyle = gradient;
+        ctx.fill();
+    }
+
+    // Spawn new particles based on audio activity
+    if (playing) {
+        const avgAmplitude = scene.bands.reduce((sum, val) => sum + val, 0) / scene.bands.length;
+        if (avgAmplitude > 0.05 && random() < avgAmplitude * 10) {
+            // Create particles that respond to the average audio amplitude
+            const angle = random() * Math.PI * 2;
+            const distance = 50 + random() * 100;
+            const x = cx + Math.cos(angle) * distance;
+            const y = cy + Math.sin(angle) * distance;
+
+            scene.particles.push({
+                x: x,
+                y: y,
+                z: random() * 100,
+                vx: Math.cos(angle + Math.PI) * avgAmplitude * 3,
+                vy: Math.sin(angle + Math.PI) * avgAmplitude * 3,
+                vz: (random() - 0.5) * 2,
+                life: 0.5 + random() * 1.0,
+                maxLife: 1.5,
+                size: 1 + avgAmplitude * 8,
+                color: {
+                    r: 100 + Math.floor(avgAmplitude * 100),
+                    g: 200 + Math.floor(avgAmplitude * 55),
+                    b: 150 + Math.floor(avgAmplitude * 105)
+                },
+                type: random() > 0.5 ? 'fluid' : 'spark'
+            });
+        }
+    }
+}
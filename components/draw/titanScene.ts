@@ -0,0 +1,87 @@
+import { Canvas2D, RandomFn } from './canvas';
+
+export interface TitanParticle {
+    x: number;
+    y: number;
+    r: number;
+    vx: number;
+    vy: number;
+}
+
+export interface TitanParams {
+    turbulence: number;
+    viscosity: number;
+    pressure: number;
+}
+
+export function createTitanParticles(count: number, width: number, height: number, random: RandomFn = Math.random): TitanParticle[] {
+    const particles: TitanParticle[] = [];
+    for (let i = 0; i < count; i++) {
+        particles.push({
+            x: random() * width,
+            y: random() * height,
+            r: random() * 4 + 1,
+            vx: (random() - 0.5) * 2,
+            vy: (random() - 0.5) * 2,
+        });
+    }
+    return particles;
+}
+
+/**
+ * Criosfera background: Titan gradient, organic pipes, methane fog and drifting particles
+ */
+export function drawTitanFrame(ctx: Canvas2D, width: number, height: number, time: number, particles: TitanParticle[], params: TitanParams) {
+    const { turbulence, viscosity, pressure } = params;
+
+    // Draw background gradient
+    const gradient = ctx.createRadialGradient(
+        width / 2, height / 2, 0,
+        width / 2, height / 2, width
+    );
+
+    // Orange/Gold Titan hues
+    const hue = 30 + (pressure * 20);
+    gradient.addColorStop(0, `hsla(${hue}, 80%, 40%, 0.4)`);
+    gradient.addColorStop(1, `hsla(${hue - 10}, 100%, 5%, 0.8)`);
+
+    ctx.fillStyle = gradient;
+    ctx.fillRect(0, 0, width, height);
+
+    // Organic "Pipes" (simulated via vertical columns)
+    const columnCount = 12;
+    const colWidth = width / columnCount;
+    for (let i = 0; i < columnCount; i++) {
+        const h = Math.sin(time + i * 0.5) * 50 * turbulence + (height * 0.5);
+        const opacity = 0.1 + (pressure * 0.3);
+        ctx.fillStyle = `rgba(255, 140, 0, ${opacity})`;
+        ctx.fillRect(i * colWidth + 10, height - h, colWidth - 20, h);
+    }
+
+    // "Methane" fog
+    ctx.globalAlpha = 0.3;
+    for (let i = 0; i < 3; i++) {
+        const shiftX = Math.sin(time * 0.5 + i) * 100;
+        const shiftY = Math.cos(time * 0.3 + i) * 50;
+        ctx.fillStyle = `rgba(200, 100, 0, ${0.1 * viscosity})`;
+        ctx.beginPath();
+        ctx.arc(width / 2 + shiftX, height / 2 + shiftY, 300 + i * 100, 0, Math.PI * 2);
+        ctx.fill();
+    }
+    ctx.globalAlpha = 1.0;
+
+    // Particles
+    particles.forEach(p => {
+        p.x += p.vx * turbulence * 3;
+        p.y += p.vy * (1 - viscosity) * 3;
+        if (p.x < 0) p.x = width;
+        if (p.x > width) p.x = 0;
+        if (p.y < 0) p.y = height;
+        if (p.y > height) p.y = 0;
+
+        ctx.fillStyle = `rgba(255, 200, 100, ${0.4 + pressure * 0.5})`;
+        ctx.beginPath();
+        ctx.arc(p.x, p.y, p.r, 0, Math.PI * 2);
+        ctx.fill();
+    });
+}
@@ -0,0 +1,57 @@
+import { Canvas2D } from './canvas';
+
+export type Vial = 'neutral' | 'mercury' | 'amber';
+
+/**
+ * Echo Vessel plasma ring: trailing clear, container and the time-domain
+ * waveform wrapped around the circle (`data` holds unsigned bytes, 128 = silence)
+ */
+export function drawVesselFrame(ctx: Canvas2D, w: number, h: number, data: Uint8Array, vial: Vial) {
+    const cx = w / 2;
+    const cy = h / 2;
+    const radius = Math.min(w, h) * 0.4;
+
+    // Clear with trail
+    ctx.fillStyle = 'rgba(10, 15, 20, 0.2)';
+    ctx.fillRect(0, 0, w, h);
+
+    // Draw Container Ring
+    ctx.beginPath();
+    ctx.arc(cx, cy, radius, 0, 2 * Math.PI);
+    ctx.strokeStyle = '#334455';
+    ctx.lineWidth = 2;
+    ctx.stroke();
+
+    // Draw Plasma Wave
+    ctx.beginPath();
+    ctx.lineWidth = 4;
+
+    let rBase = radius * 0.9;
+    if (vial === 'mercury') {
+        ctx.strokeStyle = '#00ffff'; // Cyan
+        ctx.shadowColor = '#00ffff';
+    } else if (vial === 'amber') {
+        ctx.strokeStyle = '#ffaa00'; // Amber
+        ctx.shadowColor = '#ffaa00';
+    } else {
+        ctx.strokeStyle = '#ffffff';
+        ctx.shadowColor = '#ffffff';
+    }
+    ctx.shadowBlur = 15;
+
+    for (let i = 0; i < data.length; i++) {
+        const v = data[i] / 128.0; // 0..2 (1 is silence)
+        const angle = (i / data.length) * 2 * Math.PI;
+
+        // Polar conversion with modulation
+        const r = rBase + (v - 1) * 100; // Amplitude affects radius
+        const x = cx + r * Math.cos(angle);
+        const y = cy + r * Math.sin(angle);
+
+        if (i === 0) ctx.moveTo(x, y);
+        else ctx.lineTo(x, y);
+    }
+    ctx.closePath();
+    ctx.stroke();
+    ctx.shadowBlur = 0;
+}
@@ -1,9 +1,15 @@
 import { useState, useEffect, useRef } from 'react';
-import { ParameterType, SynthState } from '../types';
-import { synthManager } from '../services/SynthManager';
-import { fetchTitanCondition } from '../services/GeminiService';
+import { ParameterType, SynthState, PlanetaryCondition } from '../types';
+import { synthManager, SceneSlice } from '../services/SynthManager';
+import { engineRegistry } from '../services/EngineRegistry';
+import { fetchTitanConditions, fetchTitanScene, interpolateConditions } from '../services/GeminiService';
+import { conditionToSynthState } from '../services/conditionMapping';
+import { analyzePrompt } from '../services/LocalOracle';
 
-export const useSynth = (initialEngine: 'criosfera' | 'gearheart' | 'echo-vessel' | 'vocoder', apiKeyProp: string) => {
+// Variations requested per oracle call; browsing them needs no further round trips
+const AI_VARIATIONS = 4;
+
+export const useSynth = (initialEngine: 'criosfera' | 'gearheart' | 'echo-vessel' | 'vocoder' | 'breitema' | 'grans' | 'sampler', apiKeyProp: string) => {
     const [currentEngine, setCurrentEngine] = useState(initialEngine);
     const [initializedEngines, setInitializedEngines] = useState<Set<string>>(new Set());
     const [isAiLoading, setIsAiLoading] = useState(false);
@@ -21,7 +27,9 @@ export const useSynth = (initialEngine: 'criosfera' | 'gearheart' | 'echo-vessel
         'gearheart': { ...defaultSynthState },
         'echo-vessel': { ...defaultSynthState },
         'vocoder': { ...defaultSynthState },
-        'breitema': { ...defaultSynthState }
+        'breitema': { ...defaultSynthState },
+        'grans': { ...defaultSynthState },
+        'sampler': { ...defaultSynthState }
     });
 
     const [aiPrompts, setAiPrompts] = useState<Record<string, string>>({
@@ -29,7 +37,9 @@ export const useSynth = (initialEngine: 'criosfera' | 'gearheart' | 'echo-vessel
         'gearheart': '',
         'echo-vessel': '',
         'vocoder': '',
-        'breitema': ''
+        'breitema': '',
+        'grans': '',
+        'sampler': ''
     });
 
     const [titanReports, setTitanReports] = useState<Record<string, string>>({
@@ -37,16 +47,30 @@ export const useSynth = (initialEngine: 'criosfera' | 'gearheart' | 'echo-vessel
         'gearheart': 'Sistema en espera...',
         'echo-vessel': 'Sistema en espera...',
         'vocoder': 'Sistema en espera...',
-        'breitema': 'Sistema en espera...'
+        'breitema': 'Sistema en espera...',
+        'grans': 'Sistema en espera...',
+        'sampler': 'Sistema en espera...'
     });
 
+    // Cached oracle variations per engine, the selected one and the morph towards the next
+    const [aiVariations, setAiVariations] = useState<Record<string, PlanetaryCondition[]>>({});
+    const [variationIndices, setVariationIndices] = useState<Record<string, number>>({});
+    const [variationMorphs, setVariationMorphs] = useState<Record<string, number>>({});
+
     const [playingFrequencies, setPlayingFrequencies] = useState<Map<number, number>>(new Map());
     const activeNotesRef = useRef<Map<number, number>>(new Map());
+    // Optional second instance of the current engine, doubling every note an octave down
+    const layerRef = useRef<string | null>(null);
+    const layerNotesRef = useRef<Map<number, number>>(new Map());
+    const [isLayered, setIsLayered] = useState(false);
 
     const state = engineStates[currentEngine] || defaultSynthState;
     const isCurrentActive = initializedEngines.has(currentEngine);
     const aiPrompt = aiPrompts[currentEngine] || '';
     const titanReport = titanReports[currentEngine] || '';
+    const variations = aiVariations[currentEngine] || [];
+    const variationIndex = variationIndices[currentEngine] ?? 0;
+    const variationMorph = variationMorphs[currentEngine] ?? 0;
 
     const setState = (updater: SynthState | ((prev: SynthState) => SynthState)) => {
         setEngineStates(prev => ({
@@ -61,9 +85,43 @@ export const useSynth = (initialEngine: 'criosfera' | 'gearheart' | 'echo-vessel
     useEffect(() => {
         if (isCurrentActive) {
             synthManager.updateParameters(state);
+            if (layerRef.current?.startsWith(`${currentEngine}#`)) synthManager.updateParameters(state, layerRef.current);
         }
     }, [state, currentEngine, isCurrentActive]);
 
+    const playLayerNote = (freq: number) => {
+        if (!layerRef.current) return;
+        const id = synthManager.playNote(freq / 2, 0.5, layerRef.current);
+        if (id !== undefined) layerNotesRef.current.set(freq, id);
+    };
+
+    const stopLayerNote = (freq: number) => {
+        const id = layerNotesRef.current.get(freq);
+        if (id !== undefined && layerRef.current) synthManager.stopNote(id, layerRef.current);
+        layerNotesRef.current.delete(freq);
+    };
+
+    /**
+     * Add or remove a second instance of the current engine (shares its reverbs
+     * and tables, costs only voices). Held notes are doubled straight away.
+     */
+    const toggleLayer = () => {
+        if (layerRef.current) {
+            [...layerNotesRef.current.keys()].forEach(stopLayerNote);
+            synthManager.destroyInstance(layerRef.current);
+            layerRef.current = null;
+            setIsLayered(false);
+            return;
+        }
+        if (!isCurrentActive) return;
+        const handle = synthManager.createInstance(currentEngine);
+        if (!handle) return;
+        layerRef.current = handle;
+        synthManager.updateParameters(state, handle);
+        activeNotesRef.current.forEach((_, freq) => playLayerNote(freq));
+        setIsLayered(true);
+    };
+
     const handleStart = async () => {
         await synthManager.init();
         await synthManager.resume();
@@ -78,6 +136,7 @@ export const useSynth = (initialEngine: 'criosfera' | 'gearheart' | 'echo-vessel
                     synthManager.stopNote(id);
                 });
                 activeNotesRef.current.clear();
+                if (layerRef.current) toggleLayer();
                 setPlayingFrequencies(new Map());
             } else if (currentEngine === 'gearheart') {
                 const gearEngine = synthManager.getGearheartEngine();
@@ -107,6 +166,13 @@ export const useSynth = (initialEngine: 'criosfera' | 'gearheart' | 'echo-vessel
                 if (breitemaEngine?.reset) {
                     breitemaEngine.reset();
                 }
+            } else if (currentEngine === 'grans') {
+                const granularEngine = synthManager.getGranularEngine();
+                if (granularEngine) {
+                    granularEngine.reset();
+                }
+            } else if (currentEngine === 'sampler') {
+                synthManager.getSamplerEngine()?.reset();
             }
 
             setTitanReport('Sistema en espera...');
@@ -126,7 +192,7 @@ export const useSynth = (initialEngine: 'criosfera' | 'gearheart' | 'echo-vessel
         }
     };
 
-    const switchEngine = (engine: 'criosfera' | 'gearheart' | 'echo-vessel' | 'vocoder' | 'breitema') => {
+    const switchEngine = (engine: 'criosfera' | 'gearheart' | 'echo-vessel' | 'vocoder' | 'breitema' | 'grans' | 'sampler') => {
         setCurrentEngine(engine);
         synthManager.switchEngine(engine);
     };
@@ -142,6 +208,7 @@ export const useSynth = (initialEngine: 'criosfera' | 'gearheart' | 'echo-vessel
             const id = activeNotesRef.current.get(freq);
             if (id !== undefined) {
                 synthManager.stopNote(id);
+                stopLayerNote(freq);
                 activeNotesRef.current.delete(freq);
                 setPlayingFrequencies(prev => {
                     const next = new Map(prev);
@@ -153,6 +220,7 @@ export const useSynth = (initialEngine: 'criosfera' | 'gearheart' | 'echo-vessel
             const id = synthManager.playNote(freq, 0.7);
             if (id !== undefined) {
                 activeNotesRef.current.set(freq, id);
+                playLayerNote(freq);
                 setPlayingFrequencies(prev => {
                     const next = new Map(prev);
                     next.set(freq, id);
@@ -162,52 +230,135 @@ export const useSynth = (initialEngine: 'criosfera' | 'gearheart' | 'echo-vessel
         }
     };
 
+    const describeAiError = (err: any): string => {
+        // Provide more specific error messages
+        let errorMessage = "Erro descoñecido ao consultar o Oráculo.";
+        const errMsg = err?.message?.toLowerCase() || '';
+
+        if (errMsg.includes('fetch') || errMsg.includes('network') || errMsg.includes('failed to fetch')) {
+            errorMessage = "Erro de conexión. Verifica a túa rede e tenta de novo.";
+        } else if (errMsg.includes('401') || errMsg.includes('api key') || errMsg.includes('unauthorized')) {
+            errorMessage = "Erro de autenticación. A API Key pode ser inválida.";
+        } else if (errMsg.includes('429') || errMsg.includes('rate limit') || errMsg.includes('quota')) {
+            errorMessage = "Demasiadas solicitudes. Agarda uns segundos e tenta de novo.";
+        } else if (errMsg.includes('timeout')) {
+            errorMessage = "A solicitude tardou demasiado. Tenta de novo.";
+        } else if (err?.message) {
+            errorMessage = `Erro: ${err.message}`;
+        }
+
+        return errorMessage;
+    };
+
+    const applyCondition = (condition: PlanetaryCondition, speak: boolean) => {
+        setState(prev => ({ ...prev, ...conditionToSynthState(condition) }));
+        const reportText = condition.description || "Transmutación completada.";
+        setTitanReport(reportText);
+
+        if (speak && currentEngine === 'echo-vessel') {
+            const echoEngine = synthManager.getEchoVesselEngine();
+            if (echoEngine) {
+                echoEngine.setSpeechText(reportText);
+                echoEngine.speakOnce();
+            }
+        }
+    };
+
+    const selectVariation = (index: number) => {
+        if (variations.length === 0) return;
+        const wrapped = (index + variations.length) % variations.length;
+        setVariationIndices(prev => ({ ...prev, [currentEngine]: wrapped }));
+        setVariationMorphs(prev => ({ ...prev, [currentEngine]: 0 }));
+        applyCondition(variations[wrapped], true);
+    };
+
+    const nextVariation = () => selectVariation(variationIndex + 1);
+    const prevVariation = () => selectVariation(variationIndex - 1);
+
+    /**
+     * Blend locally from the selected variation towards the next one (0..1)
+     */
+    const morphVariation = (t: number) => {
+        if (variations.length < 2) return;
+        const from = variations[variationIndex];
+        const to = variations[(variationIndex + 1) % variations.length];
+        setVariationMorphs(prev => ({ ...prev, [currentEngine]: t }));
+        applyCondition(interpolateConditions(from, to, t), false);
+    };
+
+    /**
+     * The offline lexicon reading is applied at once; the network oracle refines it when
+     * (and if) it answers. Without an API key the local reading is the whole answer.
+     */
     const generateAIPatch = async () => {
+        if (!aiPrompt) return;
+        const local = analyzePrompt(aiPrompt);
+        setAiVariations(prev => ({ ...prev, [currentEngine]: [local] }));
+        setVariationIndices(prev => ({ ...prev, [currentEngine]: 0 }));
+        setVariationMorphs(prev => ({ ...prev, [currentEngine]: 0 }));
+        applyCondition(local, !apiKeyProp);
+        if (!apiKeyProp) return;
+
+        setIsAiLoading(true);
+        try {
+            const conditions = await fetchTitanConditions(aiPrompt, apiKeyProp, AI_VARIATIONS, local);
+            setAiVariations(prev => ({ ...prev, [currentEngine]: conditions }));
+            applyCondition(conditions[0], true);
+        } catch (err: any) {
+            // The local reading stays applied; the report says why it wasn't refined
+            console.error("AI Patch Error:", err);
+            setTitanReport(describeAiError(err));
+        } finally {
+            setIsAiLoading(false);
+        }
+    };
+
+    /**
+     * One oracle call configures every registered engine; results are committed in one batch
+     */
+    const generateAIScene = async () => {
         if (!aiPrompt || !apiKeyProp) return;
         setIsAiLoading(true);
         try {
-            const condition = await fetchTitanCondition(aiPrompt, apiKeyProp);
-            const clamp = (v: number) => Math.max(0, Math.min(1, v));
-
-            const s = {
-                turbulence: clamp(condition.stormLevel ?? 0.5),
-                viscosity: clamp(condition.methaneDensity ?? 0.5),
-                pressure: clamp(condition.temperature ?? 0.5),
-                resonance: clamp(0.5 + ((condition.stormLevel ?? 0.5) * 0.5)),
-                diffusion: clamp(0.3 + ((condition.methaneDensity ?? 0.5) * 0.4))
-            };
-
-            setState(prev => ({ ...prev, ...s }));
-            const reportText = condition.description || "Transmutación completada.";
-            setTitanReport(reportText);
-
-            if (currentEngine === 'echo-vessel') {
+            const definitions = engineRegistry.getAll();
+            const scene = await fetchTitanScene(aiPrompt, apiKeyProp, definitions);
+
+            const nextStates: Record<string, SynthState> = {};
+            const nextReports: Record<string, string> = {};
+            const slices: SceneSlice[] = [];
+            for (const definition of definitions) {
+                const condition = scene.engines[definition.name];
+                if (!condition) continue;
+                nextStates[definition.name] = conditionToSynthState(condition);
+                nextReports[definition.name] = condition.description || scene.description || "Transmutación completada.";
+                slices.push({
+                    name: definition.name,
+                    state: nextStates[definition.name],
+                    // Engine-specific extras (gear layout, step pattern)
+                    apply: definition.applyScene && (engine => definition.applyScene!(engine, condition))
+                });
+            }
+
+            // Every live engine changes in the same pass; unopened ones get their slice when opened
+            synthManager.applyScene(slices);
+            setEngineStates(prev => ({ ...prev, ...nextStates }));
+            setTitanReports(prev => ({ ...prev, ...nextReports }));
+            setAiVariations(prev => {
+                const next = { ...prev };
+                Object.keys(nextStates).forEach(name => delete next[name]);
+                return next;
+            });
+
+            if (currentEngine === 'echo-vessel' && nextReports['echo-vessel']) {
                 const echoEngine = synthManager.getEchoVesselEngine();
                 if (echoEngine) {
-                    echoEngine.setSpeechText(reportText);
+                    echoEngine.setSpeechText(nextReports['echo-vessel']);
                     echoEngine.speakOnce();
                 }
             }
         } catch (err: any) {
-            console.error("AI Patch Error:", err);
-
-            // Provide more specific error messages
-            let errorMessage = "Erro descoñecido ao consultar o Oráculo.";
-            const errMsg = err?.message?.toLowerCase() || '';
-
-            if (errMsg.includes('fetch') || errMsg.includes('network') || errMsg.includes('failed to fetch')) {
-                errorMessage = "Erro de conexión. Verifica a túa rede e tenta de novo.";
-            } else if (errMsg.includes('401') || errMsg.includes('api key') || errMsg.includes('unauthorized')) {
-                errorMessage = "Erro de autenticación. A API Key pode ser inválida.";
-            } else if (errMsg.includes('429') || errMsg.includes('rate limit') || errMsg.includes('quota')) {
-                errorMessage = "Demasiadas solicitudes. Agarda uns segundos e tenta de novo.";
-            } else if (errMsg.includes('timeout')) {
-                errorMessage = "A solicitude tardou demasiado. Tenta de novo.";
-            } else if (err?.message) {
-                errorMessage = `Erro: ${err.message}`;
-            }
-
-            setTitanReport(errorMessage);
+            console.error("AI Scene Error:", err);
+            setTitanReport(describeAiError(err));
         } finally {
             setIsAiLoading(false);
         }
@@ -229,7 +380,16 @@ export const useSynth = (initialEngine: 'criosfera' | 'gearheart' | 'echo-vessel
         toggleEngine,
         updateParam,
         toggleNote,
+        isLayered,
+        toggleLayer,
         generateAIPatch,
+        generateAIScene,
+        variationCount: variations.length,
+        variationIndex,
+        variationMorph,
+        nextVariation,
+        prevVariation,
+        morphVariation,
         setAiPrompt,
         setTitanReport,
         handleStart,
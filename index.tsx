@@ -1,16 +1,35 @@
 
-import React from 'react';
+import React, { Profiler } from 'react';
 import ReactDOM from 'react-dom/client';
+import { Capacitor } from '@capacitor/core';
+import './index.css';
 import App from './App';
+import { watchdog } from './services/Watchdog';
 
 const rootElement = document.getElementById('root');
 if (!rootElement) {
   throw new Error("Could not find root element to mount to");
 }
 
+// Main-thread stall detection; React commits are attributed through the Profiler
+// (its callback only fires in development and profiling builds)
+watchdog.start();
+const onRender: React.ProfilerOnRenderCallback = (_id, _phase, actualDuration, _baseDuration, startTime) => {
+  watchdog.span('render', startTime, startTime + actualDuration);
+};
+
+// Web build works offline from the precache (sw.js); the Android app already serves local files
+if (import.meta.env.PROD && 'serviceWorker' in navigator && !Capacitor.isNativePlatform()) {
+  window.addEventListener('load', () => {
+    navigator.serviceWorker.register('/sw.js').catch(err => console.warn('Service worker registration failed:', err));
+  });
+}
+
 const root = ReactDOM.createRoot(rootElement);
 root.render(
   <React.StrictMode>
-    <App />
+    <Profiler id="app" onRender={onRender}>
+      <App />
+    </Profiler>
   </React.StrictMode>
 );
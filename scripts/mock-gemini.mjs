@@ -0,0 +1,109 @@
+// Servidor local que imita o endpoint generateContent de Gemini.
+// Uso: npm run mock:gemini  e logo  GEMINI_BASE_URL=http://localhost:8787 npm run dev
+// Devolve tantas variacións como pida o prompt ("Devolve N variacións"), con valores
+// deterministas a partir do texto, para probar a navegación sen rede nin cota.
+// Os prompts de escena ("Compón unha escena") reciben unha condición por motor.
+import http from 'node:http';
+
+const PORT = Number(process.env.MOCK_GEMINI_PORT || 8787);
+
+const DESCRIPTIONS = [
+    'O metano canta baixo a codia xeada.',
+    'Tormentas lentas peitean as tubaxes do abismo.',
+    'A néboa laranxa garda ecos de engrenaxes.',
+    'Un oráculo de xeo respira no fondo.',
+    'Ondas de hidrocarburo arrolan a lúa morta.',
+    'Cristais de nitróxeno soan como campás afogadas.'
+];
+
+// Hash simple (FNV-1a) para que o mesmo prompt dea sempre as mesmas variacións
+function hash(text) {
+    let h = 0x811c9dc5;
+    for (let i = 0; i < text.length; i++) {
+        h ^= text.charCodeAt(i);
+        h = Math.imul(h, 0x01000193) >>> 0;
+    }
+    return h;
+}
+
+function makeVariations(prompt, count) {
+    let seed = hash(prompt) || 1;
+    const next = () => {
+        seed ^= seed << 13; seed >>>= 0;
+        seed ^= seed >>> 17;
+        seed ^= seed << 5; seed >>>= 0;
+        return seed / 4294967296;
+    };
+    const arrangements = ['linear', 'cluster', 'chaotic'];
+    return Array.from({ length: count }, () => ({
+        stormLevel: Number(next().toFixed(3)),
+        temperature: Number(next().toFixed(3)),
+        methaneDensity: Number(next().toFixed(3)),
+        description: DESCRIPTIONS[Math.floor(next() * DESCRIPTIONS.length)],
+        gearConfig: {
+            numGears: 3 + Math.floor(next() * 6),
+            arrangement: arrangements[Math.floor(next() * arrangements.length)]
+        }
+    }));
+}
+
+function makeScene(prompt, names) {
+    const conditions = makeVariations(prompt, names.length);
+    const engines = {};
+    names.forEach((name, i) => {
+        const condition = { ...conditions[i] };
+        if (name === 'breitema') {
+            const steps = Array.from({ length: 16 }, (_, s) => ((hash(prompt) >>> s) & 1) === 1);
+            condition.pattern = { rhythmMode: 'muineira', steps };
+        }
+        engines[name] = condition;
+    });
+    return { description: DESCRIPTIONS[hash(prompt) % DESCRIPTIONS.length], engines };
+}
+
+const server = http.createServer((req, res) => {
+    res.setHeader('Access-Control-Allow-Origin', '*');
+    res.setHeader('Access-Control-Allow-Headers', '*');
+    res.setHeader('Access-Control-Allow-Methods', 'POST, OPTIONS');
+    if (req.method === 'OPTIONS') {
+        res.writeHead(204).end();
+        return;
+    }
+    if (req.method !== 'POST' || !req.url?.includes(':generateContent')) {
+        res.writeHead(404, { 'Content-Type': 'application/json' });
+        res.end(JSON.stringify({ error: { code: 404, message: 'Not found' } }));
+        return;
+    }
+
+    let body = '';
+    req.on('data', (chunk) => { body += chunk; });
+    req.on('end', () => {
+        let prompt = '';
+        try {
+            const request = JSON.parse(body);
+            prompt = request.contents?.[0]?.parts?.[0]?.text ?? '';
+        } catch { /* corpo inválido: prompt baleiro */ }
+
+        let text;
+        if (prompt.includes('Compón unha escena')) {
+            // Escena: unha condición por cada motor listado como "- nome (Nome visible)"
+            const names = [...prompt.matchAll(/^\s*- ([\w-]+) \(/gm)].map(m => m[1]);
+            text = JSON.stringify(makeScene(prompt, names));
+            console.log(`[mock-gemini] escena para ${names.join(', ')}`);
+        } else {
+            const match = prompt.match(/Devolve (\d+) variacións/);
+            const count = match ? Math.max(1, Math.min(16, Number(match[1]))) : 1;
+            text = JSON.stringify({ variations: makeVariations(prompt, count) });
+            console.log(`[mock-gemini] ${count} variación(s) para: ${prompt.split('\n')[0].slice(0, 80)}`);
+        }
+        res.writeHead(200, { 'Content-Type': 'application/json' });
+        res.end(JSON.stringify({
+            candidates: [{ content: { role: 'model', parts: [{ text }] }, finishReason: 'STOP', index: 0 }],
+            modelVersion: 'mock'
+        }));
+    });
+});
+
+server.listen(PORT, () => {
+    console.log(`[mock-gemini] escoitando en http://localhost:${PORT}`);
+});
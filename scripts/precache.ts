@@ -0,0 +1,36 @@
+import fs from 'node:fs';
+import path from 'node:path';
+import crypto from 'node:crypto';
+import type { Plugin } from 'vite';
+
+/**
+ * Emits sw.js with a precache manifest of every file in the build (chunks,
+ * worklets, CSS, fonts, index.html). The manifest version is a hash of the
+ * file list and contents, so any change to the build installs a new worker
+ * and drops the old cache.
+ */
+export function precache(): Plugin {
+    return {
+        name: 'criosfera-precache',
+        apply: 'build',
+        generateBundle(_options, bundle) {
+            const hash = crypto.createHash('sha256');
+            const files: string[] = [];
+            for (const fileName of Object.keys(bundle).sort()) {
+                if (fileName.endsWith('.map')) continue;
+                const item = bundle[fileName];
+                hash.update(fileName);
+                hash.update(item.type === 'chunk' ? item.code : item.source);
+                files.push(`/${fileName}`);
+            }
+
+            const manifest = { version: hash.digest('hex').slice(0, 12), files: ['/', ...files] };
+            const template = fs.readFileSync(path.resolve(__dirname, 'sw-template.js'), 'utf-8');
+            this.emitFile({
+                type: 'asset',
+                fileName: 'sw.js',
+                source: template.replace('__PRECACHE_MANIFEST__', JSON.stringify(manifest))
+            });
+        }
+    };
+}
@@ -0,0 +1,38 @@
+// Service worker da versión web: precarga todo o build para arrancar sen rede.
+// O plugin de precarga (scripts/precache.ts) substitúe __PRECACHE_MANIFEST__
+// polo manifesto do build, así que cada build cambia este ficheiro e o
+// navegador instala a nova versión.
+const MANIFEST = __PRECACHE_MANIFEST__;
+const CACHE = `criosfera-${MANIFEST.version}`;
+
+self.addEventListener('install', (event) => {
+    event.waitUntil(
+        caches.open(CACHE)
+            .then(cache => cache.addAll(MANIFEST.files))
+            .then(() => self.skipWaiting())
+    );
+});
+
+self.addEventListener('activate', (event) => {
+    event.waitUntil(
+        caches.keys()
+            .then(keys => Promise.all(keys.filter(key => key !== CACHE).map(key => caches.delete(key))))
+            .then(() => self.clients.claim())
+    );
+});
+
+// Cache primeiro para o propio orixe; as chamadas a Gemini e demais van á rede
+self.addEventListener('fetch', (event) => {
+    const request = event.request;
+    if (request.method !== 'GET' || new URL(request.url).origin !== self.location.origin) return;
+
+    event.respondWith(
+        caches.match(request, { ignoreSearch: request.mode === 'navigate' }).then(cached => {
+            if (cached) return cached;
+            if (request.mode === 'navigate') {
+                return fetch(request).catch(() => caches.match('/index.html'));
+            }
+            return fetch(request);
+        })
+    );
+});
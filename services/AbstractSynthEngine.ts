@@ -1,5 +1,7 @@
 import { SynthState } from '../types';
 import { ISynthEngine } from './BaseSynthEngine';
+import { tracer } from './Tracer';
+import { SeededRandom } from './SeededRandom';
 
 /**
  * Abstract base class for synth engines.
@@ -12,6 +14,11 @@ export abstract class AbstractSynthEngine implements ISynthEngine {
     protected compressor: DynamicsCompressorNode | null = null;
     protected masterBus: GainNode | null = null;
     protected isInitialized = false;
+    // Performance randomness (see random()); null draws from Math.random
+    private rng: SeededRandom | null = null;
+
+    /** Track name for this engine's events in the tracer (set by each engine) */
+    protected readonly traceCategory: string = 'engine';
 
     // Compressor settings (can be overridden by subclasses)
     protected readonly compressorThreshold = -24;
@@ -26,10 +33,12 @@ export abstract class AbstractSynthEngine implements ISynthEngine {
      */
     init(ctx: AudioContext, masterBus?: GainNode): void {
         if (this.isInitialized) return;
+        if (__TRACE__) tracer.begin(this.traceCategory, 'init');
         this.ctx = ctx;
         this.setupMasterChain(masterBus);
         this.initializeEngine();
         this.isInitialized = true;
+        if (__TRACE__) tracer.end(this.traceCategory, 'init');
     }
 
     /**
@@ -87,6 +96,7 @@ export abstract class AbstractSynthEngine implements ISynthEngine {
      * This is used to restore audio after Android communication mode.
      */
     reinitWithContext(ctx: AudioContext, masterBus?: GainNode): void {
+        if (__TRACE__) tracer.instant(this.traceCategory, 'contextReinit');
         this.ctx = ctx;
         this.setupMasterChain(masterBus);
         this.onContextReinit();
@@ -100,6 +110,39 @@ export abstract class AbstractSynthEngine implements ISynthEngine {
         // Override in subclasses if specific reconnection is needed
     }
 
+    /**
+     * Seed the engine's performance randomness (step chances, noise offsets, ...),
+     * so a recorded performance replays the same. Null returns to Math.random.
+     */
+    setSeed(seed: number | null): void {
+        this.rng = seed === null ? null : new SeededRandom(seed);
+        if (seed !== null) this.seedAudioThread(seed);
+    }
+
+    /**
+     * Seed only what draws random numbers on the audio thread (see onSeed).
+     * Offline renders use this: their performance draws come from withRandom.
+     */
+    seedAudioThread(seed: number): void {
+        this.onSeed(seed >>> 0);
+    }
+
+    /**
+     * Called by setSeed and seedAudioThread. Override to pass the seed on to worklet kernels that
+     * draw their own random numbers on the audio thread.
+     */
+    protected onSeed(_seed: number): void {
+        // Nothing runs on the audio thread by default
+    }
+
+    /**
+     * Uniform in [0, 1). Engines use this instead of Math.random for anything a
+     * performance depends on.
+     */
+    protected random(): number {
+        return this.rng ? this.rng.next() : Math.random();
+    }
+
     /**
      * Get the AudioContext (for subclasses that need it)
      */
@@ -0,0 +1,98 @@
+import { SynthState } from '../types';
+import { ensureWorklets } from './worklets/workletLoader';
+import { VoiceExpression } from './VoiceExpression';
+
+/**
+ * Ghost-harmonics oscillator bank.
+ * One worklet node renders every voice's partials; voices are addressed by id
+ * over the port, so playing a note creates no oscillator nodes.
+ */
+export class AdditiveBank {
+    /** Connect this to wherever the partials should enter the graph */
+    public readonly output: GainNode;
+    /** Pitch to follow, in Hz (e.g. PitchTracker.frequency); leave unconnected to play as triggered */
+    public readonly follow: GainNode;
+    /** Per-voice expression lanes (see noteOn) */
+    public readonly expression = new VoiceExpression();
+
+    private readonly ctx: BaseAudioContext;
+    private node: AudioWorkletNode | null = null;
+    private readonly ready: Promise<void>;
+    private nextId = 1;
+    private lastState: SynthState | null = null;
+
+    constructor(ctx: BaseAudioContext) {
+        this.ctx = ctx;
+        this.output = ctx.createGain();
+        this.output.gain.value = 1.0;
+        this.follow = ctx.createGain();
+
+        this.ready = ensureWorklets(ctx).then(() => {
+            this.node = new AudioWorkletNode(ctx, 'additive-bank', {
+                numberOfInputs: 1,
+                numberOfOutputs: 1,
+                outputChannelCount: [1],
+                channelCount: 1,
+                channelCountMode: 'explicit'
+            });
+            this.follow.connect(this.node);
+            this.node.connect(this.output);
+            this.expression.attach(this.node.port);
+            if (this.lastState) this.setShape(this.lastState);
+        }).catch((err) => console.error('[AdditiveBank] Worklet load failed:', err));
+    }
+
+    /**
+     * Start a voice. Returns its id (valid even if the worklet is still loading).
+     * @param lane - Expression lane that drives the voice's pitch, brightness and
+     *               pressure until noteOff; omit for a fixed voice
+     */
+    noteOn(frequency: number, velocity: number, lane: number = -1): number {
+        const id = this.nextId++;
+        // The lane's values ride along: a posted copy of the block may be a frame behind
+        const msg = lane < 0 ? { type: 'noteOn', id, frequency, velocity } : {
+            type: 'noteOn', id, frequency, velocity, lane,
+            brightness: this.expression.getBrightness(lane),
+            pressure: this.expression.getPressure(lane)
+        };
+        if (this.node) {
+            this.node.port.postMessage(msg);
+        } else {
+            this.ready.then(() => this.node?.port.postMessage(msg));
+        }
+        return id;
+    }
+
+    noteOff(id: number, releaseSeconds: number): void {
+        if (this.node) {
+            this.node.port.postMessage({ type: 'noteOff', id, release: releaseSeconds });
+        } else {
+            this.ready.then(() => this.node?.port.postMessage({ type: 'noteOff', id, release: releaseSeconds }));
+        }
+    }
+
+    /** Seed the voices' random phases, detune and ghost partials */
+    setSeed(seed: number): void {
+        if (this.node) {
+            this.node.port.postMessage({ type: 'seed', seed });
+        } else {
+            this.ready.then(() => this.node?.port.postMessage({ type: 'seed', seed }));
+        }
+    }
+
+    allNotesOff(): void {
+        this.node?.port.postMessage({ type: 'allOff' });
+    }
+
+    /**
+     * Shape the spectra from the synth state (k-rate, smoothed)
+     */
+    setShape(state: SynthState, timeConstant: number = 0.2): void {
+        this.lastState = state;
+        if (!this.node) return;
+        const t = this.ctx.currentTime;
+        this.node.parameters.get('pressure')!.setTargetAtTime(state.pressure, t, timeConstant);
+        this.node.parameters.get('resonance')!.setTargetAtTime(state.resonance, t, timeConstant);
+        this.node.parameters.get('turbulence')!.setTargetAtTime(state.turbulence, t, timeConstant);
+    }
+}
@@ -5,7 +5,21 @@ export interface ISynthEngine {
   updateParameters(state: SynthState): void;
   playNote(frequency: number, velocity?: number): number | undefined;
   stopNote(id: number): void;
+  /** Start a voice driven by an expression lane (touch surface); stop it with stopNote (optional) */
+  playExpressive?(lane: number, velocity?: number): number | undefined;
   resume(): Promise<void>;
   /** Optional cleanup method called when engine is deactivated */
   reset?(): void;
+  /** Optional teardown called when an engine instance is destroyed */
+  destroy?(): void;
+  /** Seed the engine's performance randomness; null returns to Math.random (optional) */
+  setSeed?(seed: number | null): void;
+  /** Seed only the worklet kernels' own generators, leaving performance draws as they are (optional) */
+  seedAudioThread?(seed: number): void;
+  /** Offline rendering: schedule timer-driven events (sequencers) up to `time` instead of on timers (optional) */
+  advanceTo?(time: number): void;
+  /** Offline rendering: what must carry over into the next chunk, with times relative to now (optional) */
+  saveState?(): unknown;
+  /** Offline rendering: continue from a saveState() snapshot on a fresh context (optional) */
+  restoreState?(snapshot: unknown): void;
 }
\ No newline at end of file
@@ -0,0 +1,49 @@
+import { ensureWorklets } from './worklets/workletLoader';
+
+export type DelayNetworkParam = 'time' | 'feedback' | 'modDepth' | 'modRate' | 'damping' | 'drive' | 'taps';
+
+/**
+ * Feedback delay with its loop inside one worklet node (see dsp/DelayNetwork).
+ * `input` and `output` exist synchronously, so engines can wire the graph
+ * while the module is still loading; the node is spliced in between them.
+ */
+export class DelayNetwork {
+    public readonly input: GainNode;
+    public readonly output: GainNode;
+
+    private readonly ctx: BaseAudioContext;
+    private node: AudioWorkletNode | null = null;
+    // Values set before the node exists, applied once it does
+    private readonly pending = new Map<DelayNetworkParam, number>();
+
+    constructor(ctx: BaseAudioContext, maxSeconds: number, initial: Partial<Record<DelayNetworkParam, number>> = {}) {
+        this.ctx = ctx;
+        this.input = ctx.createGain();
+        this.output = ctx.createGain();
+        (Object.keys(initial) as DelayNetworkParam[]).forEach(name => this.pending.set(name, initial[name]!));
+
+        ensureWorklets(ctx).then(() => {
+            this.node = new AudioWorkletNode(ctx, 'delay-network', {
+                numberOfInputs: 1,
+                numberOfOutputs: 1,
+                outputChannelCount: [2],
+                processorOptions: { maxSeconds }
+            });
+            this.pending.forEach((value, name) => { this.node!.parameters.get(name)!.value = value; });
+            this.pending.clear();
+            this.input.connect(this.node);
+            this.node.connect(this.output);
+        }).catch((err) => console.error('[DelayNetwork] Worklet load failed:', err));
+    }
+
+    /**
+     * Glide a parameter towards `value` (setTargetAtTime semantics)
+     */
+    set(name: DelayNetworkParam, value: number, timeConstant: number = 0.1): void {
+        if (!this.node) {
+            this.pending.set(name, value);
+            return;
+        }
+        this.node.parameters.get(name)!.setTargetAtTime(value, this.ctx.currentTime, timeConstant);
+    }
+}
@@ -1,5 +1,6 @@
+import type { Schema } from '@google/genai';
 import { ISynthEngine } from './BaseSynthEngine';
-import { SynthState } from '../types';
+import { SynthState, PlanetaryCondition } from '../types';
 
 /**
  * Theme configuration for an engine
@@ -32,6 +33,18 @@ export interface EngineDefinition {
 
     /** Default state values (optional, uses global defaults if not provided) */
     defaultState?: Partial<SynthState>;
+
+    /** Extra fields the scene oracle should return for this engine (optional) */
+    sceneSchema?: Record<string, Schema>;
+
+    /** Apply those extra fields to the engine instance (optional) */
+    applyScene?: (engine: ISynthEngine, condition: PlanetaryCondition) => void;
+
+    /**
+     * Seconds for the engine's output to fall 60 dB once nothing new is played,
+     * with these parameters (optional). Offline renders replay this much before each chunk.
+     */
+    tailSeconds?: (state: SynthState) => number;
 }
 
 /**
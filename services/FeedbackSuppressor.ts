@@ -0,0 +1,63 @@
+import { ensureWorklets } from './worklets/workletLoader';
+import type { NotchInfo } from './dsp/FeedbackSuppressor';
+
+export type { NotchInfo };
+
+/**
+ * Adaptive howl suppressor for live microphone input (see dsp/FeedbackSuppressor).
+ * `input` and `output` exist synchronously; the worklet node is spliced in
+ * between them once the module has loaded. Mono: the input is downmixed.
+ */
+export class FeedbackSuppressor {
+    public readonly input: GainNode;
+    public readonly output: GainNode;
+
+    private node: AudioWorkletNode | null = null;
+    private notches: NotchInfo[] = [];
+    private listener: ((notches: NotchInfo[]) => void) | null = null;
+
+    constructor(ctx: BaseAudioContext) {
+        this.input = ctx.createGain();
+        this.output = ctx.createGain();
+
+        ensureWorklets(ctx).then(() => {
+            this.node = new AudioWorkletNode(ctx, 'feedback-suppressor', {
+                numberOfInputs: 1,
+                numberOfOutputs: 1,
+                channelCount: 1,
+                channelCountMode: 'explicit',
+                outputChannelCount: [1]
+            });
+            this.node.port.onmessage = (e: MessageEvent) => {
+                if (e.data.type !== 'notches') return;
+                this.notches = e.data.notches;
+                this.listener?.(this.notches);
+            };
+            this.input.connect(this.node);
+            this.node.connect(this.output);
+        }).catch((err) => console.error('[FeedbackSuppressor] Worklet load failed:', err));
+    }
+
+    /** Notches currently in place, deepest first */
+    getNotches(): NotchInfo[] {
+        return this.notches;
+    }
+
+    /** Called whenever a notch is added, deepened or released */
+    setListener(listener: ((notches: NotchInfo[]) => void) | null): void {
+        this.listener = listener;
+    }
+
+    /** Drop every notch and start learning again */
+    reset(): void {
+        this.node?.port.postMessage({ type: 'reset' });
+    }
+
+    dispose(): void {
+        this.listener = null;
+        this.input.disconnect();
+        this.node?.disconnect();
+        this.node?.port.close();
+        this.node = null;
+    }
+}
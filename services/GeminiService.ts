@@ -1,12 +1,53 @@
-import { GoogleGenAI, Type } from "@google/genai";
-import { PlanetaryCondition } from "../types";
+import { GoogleGenAI, Type, Schema } from "@google/genai";
+import { PlanetaryCondition, TitanScene } from "../types";
+import { EngineDefinition } from "./EngineRegistry";
+import { analyzePrompt } from "./LocalOracle";
+import { watchdog } from "./Watchdog";
 
-export async function fetchTitanCondition(prompt: string, apiKey: string): Promise<PlanetaryCondition> {
+const CONDITION_SCHEMA: Schema = {
+  type: Type.OBJECT,
+  properties: {
+    stormLevel: { type: Type.NUMBER },
+    temperature: { type: Type.NUMBER },
+    methaneDensity: { type: Type.NUMBER },
+    description: { type: Type.STRING },
+    gearConfig: {
+      type: Type.OBJECT,
+      properties: {
+        numGears: { type: Type.NUMBER },
+        arrangement: { type: Type.STRING, enum: ["linear", "cluster", "chaotic"] }
+      }
+    }
+  },
+  required: ["stormLevel", "temperature", "methaneDensity", "description"],
+};
+
+/**
+ * Build the client. GEMINI_BASE_URL (see vite.config) points it at a local
+ * mock server (scripts/mock-gemini.mjs) for offline development.
+ */
+function createClient(apiKey: string): GoogleGenAI {
+  const baseUrl = process.env.GEMINI_BASE_URL;
+  return new GoogleGenAI(baseUrl ? { apiKey, httpOptions: { baseUrl } } : { apiKey });
+}
+
+/**
+ * Ask the oracle for `count` distinct variations of the same request in a single call.
+ * Without an API key returns `[fallback]`, by default the offline lexicon reading of
+ * the prompt. Auth, quota and network errors are logged and rethrown for the caller
+ * to report (see describeAiError in useSynth).
+ */
+export async function fetchTitanConditions(
+  prompt: string,
+  apiKey: string,
+  count: number = 4,
+  fallback: PlanetaryCondition = analyzePrompt(prompt)
+): Promise<PlanetaryCondition[]> {
   if (!apiKey) {
-    throw new Error("Falta a clave API");
+    return [fallback];
   }
 
-  const ai = new GoogleGenAI({ apiKey });
+  const ai = createClient(apiKey);
   try {
     const response = await ai.models.generateContent({
       model: "gemini-3-flash-preview",
@@ -14,9 +55,10 @@ export async function fetchTitanCondition(prompt: string, apiKey: string): Promi
         role: "user",
         parts: [{
           text: `Analiza a atmosfera de Titán para a seguinte solicitude: "${prompt}".
-          Devolve un informe meteorolóxico que dite como se comportarían as tubaxes de resonancia física e os transmutadores vocais.
+          Devolve ${count} variacións distintas do informe meteorolóxico, cada unha ditando como se comportarían as tubaxes de resonancia física e os transmutadores vocais.
+          As variacións deben explorar o espazo sonoro: non repitas valores parecidos.
           IMPORTANT: Todos os valores numéricos (stormLevel, temperature, methaneDensity) deben estar normalizados entre 0.0 e 1.0.
-          A descrición debe estar en galego e ser mística, poética e moi breve (máximo 15 palabras) para ser recitada por un oráculo.`
+          Cada descrición debe estar en galego e ser mística, poética e moi breve (máximo 15 palabras) para ser recitada por un oráculo.`
         }]
       }],
       config: {
@@ -24,23 +66,25 @@ export async function fetchTitanCondition(prompt: string, apiKey: string): Promi
         responseSchema: {
           type: Type.OBJECT,
           properties: {
-            stormLevel: { type: Type.NUMBER },
-            temperature: { type: Type.NUMBER },
-            methaneDensity: { type: Type.NUMBER },
-            description: { type: Type.STRING },
-            gearConfig: {
-              type: Type.OBJECT,
-              properties: {
-                numGears: { type: Type.NUMBER },
-                arrangement: { type: Type.STRING, enum: ["linear", "cluster", "chaotic"] }
-              }
+            variations: {
+              type: Type.ARRAY,
+              items: CONDITION_SCHEMA,
+              minItems: String(count),
+              maxItems: String(count)
             }
           },
-          required: ["stormLevel", "temperature", "methaneDensity", "description"],
+          required: ["variations"],
         },
       },
     });
-    return JSON.parse(response.text);
+    const parseStart = performance.now();
+    const parsed = JSON.parse(response.text ?? '{}');
+    watchdog.span('oracle', parseStart);
+    const variations: PlanetaryCondition[] = Array.isArray(parsed.variations) ? parsed.variations : [];
+    if (variations.length === 0) {
+      throw new Error("Resposta baleira do Oráculo");
+    }
+    return variations;
   } catch (e: any) {
     console.error("Erro detallado de Gemini:", e);
     console.error("Mensaxe de erro:", e.message);
@@ -58,12 +102,89 @@ export async function fetchTitanCondition(prompt: string, apiKey: string): Promi
         console.error("Data:", e.response.data);
       }
     }
-    return {
-      stormLevel: 0.5,
-      temperature: 0.2,
-      methaneDensity: 0.8,
-      description: `Erro: ${e.message}. Verifica a API Key.`,
-      gearConfig: { numGears: 5, arrangement: "cluster" }
+    throw e;
+  }
+}
+
+/**
+ * Ask the oracle for a whole scene: one condition per registered engine, in a single call.
+ * Engines may declare extra fields (gear layout, step pattern...) through their sceneSchema.
+ */
+export async function fetchTitanScene(prompt: string, apiKey: string, engines: EngineDefinition[]): Promise<TitanScene> {
+  if (!apiKey) {
+    throw new Error("Falta a clave API");
+  }
+
+  const engineProperties: Record<string, Schema> = {};
+  for (const engine of engines) {
+    engineProperties[engine.name] = {
+      type: Type.OBJECT,
+      properties: { ...CONDITION_SCHEMA.properties, ...engine.sceneSchema },
+      required: [...(CONDITION_SCHEMA.required ?? []), ...Object.keys(engine.sceneSchema ?? {})]
     };
   }
-}
\ No newline at end of file
+
+  const engineList = engines
+    .map(e => `- ${e.name} (${e.displayName}): parámetros ${Object.values(e.paramLabels).join(', ')}`)
+    .join('\n');
+
+  const ai = createClient(apiKey);
+  const response = await ai.models.generateContent({
+    model: "gemini-3-flash-preview",
+    contents: [{
+      role: "user",
+      parts: [{
+        text: `Analiza a atmosfera de Titán para a seguinte solicitude: "${prompt}".
+        Compón unha escena sonora completa: devolve un informe para cada un destes instrumentos, coherentes entre si pero cada un co seu carácter:
+        ${engineList}
+        Para gearheart inclúe gearConfig (numGears entre 3 e 8). Para breitema inclúe pattern cun rhythmMode e exactamente 16 pasos.
+        IMPORTANT: Todos os valores numéricos (stormLevel, temperature, methaneDensity) deben estar normalizados entre 0.0 e 1.0.
+        As descricións deben estar en galego e ser místicas, poéticas e moi breves (máximo 15 palabras) para ser recitadas por un oráculo.`
+      }]
+    }],
+    config: {
+      responseMimeType: "application/json",
+      responseSchema: {
+        type: Type.OBJECT,
+        properties: {
+          description: { type: Type.STRING },
+          engines: {
+            type: Type.OBJECT,
+            properties: engineProperties,
+            required: engines.map(e => e.name)
+          }
+        },
+        required: ["description", "engines"],
+      },
+    },
+  });
+
+  const parseStart = performance.now();
+  const parsed = JSON.parse(response.text ?? '{}');
+  watchdog.span('oracle', parseStart);
+  if (!parsed.engines || typeof parsed.engines !== 'object') {
+    throw new Error("Resposta baleira do Oráculo");
+  }
+  return { description: parsed.description ?? '', engines: parsed.engines };
+}
+
+export async function fetchTitanCondition(prompt: string, apiKey: string): Promise<PlanetaryCondition> {
+  const [condition] = await fetchTitanConditions(prompt, apiKey, 1);
+  return condition;
+}
+
+/**
+ * Blend two conditions (t = 0 -> a, t = 1 -> b). Numbers interpolate;
+ * description and gear layout switch at the midpoint.
+ */
+export function interpolateConditions(a: PlanetaryCondition, b: PlanetaryCondition, t: number): PlanetaryCondition {
+  const mix = (x: number, y: number) => x + (y - x) * t;
+  const nearer = t < 0.5 ? a : b;
+  return {
+    stormLevel: mix(a.stormLevel, b.stormLevel),
+    temperature: mix(a.temperature, b.temperature),
+    methaneDensity: mix(a.methaneDensity, b.methaneDensity),
+    description: nearer.description,
+    gearConfig: nearer.gearConfig
+  };
+}
@@ -0,0 +1,194 @@
+import { PlanetaryCondition } from '../types';
+
+/**
+ * Offline prompt analyzer: a small Galician/Spanish/English lexicon of weather
+ * and material terms, each pulling one or more condition axes towards a target.
+ * Deterministic and allocation-light (a few hundred string compares), so it
+ * answers well under a frame and can be shown before the network oracle replies.
+ */
+
+type Axis = 'stormLevel' | 'temperature' | 'methaneDensity';
+type Arrangement = 'linear' | 'cluster' | 'chaotic';
+type Side = 'low' | 'mid' | 'high';
+
+interface LexiconEntry {
+    // Accent-free, lowercase. A trailing '*' matches any word starting with the stem.
+    terms: string[];
+    targets: Partial<Record<Axis, number>>;
+    weight: number;
+    arrangement?: Arrangement;
+}
+
+const LEXICON: LexiconEntry[] = [
+    // Storm, wind, violence
+    { terms: ['torment*', 'tempest*', 'temporal*', 'treboad*', 'trebo*', 'storm*', 'thunder*', 'trono*', 'trueno*'], targets: { stormLevel: 0.95 }, weight: 2, arrangement: 'chaotic' },
+    { terms: ['furac*', 'huracan*', 'hurrican*', 'ciclon*', 'cyclon*', 'tornado*', 'galern*', 'torbellin*', 'remuino*', 'whirl*'], targets: { stormLevel: 1 }, weight: 2.5, arrangement: 'chaotic' },
+    { terms: ['vento*', 'viento*', 'wind*', 'gale', 'gales', 'refacho*', 'racha*', 'gust*'], targets: { stormLevel: 0.75 }, weight: 1.5 },
+    { terms: ['raio', 'raios', 'rayo*', 'lostrego*', 'relampag*', 'lightning', 'electric*'], targets: { stormLevel: 0.9, temperature: 0.6 }, weight: 1.5, arrangement: 'chaotic' },
+    { terms: ['caos', 'caotic*', 'chao*', 'violent*', 'furi*', 'fury', 'rabia*', 'rage', 'salvax*', 'salvaj*', 'wild'], targets: { stormLevel: 0.9 }, weight: 1.5, arrangement: 'chaotic' },
+    { terms: ['ola', 'olas', 'onda', 'ondas', 'wave*', 'marea*', 'tide*', 'oleax*', 'oleaj*'], targets: { stormLevel: 0.6, methaneDensity: 0.7 }, weight: 1 },
+
+    // Calm, stillness
+    { terms: ['calm*', 'quiet*', 'queda*', 'still*', 'paz', 'peace*', 'seren*', 'tranquil*', 'placid*'], targets: { stormLevel: 0.05 }, weight: 2, arrangement: 'linear' },
+    { terms: ['silenc*', 'silent*', 'suave*', 'soft*', 'gentle', 'lent*', 'slow*', 'dorm*', 'sleep*', 'sono', 'sueno*', 'repous*', 'repos*', 'rest'], targets: { stormLevel: 0.15 }, weight: 1.5, arrangement: 'linear' },
+    { terms: ['orde', 'orden*', 'order*', 'ritm*', 'rhythm*', 'pulso', 'pulse*', 'regular*', 'mecanic*', 'mechanic*', 'reloxo*', 'reloj*', 'clock*'], targets: { stormLevel: 0.35 }, weight: 1, arrangement: 'linear' },
+
+    // Heat
+    { terms: ['lume', 'fuego*', 'fire*', 'chama*', 'llama*', 'flame*', 'incendi*', 'lava', 'magma', 'volcan*', 'volcano*'], targets: { temperature: 1 }, weight: 2.5 },
+    { terms: ['calor*', 'quent*', 'calient*', 'hot', 'heat*', 'ardent*', 'ardient*', 'burn*', 'brasa*', 'ember*', 'abras*'], targets: { temperature: 0.9 }, weight: 2 },
+    { terms: ['sol', 'sun', 'sunny', 'solar', 'veran*', 'summer*', 'deserto*', 'desierto*', 'desert*'], targets: { temperature: 0.8 }, weight: 1.5 },
+    { terms: ['morno*', 'tibi*', 'warm*', 'temperad*', 'mild'], targets: { temperature: 0.6 }, weight: 1 },
+
+    // Cold
+    { terms: ['xeo', 'xeos', 'hielo*', 'ice', 'icy', 'glaci*', 'polar*', 'criosfer*', 'cryo*'], targets: { temperature: 0.02 }, weight: 2.5 },
+    { terms: ['frio*', 'fria*', 'frigid*', 'cold*', 'xead*', 'helad*', 'frost*', 'conxel*', 'congel*', 'frozen', 'freez*'], targets: { temperature: 0.08 }, weight: 2 },
+    { terms: ['neve*', 'nieve*', 'snow*', 'saraiv*', 'granizo*', 'hail*', 'inverno*', 'invierno*', 'winter*', 'nitrox*', 'nitrog*'], targets: { temperature: 0.15 }, weight: 1.5 },
+    { terms: ['cristal*', 'crystal*', 'vidro*', 'vidrio*', 'glass*'], targets: { temperature: 0.2, methaneDensity: 0.2 }, weight: 1 },
+
+    // Dense atmosphere, liquids, fog
+    { terms: ['metan*', 'methan*', 'hidrocarb*', 'hydrocarb*', 'etano', 'ethane'], targets: { methaneDensity: 0.95 }, weight: 2.5 },
+    { terms: ['nebo*', 'niebla*', 'fog*', 'bretem*', 'brum*', 'mist*', 'haze', 'hazy', 'fume', 'humo*', 'smok*'], targets: { methaneDensity: 0.85, stormLevel: 0.3 }, weight: 2, arrangement: 'cluster' },
+    { terms: ['dens*', 'espes*', 'thick*', 'pesad*', 'heavy', 'xarope*', 'jarabe*', 'syrup*', 'viscos*', 'lama', 'barro*', 'mud*', 'lodo*'], targets: { methaneDensity: 0.9 }, weight: 2, arrangement: 'cluster' },
+    { terms: ['mar', 'mares', 'sea', 'seas', 'ocean*', 'lago*', 'lake*', 'liquid*', 'auga*', 'agua*', 'water*', 'afog*', 'ahog*', 'drown*'], targets: { methaneDensity: 0.8 }, weight: 1.5 },
+    { terms: ['chuvia*', 'choiva*', 'lluvi*', 'rain*', 'orball*', 'drizzl*'], targets: { methaneDensity: 0.7, stormLevel: 0.45, temperature: 0.35 }, weight: 1.5 },
+    { terms: ['nube*', 'nubes', 'nuve*', 'cloud*', 'nublad*', 'cuberto*'], targets: { methaneDensity: 0.7 }, weight: 1, arrangement: 'cluster' },
+    { terms: ['profund*', 'fondo*', 'deep*', 'abism*', 'abyss*', 'cova*', 'cueva*', 'cave*', 'caverna*', 'cavern*'], targets: { methaneDensity: 0.75, temperature: 0.3 }, weight: 1 },
+
+    // Thin, clear, empty
+    { terms: ['aire', 'air', 'ceo', 'cielo*', 'sky', 'skies', 'alto', 'alta', 'high'], targets: { methaneDensity: 0.25 }, weight: 1 },
+    { terms: ['baleir*', 'vaci*', 'void*', 'empty', 'nada', 'nothing', 'espazo*', 'espacio*', 'space*', 'vacuo*', 'vacuum'], targets: { methaneDensity: 0.05 }, weight: 2 },
+    { terms: ['clar*', 'clear*', 'transparen*', 'limp*', 'pur*', 'lixeir*', 'liger*', 'light', 'fin*', 'thin*', 'seco*', 'seca*', 'dry'], targets: { methaneDensity: 0.2 }, weight: 1.5, arrangement: 'linear' }
+];
+
+// Double the weight of the next matched term
+const INTENSIFIERS = new Set(['moi', 'muy', 'very', 'extremadamente', 'extremely', 'totalmente', 'totally', 'tan', 'so', 'mais', 'mas', 'more', 'super', 'hiper', 'hyper']);
+// Mirror the next matched term around the middle of its axes
+const NEGATIONS = new Set(['non', 'no', 'not', 'sen', 'sin', 'without', 'nin', 'ni', 'nor', 'never', 'nunca']);
+
+const AXES: Axis[] = ['stormLevel', 'temperature', 'methaneDensity'];
+const NEUTRAL = 0.5;
+// Weight of the neutral prior: one weak term moves an axis, several dominate it
+const PRIOR_WEIGHT = 1;
+
+// Short Galician phrases per axis region, combined into the oracle line
+const PHRASES: Record<Axis, Record<Side, string[]>> = {
+    stormLevel: {
+        low: ['A calma', 'O silencio quieto', 'Un alento lento'],
+        mid: ['O vento', 'Unha voz antiga', 'O eco'],
+        high: ['A tempestade', 'Ventos sen nome', 'O trono salvaxe']
+    },
+    temperature: {
+        low: ['de xeo', 'de cristal frío', 'de neve morta'],
+        mid: ['de Titán', 'das tubaxes', 'de pedra'],
+        high: ['de lume', 'de brasas fondas', 'de magma vivo']
+    },
+    methaneDensity: {
+        low: ['canta no baleiro.', 'esvaese no ceo limpo.', 'soa no aire fino.'],
+        mid: ['agarda no horizonte.', 'percorre a lúa morta.', 'vibra baixo a codia.'],
+        high: ['afoga na néboa de metano.', 'dorme baixo o mar escuro.', 'respira na bruma espesa.']
+    }
+};
+
+function normalize(text: string): string {
+    return text.toLowerCase().normalize('NFD').replace(/[\u0300-\u036f]/g, '');
+}
+
+// Flattened once at load: [stem, isPrefix, entry]
+const TERMS: Array<[string, boolean, LexiconEntry]> = LEXICON.flatMap(entry =>
+    entry.terms.map((term): [string, boolean, LexiconEntry] =>
+        term.endsWith('*') ? [term.slice(0, -1), true, entry] : [term, false, entry]));
+
+function findEntry(word: string): LexiconEntry | null {
+    for (const [stem, isPrefix, entry] of TERMS) {
+        if (isPrefix ? word.startsWith(stem) : word === stem) return entry;
+    }
+    return null;
+}
+
+// FNV-1a, so the same prompt always picks the same phrasing
+function hash(text: string): number {
+    let h = 0x811c9dc5;
+    for (let i = 0; i < text.length; i++) {
+        h ^= text.charCodeAt(i);
+        h = Math.imul(h, 0x01000193) >>> 0;
+    }
+    return h;
+}
+
+function pick<T>(options: T[], seed: number): T {
+    return options[seed % options.length];
+}
+
+/**
+ * Map a free-text prompt onto a PlanetaryCondition without any network round trip.
+ */
+export function analyzePrompt(prompt: string): PlanetaryCondition {
+    const words = normalize(prompt).split(/[^a-z0-9]+/).filter(Boolean);
+
+    const sums: Record<Axis, number> = { stormLevel: NEUTRAL * PRIOR_WEIGHT, temperature: NEUTRAL * PRIOR_WEIGHT, methaneDensity: NEUTRAL * PRIOR_WEIGHT };
+    const weights: Record<Axis, number> = { stormLevel: PRIOR_WEIGHT, temperature: PRIOR_WEIGHT, methaneDensity: PRIOR_WEIGHT };
+    const arrangementVotes: Record<Arrangement, number> = { linear: 0, cluster: 0, chaotic: 0 };
+
+    let boost = 1;
+    let negate = false;
+    let matched = 0;
+
+    for (const word of words) {
+        if (INTENSIFIERS.has(word)) {
+            boost *= 2;
+            continue;
+        }
+        if (NEGATIONS.has(word)) {
+            negate = true;
+            continue;
+        }
+
+        const entry = findEntry(word);
+        if (!entry) continue;
+        matched++;
+
+        const weight = entry.weight * boost;
+        for (const axis of AXES) {
+            const target = entry.targets[axis];
+            if (target === undefined) continue;
+            sums[axis] += (negate ? 1 - target : target) * weight;
+            weights[axis] += weight;
+        }
+        if (entry.arrangement && !negate) {
+            arrangementVotes[entry.arrangement] += weight;
+        }
+
+        boost = 1;
+        negate = false;
+    }
+
+    const condition = {
+        stormLevel: sums.stormLevel / weights.stormLevel,
+        temperature: sums.temperature / weights.temperature,
+        methaneDensity: sums.methaneDensity / weights.methaneDensity
+    };
+
+    // Gear layout: explicit votes win, otherwise follow the storm
+    let arrangement: Arrangement = condition.stormLevel > 0.66 ? 'chaotic' : condition.methaneDensity > 0.6 ? 'cluster' : 'linear';
+    const bestVote = (Object.keys(arrangementVotes) as Arrangement[]).reduce((a, b) => arrangementVotes[b] > arrangementVotes[a] ? b : a);
+    if (arrangementVotes[bestVote] > 0) arrangement = bestVote;
+
+    const seed = hash(normalize(prompt));
+    const side = (v: number): Side => v < 0.4 ? 'low' : v > 0.6 ? 'high' : 'mid';
+    const description = matched === 0
+        ? 'O oráculo escoita, pero Titán garda silencio.'
+        : [
+            pick(PHRASES.stormLevel[side(condition.stormLevel)], seed),
+            pick(PHRASES.temperature[side(condition.temperature)], seed >>> 3),
+            pick(PHRASES.methaneDensity[side(condition.methaneDensity)], seed >>> 6)
+        ].join(' ');
+
+    return {
+        ...condition,
+        description,
+        gearConfig: {
+            numGears: 3 + Math.round(condition.stormLevel * 5),
+            arrangement
+        }
+    };
+}
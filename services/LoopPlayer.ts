@@ -0,0 +1,122 @@
+import { ensureWorklets } from './worklets/workletLoader';
+
+/**
+ * Looped playback of a recorded take with independent tempo and pitch.
+ * Replaces a looping AudioBufferSourceNode: the take can follow a tempo
+ * (time-stretch) or be retuned (pitch-shift) without changing the other.
+ */
+export class LoopPlayer {
+    /** Connect this to wherever the loop should enter the graph */
+    public readonly output: GainNode;
+
+    private readonly ctx: BaseAudioContext;
+    private node: AudioWorkletNode | null = null;
+    private readonly ready: Promise<void>;
+    private buffer: AudioBuffer | null = null;
+    private playing = false;
+    private position = 0;
+
+    // Last requested values, applied once the worklet exists
+    private speed = 1;
+    private pitch = 1;
+
+    constructor(ctx: BaseAudioContext) {
+        this.ctx = ctx;
+        this.output = ctx.createGain();
+        this.output.gain.value = 1.0;
+
+        this.ready = ensureWorklets(ctx).then(() => {
+            this.node = new AudioWorkletNode(ctx, 'wsola-loop', {
+                numberOfInputs: 0,
+                numberOfOutputs: 1,
+                outputChannelCount: [2]
+            });
+            this.node.port.onmessage = (e: MessageEvent) => {
+                if (e.data.type === 'position') this.position = e.data.value;
+            };
+            this.node.parameters.get('speed')!.value = this.speed;
+            this.node.parameters.get('pitch')!.value = this.pitch;
+            this.node.connect(this.output);
+        });
+        this.ready.catch((err) => console.error('[LoopPlayer] Worklet load failed:', err));
+    }
+
+    /**
+     * Set the take to loop. Takes effect from the start of the loop.
+     */
+    async setBuffer(buffer: AudioBuffer): Promise<void> {
+        this.buffer = buffer;
+        await this.ready;
+        if (!this.node || this.buffer !== buffer) return;
+
+        const channels: Float32Array[] = [];
+        for (let ch = 0; ch < Math.min(2, buffer.numberOfChannels); ch++) {
+            channels.push(buffer.getChannelData(ch).slice());
+        }
+        this.node.port.postMessage({ type: 'source', channels }, channels.map(c => c.buffer));
+    }
+
+    async start(): Promise<void> {
+        this.playing = true;
+        await this.ready;
+        if (this.playing) this.node?.port.postMessage({ type: 'play', playing: true });
+    }
+
+    stop(): void {
+        this.playing = false;
+        this.node?.port.postMessage({ type: 'play', playing: false });
+    }
+
+    isPlaying(): boolean {
+        return this.playing;
+    }
+
+    /**
+     * Playback speed through the take (1 = original tempo, 0 = freeze)
+     */
+    setTimeStretch(speed: number): void {
+        this.speed = Math.max(0, Math.min(4, speed));
+        this.node?.parameters.get('speed')!.setTargetAtTime(this.speed, this.ctx.currentTime, 0.05);
+    }
+
+    /** Current playback speed (see setTimeStretch) */
+    getTimeStretch(): number {
+        return this.speed;
+    }
+
+    /**
+     * Stretch the take so one pass lasts `beats` beats at `bpm`.
+     * Returns the speed applied (unchanged if there is no take yet).
+     */
+    fitToTempo(bpm: number, beats: number): number {
+        if (!this.buffer || bpm <= 0 || beats <= 0) return this.speed;
+        this.setTimeStretch(this.buffer.duration / (beats * 60 / bpm));
+        return this.speed;
+    }
+
+    /**
+     * Transpose in semitones without changing the tempo
+     */
+    setPitch(semitones: number): void {
+        this.pitch = Math.max(0.25, Math.min(4, Math.pow(2, semitones / 12)));
+        this.node?.parameters.get('pitch')!.setTargetAtTime(this.pitch, this.ctx.currentTime, 0.05);
+    }
+
+    /** Current transposition in semitones (see setPitch) */
+    getPitch(): number {
+        return 12 * Math.log2(this.pitch);
+    }
+
+    /**
+     * Current read position, 0..1 of the take
+     */
+    getPosition(): number {
+        return this.position;
+    }
+
+    disconnect(): void {
+        this.stop();
+        this.node?.disconnect();
+        this.output.disconnect();
+    }
+}
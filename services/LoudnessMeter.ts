@@ -0,0 +1,69 @@
+import { ensureWorklets } from './worklets/workletLoader';
+import { LUFS_FLOOR } from './dsp/LoudnessMeter';
+
+export interface LoudnessReading {
+    momentary: number;
+    shortTerm: number;
+}
+
+/**
+ * Multi-input EBU R128 meter. Each slot is metered independently by one
+ * worklet node; readings arrive every 100 ms.
+ */
+export class LoudnessMeter {
+    private node: AudioWorkletNode | null = null;
+    private readonly ready: Promise<void>;
+    private readonly readings: LoudnessReading[];
+    private disposed = false;
+
+    /** Called after every new set of readings */
+    public onReading: ((readings: LoudnessReading[]) => void) | null = null;
+
+    constructor(ctx: BaseAudioContext, slots: number) {
+        this.readings = Array.from({ length: slots }, () => ({ momentary: LUFS_FLOOR, shortTerm: LUFS_FLOOR }));
+
+        this.ready = ensureWorklets(ctx).then(() => {
+            if (this.disposed) return;
+            this.node = new AudioWorkletNode(ctx, 'loudness-meter', {
+                numberOfInputs: slots,
+                numberOfOutputs: 0,
+                channelCount: 2,
+                channelCountMode: 'explicit',
+                processorOptions: { inputs: slots }
+            });
+            this.node.port.onmessage = (e: MessageEvent) => {
+                if (e.data.type !== 'loudness') return;
+                for (let i = 0; i < this.readings.length; i++) {
+                    this.readings[i].momentary = e.data.momentary[i];
+                    this.readings[i].shortTerm = e.data.shortTerm[i];
+                }
+                this.onReading?.(this.readings);
+            };
+        }).catch((err) => console.error('[LoudnessMeter] Worklet load failed:', err));
+    }
+
+    /**
+     * Meter `source` on the given slot (connects once the worklet is loaded)
+     */
+    connect(source: AudioNode, slot: number): void {
+        if (slot < 0 || slot >= this.readings.length) return;
+        if (this.node) {
+            source.connect(this.node, 0, slot);
+        } else {
+            this.ready.then(() => { if (this.node) source.connect(this.node, 0, slot); });
+        }
+    }
+
+    getReading(slot: number): LoudnessReading | undefined {
+        return this.readings[slot];
+    }
+
+    dispose(): void {
+        this.disposed = true;
+        this.onReading = null;
+        if (this.node) {
+            this.node.port.onmessage = null;
+            this.node = null;
+        }
+    }
+}
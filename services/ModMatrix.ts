@@ -0,0 +1,84 @@
+import { ensureWorklets } from './worklets/workletLoader';
+import { LFO_COUNT, SOURCE_ENVELOPE, SOURCE_RANDOM, LfoShape } from './dsp/ModMatrix';
+
+export type { LfoShape };
+export type ModSource = 'lfo1' | 'lfo2' | 'lfo3' | 'lfo4' | 'envelope' | 'random';
+
+function sourceIndex(source: ModSource): number {
+    if (source === 'envelope') return SOURCE_ENVELOPE;
+    if (source === 'random') return SOURCE_RANDOM;
+    return Math.min(LFO_COUNT - 1, Number(source.slice(3)) - 1);
+}
+
+/**
+ * Per-engine modulation matrix (see dsp/ModMatrix). Targets are AudioParams
+ * fixed at construction; routes add `depth × source` on top of each param's
+ * own value. Connect audio to `input` to drive the envelope follower.
+ */
+export class ModMatrix {
+    public readonly input: GainNode;
+
+    private node: AudioWorkletNode | null = null;
+    // Messages sent before the node exists, replayed in order once it does
+    private pending: object[] = [];
+
+    constructor(ctx: BaseAudioContext, targets: AudioParam[]) {
+        this.input = ctx.createGain();
+
+        ensureWorklets(ctx).then(() => {
+            this.node = new AudioWorkletNode(ctx, 'mod-matrix', {
+                numberOfInputs: 1,
+                numberOfOutputs: targets.length,
+                outputChannelCount: targets.map(() => 1),
+                channelCount: 1,
+                channelCountMode: 'explicit',
+                processorOptions: { targets: targets.length }
+            });
+            targets.forEach((param, i) => this.node!.connect(param, i));
+            this.input.connect(this.node);
+            this.pending.forEach(msg => this.node!.port.postMessage(msg));
+            this.pending = [];
+        }).catch((err) => console.error('[ModMatrix] Worklet load failed:', err));
+    }
+
+    setLfo(index: number, rate: number, shape: LfoShape = 'sine'): void {
+        this.send({ type: 'lfo', index, rate, shape });
+    }
+
+    setEnvelope(attack: number, release: number): void {
+        this.send({ type: 'envelope', attack, release });
+    }
+
+    setRandom(rate: number): void {
+        this.send({ type: 'random', rate });
+    }
+
+    /**
+     * Add or change a route; depth is in the target param's units (0 removes it)
+     */
+    route(source: ModSource, target: number, depth: number): void {
+        this.send({ type: 'route', source: sourceIndex(source), target, depth });
+    }
+
+    /** Seed the sample-and-hold and random-walk sources */
+    setSeed(seed: number): void {
+        this.send({ type: 'seed', seed });
+    }
+
+    /** Take the matrix out of the graph; its targets keep their own values */
+    dispose(): void {
+        this.pending = [];
+        this.input.disconnect();
+        this.node?.disconnect();
+        this.node?.port.close();
+        this.node = null;
+    }
+
+    private send(msg: object): void {
+        if (this.node) {
+            this.node.port.postMessage(msg);
+        } else {
+            this.pending.push(msg);
+        }
+    }
+}
@@ -0,0 +1,340 @@
+import { SynthState } from '../types';
+import { ISynthEngine } from './BaseSynthEngine';
+import { engineRegistry } from './EngineRegistry';
+import { ensureWorklets } from './worklets/workletLoader';
+import { SeededRandom, withRandom } from './SeededRandom';
+import { WavWriter } from './WavWriter';
+import { tracer } from './Tracer';
+
+// Import engine registrations to ensure they're registered
+import './engines';
+
+/**
+ * Long-form offline rendering in fixed-size chunks.
+ *
+ * An OfflineAudioContext holds its whole output in memory, so a long piece is
+ * rendered as a series of short contexts instead. Native nodes cannot hand
+ * their internal state to a new context, so each chunk starts a pre-roll
+ * early and replays that span: delay lines and reverb tails fill up again and
+ * the pre-roll is thrown away. The pre-roll is the engine's -60 dB tail for
+ * the longest-ringing state in the score (EngineDefinition.tailSeconds),
+ * capped at MAX_PRE_ROLL_SECONDS; chunks grow with it so the replayed share
+ * stays at most half. What can be carried exactly is carried:
+ * held notes are restarted, the latest parameters reapplied, and sequencer and
+ * random-number state restored from a snapshot taken in the previous chunk at
+ * the moment this chunk's pre-roll begins. Consecutive chunks overlap by a few
+ * milliseconds and are crossfaded, which hides what remains (free-running
+ * oscillator and LFO phases inside the nodes).
+ *
+ * Memory use is one chunk plus its pre-roll, whatever the length of the piece.
+ * Worklet kernels (modulation drift, ghost partials, grains) draw on the audio
+ * thread, so their generators cannot be carried; each chunk reseeds them from
+ * the carried random-number state instead. Their sequences then differ from
+ * chunk to chunk without matching a single-pass render, and rendering the same
+ * piece twice still gives the same file.
+ */
+
+export type ScoreEvent =
+    | { time: number; type: 'state'; state: SynthState }
+    // With a lane, the voice follows that expression lane (written by 'control' events) and frequency is unused
+    | { time: number; type: 'noteOn'; note: number; frequency: number; velocity?: number; lane?: number }
+    | { time: number; type: 'noteOff'; note: number }
+    // Engine-specific action (step toggle, transport...). Not replayed into a later
+    // chunk's pre-roll: its lasting effect must be part of the engine's saveState()
+    | { time: number; type: 'control'; apply: (engine: ISynthEngine) => void };
+
+export interface RenderPiece {
+    /** Registered engine name */
+    engine: string;
+    /** Length in seconds */
+    duration: number;
+    /**
+     * Seeds every random draw the engine makes, so a render can be repeated.
+     * Performance draws follow the same sequence as a live engine after setSeed(seed).
+     */
+    seed: number;
+    /** Score, sorted by time (seconds). Notes are identified by `note`. */
+    events: ScoreEvent[];
+    /** Called once at time 0, after the events at time 0 (e.g. to start a sequencer) */
+    start?: (engine: ISynthEngine) => void;
+}
+
+export const RENDER_SAMPLE_RATE = 48000;
+
+const CHUNK_SECONDS = 20;
+// For engines without tailSeconds: longer than their reverb impulses (at most 6 s)
+const DEFAULT_PRE_ROLL_SECONDS = 8;
+// Criosfera's delay can ring for minutes (feedback 0.95, 2.6 s). Past this cap the
+// echoes still sounding at a seam (-10 dB at worst) drop out; the crossfade only
+// smooths the step
+const MAX_PRE_ROLL_SECONDS = 60;
+const SEAM_SECONDS = 0.05;
+// Sequencers are advanced at least this often
+const TICK_SECONDS = 0.05;
+// Suspensions happen on render quantum boundaries
+const QUANTUM = 128;
+// Engine construction (noise tables, impulses) uses a different sequence than the performance
+const CONSTRUCTION_SEED = 0x9e3779b9;
+
+export const RENDER_DIR = 'renders';
+
+interface Snapshot {
+    rng: number;
+    engine: unknown;
+}
+
+function toQuanta(seconds: number, sampleRate: number): number {
+    return Math.max(1, Math.round(seconds * sampleRate / QUANTUM)) * QUANTUM;
+}
+
+/**
+ * Long enough for the tail of every state the piece passes through to die away.
+ * Renders that must stay chunk-aligned (stems of one scene) share the longest.
+ */
+export function preRollSeconds(piece: RenderPiece): number {
+    const tail = engineRegistry.get(piece.engine)?.tailSeconds;
+    if (!tail) return DEFAULT_PRE_ROLL_SECONDS;
+    let longest = 0;
+    for (const event of piece.events) {
+        if (event.type === 'state') longest = Math.max(longest, tail(event.state));
+    }
+    return Math.min(MAX_PRE_ROLL_SECONDS, longest || DEFAULT_PRE_ROLL_SECONDS);
+}
+
+/**
+ * Renders one piece chunk by chunk; call next() until isDone()
+ */
+export class ChunkedRender {
+    readonly sampleRate: number;
+    readonly totalFrames: number;
+    private readonly piece: RenderPiece;
+    private readonly chunkFrames: number;
+    private readonly preRollFrames: number;
+    private readonly seamFrames: number;
+    private readonly tickFrames: number;
+
+    // Start of the next chunk, in frames
+    private position = 0;
+    private snapshot: Snapshot | null = null;
+    // Rendered beyond the previous chunk's end, to crossfade with the next one
+    private seamTail: Float32Array[] | null = null;
+
+    /**
+     * @param preRoll Seconds replayed before each chunk; also sets the chunk size,
+     * so renders given the same value produce chunks of the same length
+     */
+    constructor(piece: RenderPiece, sampleRate: number = RENDER_SAMPLE_RATE, preRoll: number = preRollSeconds(piece)) {
+        this.piece = piece;
+        this.sampleRate = sampleRate;
+        this.totalFrames = Math.round(piece.duration * sampleRate);
+        this.chunkFrames = toQuanta(Math.max(CHUNK_SECONDS, preRoll), sampleRate);
+        this.preRollFrames = toQuanta(preRoll, sampleRate);
+        this.seamFrames = toQuanta(SEAM_SECONDS, sampleRate);
+        this.tickFrames = toQuanta(TICK_SECONDS, sampleRate);
+    }
+
+    isDone(): boolean {
+        return this.position >= this.totalFrames;
+    }
+
+    /** Fraction rendered, 0..1 */
+    getProgress(): number {
+        return this.totalFrames > 0 ? Math.min(1, this.position / this.totalFrames) : 1;
+    }
+
+    /**
+     * Render the next chunk. Returns its frames (stereo, planar), ready to append.
+     */
+    async next(): Promise<Float32Array[]> {
+        const sr = this.sampleRate;
+        const t0 = this.position;
+        const t1 = Math.min(this.totalFrames, t0 + this.chunkFrames);
+        const last = t1 === this.totalFrames;
+        const start = Math.max(0, t0 - this.preRollFrames);
+        const end = last ? t1 : t1 + this.seamFrames;
+        // The next chunk's pre-roll begins here: snapshot the state it continues from
+        const snapshotFrame = last ? -1 : t1 - this.preRollFrames;
+        if (__TRACE__) tracer.begin('render', 'chunk');
+
+        const ctx = new OfflineAudioContext(2, end - start, sr);
+        await ensureWorklets(ctx);
+
+        // Same headroom and limiter as the live master bus
+        const bus = ctx.createGain();
+        bus.gain.value = 0.8;
+        const limiter = ctx.createDynamicsCompressor();
+        limiter.threshold.value = -3.0;
+        limiter.knee.value = 15;
+        limiter.ratio.value = 12;
+        limiter.attack.value = 0.005;
+        limiter.release.value = 0.2;
+        bus.connect(limiter);
+        limiter.connect(ctx.destination);
+
+        const engine = engineRegistry.createEngine(this.piece.engine);
+        if (!engine) throw new Error(`Unknown engine: ${this.piece.engine}`);
+        // Engines are typed for the live context; the offline one has every node
+        // they create except media streams, so live-input engines cannot render
+        const engineCtx = ctx as unknown as AudioContext;
+        // Same seed every chunk: noise tables and impulses come out identical
+        withRandom(new SeededRandom(this.piece.seed ^ CONSTRUCTION_SEED), () => engine.init(engineCtx, bus));
+        // Worklet-backed nodes are created once the (already loaded) module resolves
+        await new Promise(resolve => setTimeout(resolve, 0));
+
+        const rng = new SeededRandom(this.snapshot?.rng ?? this.piece.seed);
+        // Kernels keep their random state on the audio thread, where it cannot be
+        // snapshotted; seeding them from the carried sequence keeps chunks from
+        // repeating each other (and the first chunk matches a live setSeed(seed))
+        engine.seedAudioThread?.(rng.state);
+        const noteIds = new Map<number, number | undefined>();
+        const play = (event: ScoreEvent) => {
+            if (event.type === 'state') {
+                engine.updateParameters(event.state);
+            } else if (event.type === 'noteOn') {
+                noteIds.set(event.note, event.lane === undefined
+                    ? engine.playNote(event.frequency, event.velocity)
+                    : engine.playExpressive?.(event.lane, event.velocity));
+            } else if (event.type === 'control') {
+                event.apply(engine);
+            } else {
+                const id = noteIds.get(event.note);
+                if (id !== undefined) engine.stopNote(id);
+                noteIds.delete(event.note);
+            }
+        };
+
+        // Split the score: what happened before this context starts, and what it plays
+        const quantize = (time: number) => Math.floor(time * sr / QUANTUM) * QUANTUM;
+        let latestState: ScoreEvent | null = null;
+        const held = new Map<number, ScoreEvent>();
+        const due = new Map<number, ScoreEvent[]>();
+        for (const event of this.piece.events) {
+            const frame = quantize(event.time);
+            if (frame >= end) break;
+            if (frame >= start) {
+                const list = due.get(frame - start);
+                if (list) list.push(event);
+                else due.set(frame - start, [event]);
+            } else if (event.type === 'state') {
+                latestState = event;
+            } else if (event.type === 'noteOn') {
+                held.set(event.note, event);
+            } else if (event.type === 'noteOff') {
+                held.delete(event.note);
+            }
+        }
+
+        // Every point the renderer has to act on, in local frames
+        const points = new Set<number>(due.keys());
+        if (engine.advanceTo) {
+            for (let frame = this.tickFrames; frame < end - start; frame += this.tickFrames) points.add(frame);
+        }
+        if (snapshotFrame >= start) points.add(snapshotFrame - start);
+        const sorted = [...points].filter(frame => frame > 0 && frame < end - start).sort((a, b) => a - b);
+        const nextPoint = (frame: number) => {
+            const i = sorted.findIndex(point => point > frame);
+            return (i === -1 ? end - start : sorted[i]) / sr;
+        };
+
+        let snapshot: Snapshot | null = null;
+        const act = (frame: number) => {
+            if (frame === snapshotFrame - start) {
+                snapshot = { rng: rng.state, engine: engine.saveState?.() };
+            }
+            due.get(frame)?.forEach(play);
+            // Sequencers schedule exactly up to the next point, so a snapshot taken
+            // there has everything before it scheduled and nothing after
+            engine.advanceTo?.(nextPoint(frame));
+        };
+
+        // Local time 0
+        withRandom(rng, () => {
+            engine.advanceTo?.(0);
+            if (latestState) play(latestState);
+            if (this.snapshot) engine.restoreState?.(this.snapshot.engine);
+            held.forEach(play);
+            if (start === 0) {
+                due.get(0)?.forEach(play);
+                this.piece.start?.(engine);
+                due.delete(0);
+            }
+            act(0);
+        });
+
+        for (const frame of sorted) {
+            ctx.suspend(frame / sr).then(() => {
+                withRandom(rng, () => act(frame));
+                ctx.resume();
+            });
+        }
+
+        const buffer = await ctx.startRendering();
+        engine.reset?.();
+        engine.destroy?.();
+
+        // Keep [t0, t1), crossfading its start with the previous chunk's overlap
+        const skip = t0 - start;
+        const length = t1 - t0;
+        const out = [0, 1].map(ch => {
+            const data = new Float32Array(length);
+            buffer.copyFromChannel(data, ch, skip);
+            return data;
+        });
+        if (this.seamTail) {
+            const fade = Math.min(this.seamFrames, length);
+            for (let ch = 0; ch < 2; ch++) {
+                const tail = this.seamTail[ch];
+                const data = out[ch];
+                for (let i = 0; i < fade; i++) {
+                    const w = (i + 0.5) / fade;
+                    data[i] = tail[i] * (1 - w) + data[i] * w;
+                }
+            }
+        }
+        this.seamTail = last ? null : [0, 1].map(ch => {
+            const data = new Float32Array(this.seamFrames);
+            buffer.copyFromChannel(data, ch, skip + length);
+            return data;
+        });
+
+        this.snapshot = snapshot;
+        this.position = t1;
+        if (__TRACE__) tracer.end('render', 'chunk');
+        return out;
+    }
+}
+
+/**
+ * Render a piece into a WAV writer, one chunk at a time
+ */
+export async function renderToWav(
+    piece: RenderPiece,
+    writer: WavWriter,
+    sampleRate: number = RENDER_SAMPLE_RATE,
+    onProgress?: (fraction: number) => void
+): Promise<void> {
+    const render = new ChunkedRender(piece, sampleRate);
+    await writer.begin();
+    while (!render.isDone()) {
+        await writer.write(await render.next());
+        onProgress?.(render.getProgress());
+    }
+    await writer.finish();
+}
+
+/**
+ * Render a piece to a WAV file in the origin private file system (replacing
+ * any earlier file of that name). The returned File is disk-backed.
+ */
+export async function renderToFile(
+    piece: RenderPiece,
+    fileName: string,
+    sampleRate: number = RENDER_SAMPLE_RATE,
+    onProgress?: (fraction: number) => void
+): Promise<File> {
+    const root = await navigator.storage.getDirectory();
+    const dir = await root.getDirectoryHandle(RENDER_DIR, { create: true });
+    const handle = await dir.getFileHandle(fileName, { create: true });
+    await renderToWav(piece, new WavWriter(await handle.createWritable(), sampleRate), sampleRate, onProgress);
+    return handle.getFile();
+}
@@ -0,0 +1,36 @@
+import { ensureWorklets } from './worklets/workletLoader';
+import { timingTelemetry } from './TimingTelemetry';
+
+/**
+ * Taps a node and feeds detected output onsets into the timing telemetry,
+ * which matches them against the triggers the sequencers scheduled.
+ */
+export class OnsetProbe {
+    private node: AudioWorkletNode | null = null;
+    private disposed = false;
+
+    constructor(ctx: BaseAudioContext, source: AudioNode) {
+        ensureWorklets(ctx).then(() => {
+            if (this.disposed) return;
+            this.node = new AudioWorkletNode(ctx, 'onset-probe', {
+                numberOfInputs: 1,
+                numberOfOutputs: 0,
+                channelCount: 1,
+                channelCountMode: 'explicit'
+            });
+            this.node.port.onmessage = (e: MessageEvent) => {
+                if (e.data.type === 'onset') timingTelemetry.recordOnset(e.data.time);
+            };
+            source.connect(this.node);
+        }).catch((err) => console.error('[OnsetProbe] Worklet load failed:', err));
+    }
+
+    dispose(): void {
+        this.disposed = true;
+        if (this.node) {
+            this.node.port.onmessage = null;
+            this.node.disconnect();
+            this.node = null;
+        }
+    }
+}
@@ -0,0 +1,556 @@
+import { SynthState } from '../types';
+import type { ISynthEngine } from './BaseSynthEngine';
+import type { BreitemaEngine } from './engines/BreitemaEngine';
+import type { GearheartEngine } from './engines/GearheartEngine';
+import type { EchoVesselEngine } from './engines/EchoVesselEngine';
+import type { CriosferaEngine } from './engines/CriosferaEngine';
+import type { ScoreEvent } from './OfflineRenderer';
+import type { SceneScore } from './StemRenderer';
+
+/**
+ * Performance capture in a compact binary log.
+ *
+ * Everything the player does is recorded with its audio-clock time: notes,
+ * parameter changes, engine switches, step toggles, rhythm changes, transport,
+ * gear drags, motor and vial switches, touch-surface voices and their lanes.
+ * The header keeps the session seed, the seed and starting state (saveState)
+ * of every engine, and each engine's parameters are logged at the moment it
+ * joins, so replaying the log, live or offline (performanceToScene),
+ * reproduces the performance.
+ *
+ * Layout (little-endian):
+ *   header: 'FGPL' | u8 version | u32 sampleRate | u32 seed | u8 engineCount
+ *           per engine: u8 nameLength, name | u32 seed | u16 stateLength, state JSON
+ *   events: u8 op | u8 engine | varint frames since the previous event | payload
+ * A parameter change costs 8 bytes, a note 12, a step toggle 4, a lane move 16.
+ */
+
+const MAGIC = 'FGPL';
+const VERSION = 2;              // 2: touch-surface lanes
+
+const OP = {
+    PARAM: 1,           // u8 param, f32 value
+    NOTE_ON: 2,         // varint note, f32 frequency, f32 velocity (NaN: default)
+    NOTE_OFF: 3,        // varint note
+    ENGINE: 4,          // switch the active engine
+    STEP: 5,            // u8 step
+    RHYTHM: 6,          // u8 mode
+    RANDOMIZE: 7,       // new random pattern
+    TRANSPORT: 8,       // u8 running
+    GEAR_MOVE: 9,       // u8 gear, f32 x, f32 y
+    GEAR_RELEASE: 10,   // u8 gear
+    MOTOR: 11,          // toggle
+    VIAL: 12,           // u8 vial
+    LANE_ON: 13,        // varint note, u8 lane, f32 velocity (NaN: default); pitch comes from the lane
+    LANE: 14            // u8 lane, f32 frequency, f32 brightness, f32 pressure
+} as const;
+
+const PARAMS: (keyof SynthState)[] = ['pressure', 'resonance', 'viscosity', 'turbulence', 'diffusion'];
+const RHYTHM_MODES = ['libre', 'muineira', 'ribeirada'] as const;
+const VIALS = ['neutral', 'mercury', 'amber'] as const;
+
+export type RhythmMode = typeof RHYTHM_MODES[number];
+export type VialName = typeof VIALS[number];
+
+export type PerformanceEvent = { time: number; engine: string } & (
+    | { type: 'param'; param: keyof SynthState; value: number }
+    | { type: 'noteOn'; note: number; frequency: number; velocity?: number }
+    | { type: 'noteOff'; note: number }
+    | { type: 'laneOn'; note: number; lane: number; velocity?: number }
+    | { type: 'lane'; lane: number; frequency: number; brightness: number; pressure: number }
+    | { type: 'engine' }
+    | { type: 'step'; step: number }
+    | { type: 'rhythm'; mode: RhythmMode }
+    | { type: 'randomize' }
+    | { type: 'transport'; running: boolean }
+    | { type: 'gearMove'; gear: number; x: number; y: number }
+    | { type: 'gearRelease'; gear: number }
+    | { type: 'motor' }
+    | { type: 'vial'; vial: VialName }
+);
+
+export interface PerformanceEngine {
+    name: string;
+    seed: number;
+    /** saveState() at the start of the recording, if the engine existed then */
+    state: unknown;
+}
+
+export interface Performance {
+    sampleRate: number;
+    seed: number;
+    engines: PerformanceEngine[];
+    /** Sorted by time, in seconds from the start of the recording */
+    events: PerformanceEvent[];
+    duration: number;
+}
+
+/**
+ * Whether every parameter of a state built up from PARAM events is known
+ */
+export function isCompleteState(state: Partial<SynthState>): state is SynthState {
+    return PARAMS.every(param => state[param] !== undefined);
+}
+
+/**
+ * Seed of one engine within a session
+ */
+export function engineSeed(seed: number, name: string): number {
+    let h = seed ^ 0x811c9dc5;
+    for (let i = 0; i < name.length; i++) h = Math.imul(h ^ name.charCodeAt(i), 0x01000193);
+    return h >>> 0;
+}
+
+class ByteWriter {
+    private bytes = new Uint8Array(1024);
+    private view = new DataView(this.bytes.buffer);
+    length = 0;
+
+    u8(value: number): void {
+        this.reserve(1);
+        this.bytes[this.length++] = value;
+    }
+
+    u16(value: number): void {
+        this.reserve(2);
+        this.view.setUint16(this.length, value, true);
+        this.length += 2;
+    }
+
+    u32(value: number): void {
+        this.reserve(4);
+        this.view.setUint32(this.length, value >>> 0, true);
+        this.length += 4;
+    }
+
+    f32(value: number): void {
+        this.reserve(4);
+        this.view.setFloat32(this.length, value, true);
+        this.length += 4;
+    }
+
+    /** Unsigned LEB128 */
+    varint(value: number): void {
+        let v = Math.max(0, Math.floor(value));
+        while (v >= 0x80) {
+            this.u8((v % 0x80) | 0x80);
+            v = Math.floor(v / 0x80);
+        }
+        this.u8(v);
+    }
+
+    raw(data: Uint8Array): void {
+        this.reserve(data.length);
+        this.bytes.set(data, this.length);
+        this.length += data.length;
+    }
+
+    finish(): Uint8Array {
+        return this.bytes.slice(0, this.length);
+    }
+
+    private reserve(count: number): void {
+        if (this.length + count <= this.bytes.length) return;
+        const grown = new Uint8Array(Math.max(this.bytes.length * 2, this.length + count));
+        grown.set(this.bytes);
+        this.bytes = grown;
+        this.view = new DataView(grown.buffer);
+    }
+}
+
+class ByteReader {
+    private readonly view: DataView;
+    private offset = 0;
+
+    constructor(private readonly bytes: Uint8Array) {
+        this.view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+    }
+
+    get done(): boolean {
+        return this.offset >= this.bytes.length;
+    }
+
+    u8(): number {
+        return this.view.getUint8(this.offset++);
+    }
+
+    u16(): number {
+        const value = this.view.getUint16(this.offset, true);
+        this.offset += 2;
+        return value;
+    }
+
+    u32(): number {
+        const value = this.view.getUint32(this.offset, true);
+        this.offset += 4;
+        return value;
+    }
+
+    f32(): number {
+        const value = this.view.getFloat32(this.offset, true);
+        this.offset += 4;
+        return value;
+    }
+
+    varint(): number {
+        let value = 0;
+        let scale = 1;
+        for (;;) {
+            const byte = this.u8();
+            value += (byte & 0x7f) * scale;
+            if (byte < 0x80) return value;
+            scale *= 0x80;
+        }
+    }
+
+    text(length: number): string {
+        const value = new TextDecoder().decode(this.bytes.subarray(this.offset, this.offset + length));
+        this.offset += length;
+        return value;
+    }
+}
+
+/**
+ * Records the running performance. Call sites report what happened; nothing
+ * is stored unless a recording is running.
+ */
+class PerformanceRecorder {
+    private clock: BaseAudioContext | null = null;
+    private seed = 0;
+    private startFrame = 0;
+    private lastFrame = 0;
+    private body = new ByteWriter();
+    private engines: PerformanceEngine[] = [];
+    // Last state logged per engine, so only changed parameters are written
+    private states = new Map<string, SynthState>();
+    // Engine note ids (which may be any number) to compact log note numbers
+    private notes = new Map<string, number>();
+    private nextNote = 0;
+
+    isRecording(): boolean {
+        return this.clock !== null;
+    }
+
+    /**
+     * Start a recording
+     * @param engines - Live engines with their names and current parameters; each
+     *                  is seeded, its state kept and its parameters logged at frame 0
+     */
+    start(clock: BaseAudioContext, seed: number, engines: [string, ISynthEngine, SynthState | undefined][]): void {
+        this.clock = clock;
+        this.seed = seed >>> 0;
+        this.startFrame = Math.round(clock.currentTime * clock.sampleRate);
+        this.lastFrame = 0;
+        this.body = new ByteWriter();
+        this.engines = [];
+        this.states.clear();
+        this.notes.clear();
+        this.nextNote = 0;
+        engines.forEach(([name, engine, state]) => this.addEngine(name, engine, state));
+    }
+
+    /** Stop and return the encoded log */
+    stop(): Uint8Array | null {
+        if (!this.clock) return null;
+        const header = new ByteWriter();
+        for (let i = 0; i < 4; i++) header.u8(MAGIC.charCodeAt(i));
+        header.u8(VERSION);
+        header.u32(this.clock.sampleRate);
+        header.u32(this.seed);
+        header.u8(this.engines.length);
+        const encoder = new TextEncoder();
+        for (const engine of this.engines) {
+            const name = encoder.encode(engine.name);
+            header.u8(name.length);
+            header.raw(name);
+            header.u32(engine.seed);
+            const state = encoder.encode(engine.state === undefined ? '' : JSON.stringify(engine.state));
+            header.u16(state.length);
+            header.raw(state);
+        }
+        header.raw(this.body.finish());
+        this.clock = null;
+        return header.finish();
+    }
+
+    /** Size of the log so far, in bytes */
+    getByteLength(): number {
+        return this.clock ? this.body.length : 0;
+    }
+
+    /**
+     * Seed an engine created during the recording (engines present at start
+     * are seeded by start())
+     * @param state - Its parameters, logged in full so replay starts from them
+     */
+    addEngine(name: string, engine: ISynthEngine, state?: SynthState): void {
+        if (!this.clock || this.engines.some(entry => entry.name === name)) return;
+        const seed = engineSeed(this.seed, name);
+        engine.setSeed?.(seed);
+        this.engines.push({ name, seed, state: engine.saveState?.() });
+        if (state) this.state(name, state);
+    }
+
+    state(engine: string, state: SynthState): void {
+        if (!this.clock) return;
+        const last = this.states.get(engine);
+        PARAMS.forEach((param, i) => {
+            if (last && last[param] === state[param]) return;
+            this.event(OP.PARAM, engine);
+            this.body.u8(i);
+            this.body.f32(state[param]);
+        });
+        this.states.set(engine, { ...state });
+    }
+
+    noteOn(engine: string, id: number | undefined, frequency: number, velocity: number | undefined): void {
+        if (!this.clock || id === undefined) return;
+        const note = this.nextNote++;
+        this.notes.set(`${engine}:${id}`, note);
+        this.event(OP.NOTE_ON, engine);
+        this.body.varint(note);
+        this.body.f32(frequency);
+        // NaN: the engine's default velocity
+        this.body.f32(velocity ?? NaN);
+    }
+
+    noteOff(engine: string, id: number): void {
+        const note = this.notes.get(`${engine}:${id}`);
+        if (!this.clock || note === undefined) return;
+        this.notes.delete(`${engine}:${id}`);
+        this.event(OP.NOTE_OFF, engine);
+        this.body.varint(note);
+    }
+
+    /** A voice bound to an expression lane (touch surface) */
+    laneOn(engine: string, id: number | undefined, lane: number, velocity: number | undefined): void {
+        if (!this.clock || id === undefined) return;
+        const note = this.nextNote++;
+        this.notes.set(`${engine}:${id}`, note);
+        this.event(OP.LANE_ON, engine);
+        this.body.varint(note);
+        this.body.u8(lane);
+        this.body.f32(velocity ?? NaN);
+    }
+
+    lane(engine: string, lane: number, frequency: number, brightness: number, pressure: number): void {
+        if (!this.clock) return;
+        this.event(OP.LANE, engine);
+        this.body.u8(lane);
+        this.body.f32(frequency);
+        this.body.f32(brightness);
+        this.body.f32(pressure);
+    }
+
+    engine(engine: string): void {
+        if (this.clock) this.event(OP.ENGINE, engine);
+    }
+
+    step(engine: string, step: number): void {
+        if (!this.clock) return;
+        this.event(OP.STEP, engine);
+        this.body.u8(step);
+    }
+
+    rhythm(engine: string, mode: RhythmMode): void {
+        if (!this.clock) return;
+        this.event(OP.RHYTHM, engine);
+        this.body.u8(Math.max(0, RHYTHM_MODES.indexOf(mode)));
+    }
+
+    randomize(engine: string): void {
+        if (this.clock) this.event(OP.RANDOMIZE, engine);
+    }
+
+    transport(engine: string, running: boolean): void {
+        if (!this.clock) return;
+        this.event(OP.TRANSPORT, engine);
+        this.body.u8(running ? 1 : 0);
+    }
+
+    gearMove(engine: string, gear: number, x: number, y: number): void {
+        if (!this.clock) return;
+        this.event(OP.GEAR_MOVE, engine);
+        this.body.u8(gear);
+        this.body.f32(x);
+        this.body.f32(y);
+    }
+
+    gearRelease(engine: string, gear: number): void {
+        if (!this.clock) return;
+        this.event(OP.GEAR_RELEASE, engine);
+        this.body.u8(gear);
+    }
+
+    motor(engine: string): void {
+        if (this.clock) this.event(OP.MOTOR, engine);
+    }
+
+    vial(engine: string, vial: VialName): void {
+        if (!this.clock) return;
+        this.event(OP.VIAL, engine);
+        this.body.u8(Math.max(0, VIALS.indexOf(vial)));
+    }
+
+    private event(op: number, engine: string): void {
+        const clock = this.clock!;
+        let index = this.engines.findIndex(entry => entry.name === engine);
+        if (index === -1) {
+            // Not created through SynthManager while recording: log it unseeded
+            this.engines.push({ name: engine, seed: engineSeed(this.seed, engine), state: undefined });
+            index = this.engines.length - 1;
+        }
+        const frame = Math.max(this.lastFrame, Math.round(clock.currentTime * clock.sampleRate) - this.startFrame);
+        this.body.u8(op);
+        this.body.u8(index);
+        this.body.varint(frame - this.lastFrame);
+        this.lastFrame = frame;
+    }
+}
+
+export const performanceLog = new PerformanceRecorder();
+
+/**
+ * Decode a log written by the recorder
+ */
+export function decodePerformance(bytes: Uint8Array): Performance {
+    const reader = new ByteReader(bytes);
+    if (reader.text(4) !== MAGIC) throw new Error('Not a performance log');
+    const version = reader.u8();
+    if (version < 1 || version > VERSION) throw new Error(`Unsupported performance log version ${version}`);
+
+    const sampleRate = reader.u32();
+    const seed = reader.u32();
+    const engines: PerformanceEngine[] = [];
+    const count = reader.u8();
+    for (let i = 0; i < count; i++) {
+        const name = reader.text(reader.u8());
+        const engineSeedValue = reader.u32();
+        const state = reader.text(reader.u16());
+        engines.push({ name, seed: engineSeedValue, state: state ? JSON.parse(state) : undefined });
+    }
+
+    const events: PerformanceEvent[] = [];
+    let frame = 0;
+    while (!reader.done) {
+        const op = reader.u8();
+        const engine = engines[reader.u8()]?.name ?? '';
+        frame += reader.varint();
+        const time = frame / sampleRate;
+        switch (op) {
+            case OP.PARAM: events.push({ time, engine, type: 'param', param: PARAMS[reader.u8()], value: reader.f32() }); break;
+            case OP.NOTE_ON: {
+                const note = reader.varint();
+                const frequency = reader.f32();
+                const velocity = reader.f32();
+                events.push({ time, engine, type: 'noteOn', note, frequency, velocity: Number.isNaN(velocity) ? undefined : velocity });
+                break;
+            }
+            case OP.NOTE_OFF: events.push({ time, engine, type: 'noteOff', note: reader.varint() }); break;
+            case OP.LANE_ON: {
+                const note = reader.varint();
+                const lane = reader.u8();
+                const velocity = reader.f32();
+                events.push({ time, engine, type: 'laneOn', note, lane, velocity: Number.isNaN(velocity) ? undefined : velocity });
+                break;
+            }
+            case OP.LANE: events.push({ time, engine, type: 'lane', lane: reader.u8(), frequency: reader.f32(), brightness: reader.f32(), pressure: reader.f32() }); break;
+            case OP.ENGINE: events.push({ time, engine, type: 'engine' }); break;
+            case OP.STEP: events.push({ time, engine, type: 'step', step: reader.u8() }); break;
+            case OP.RHYTHM: events.push({ time, engine, type: 'rhythm', mode: RHYTHM_MODES[reader.u8()] ?? 'libre' }); break;
+            case OP.RANDOMIZE: events.push({ time, engine, type: 'randomize' }); break;
+            case OP.TRANSPORT: events.push({ time, engine, type: 'transport', running: reader.u8() === 1 }); break;
+            case OP.GEAR_MOVE: events.push({ time, engine, type: 'gearMove', gear: reader.u8(), x: reader.f32(), y: reader.f32() }); break;
+            case OP.GEAR_RELEASE: events.push({ time, engine, type: 'gearRelease', gear: reader.u8() }); break;
+            case OP.MOTOR: events.push({ time, engine, type: 'motor' }); break;
+            case OP.VIAL: events.push({ time, engine, type: 'vial', vial: VIALS[reader.u8()] ?? 'neutral' }); break;
+            default: throw new Error(`Unknown performance op ${op}`);
+        }
+    }
+
+    return { sampleRate, seed, engines, events, duration: frame / sampleRate };
+}
+
+/**
+ * Apply one engine-specific control event (everything but parameters, notes
+ * and engine switches) to an engine
+ */
+export function applyControl(engine: ISynthEngine, event: PerformanceEvent): void {
+    switch (event.type) {
+        case 'step': (engine as BreitemaEngine).toggleStep(event.step); break;
+        case 'rhythm': (engine as BreitemaEngine).setRhythmMode(event.mode); break;
+        case 'randomize': (engine as BreitemaEngine).generateRandomPattern(); break;
+        case 'transport':
+            if (event.running) (engine as BreitemaEngine).startSequencer();
+            else (engine as BreitemaEngine).stopSequencer();
+            break;
+        case 'gearMove': (engine as GearheartEngine).updateGearPosition(event.gear, event.x, event.y); break;
+        case 'gearRelease': (engine as GearheartEngine).endDrag(event.gear); break;
+        case 'motor': (engine as GearheartEngine).toggleMotor(); break;
+        case 'vial': (engine as EchoVesselEngine).setVial(event.vial); break;
+        case 'lane': {
+            const expression = (engine as CriosferaEngine).getExpression();
+            expression?.set(event.lane, event.frequency, event.brightness, event.pressure);
+            // Replays and renders step on the audio clock, not on animation frames
+            expression?.flush();
+            break;
+        }
+    }
+}
+
+/**
+ * Engine type of a logged engine name: extra instances are logged by their
+ * handle ('criosfera#2'), primary ones by the type itself
+ */
+export function engineTypeOf(name: string): string {
+    return name.split('#')[0];
+}
+
+/**
+ * Turn a performance into a scene for the stem renderer: one stem per engine
+ * instance that played, each with its recorded seed and starting state
+ * @param engines - Engine types to include (e.g. those that can render offline)
+ * @param tail - Seconds rendered after the last event, for release and reverb tails
+ */
+export function performanceToScene(performance: Performance, engines: string[], tail: number = 8): SceneScore {
+    const included = performance.engines.filter(engine =>
+        engines.includes(engineTypeOf(engine.name)) && performance.events.some(event => event.engine === engine.name));
+
+    const events: SceneScore['events'] = [];
+    const states = new Map<string, Partial<SynthState>>();
+    for (const event of performance.events) {
+        if (!included.some(engine => engine.name === event.engine)) continue;
+        const base = { time: event.time, stem: event.engine };
+        let score: ScoreEvent | null = null;
+
+        if (event.type === 'param') {
+            // The engine needs a whole state: wait until every parameter has been seen
+            const state = { ...states.get(event.engine), [event.param]: event.value };
+            states.set(event.engine, state);
+            if (isCompleteState(state)) {
+                score = { time: event.time, type: 'state', state };
+            }
+        } else if (event.type === 'noteOn') {
+            score = { time: event.time, type: 'noteOn', note: event.note, frequency: event.frequency, velocity: event.velocity };
+        } else if (event.type === 'laneOn') {
+            score = { time: event.time, type: 'noteOn', note: event.note, frequency: 0, velocity: event.velocity, lane: event.lane };
+        } else if (event.type === 'noteOff') {
+            score = { time: event.time, type: 'noteOff', note: event.note };
+        } else if (event.type !== 'engine') {
+            score = { time: event.time, type: 'control', apply: (engine) => applyControl(engine, event) };
+        }
+        if (score) events.push({ ...score, ...base });
+    }
+
+    return {
+        duration: performance.duration + tail,
+        seed: performance.seed,
+        stems: included.map(engine => ({
+            name: engine.name,
+            engine: engineTypeOf(engine.name),
+            seed: engine.seed,
+            start: engine.state === undefined ? undefined : (instance) => instance.restoreState?.(engine.state)
+        })),
+        events
+    };
+}
@@ -0,0 +1,105 @@
+import { ensureWorklets } from './worklets/workletLoader';
+import { DEFAULT_PITCH_HZ } from './dsp/PitchTracker';
+import type { PitchEstimate } from './dsp/PitchTracker';
+
+export type { PitchEstimate };
+
+/**
+ * Real-time pitch tracker for a monophonic source, usually the microphone
+ * (see dsp/PitchTracker). The pitch reaches followers as an audio-rate signal
+ * in Hz on `frequency`: connectFrequency() adds `ratio × pitch` to an
+ * AudioParam, so a follower whose own value is 0 sits exactly on the tracked
+ * pitch (or a harmonic of it). getPitch() reads the latest estimate for
+ * display; it is shared memory when the page is cross-origin isolated, a
+ * 30 ms post otherwise. `input` and `frequency` exist synchronously; nothing
+ * here is routed to the speakers.
+ */
+export class PitchTracker {
+    public readonly input: GainNode;
+    /** Tracked pitch in Hz, as a signal (silent until the worklet loads) */
+    public readonly frequency: GainNode;
+    /** Confidence 0..1, as a signal (e.g. to gate a follower) */
+    public readonly confidence: GainNode;
+
+    private readonly ctx: BaseAudioContext;
+    private node: AudioWorkletNode | null = null;
+    private readonly slot: Float32Array;
+    private readonly shared: boolean;
+    // Per-param ratio gains fed from `frequency`
+    private readonly followers = new Map<AudioParam, GainNode>();
+
+    constructor(ctx: BaseAudioContext) {
+        this.ctx = ctx;
+        this.input = ctx.createGain();
+        this.frequency = ctx.createGain();
+        this.confidence = ctx.createGain();
+
+        const bytes = 2 * Float32Array.BYTES_PER_ELEMENT;
+        this.shared = typeof SharedArrayBuffer !== 'undefined' && globalThis.crossOriginIsolated === true;
+        this.slot = new Float32Array(this.shared ? new SharedArrayBuffer(bytes) : new ArrayBuffer(bytes));
+        this.slot[0] = DEFAULT_PITCH_HZ;
+
+        ensureWorklets(ctx).then(() => {
+            this.node = new AudioWorkletNode(ctx, 'pitch-tracker', {
+                numberOfInputs: 1,
+                numberOfOutputs: 2,
+                outputChannelCount: [1, 1],
+                channelCount: 1,
+                channelCountMode: 'explicit'
+            });
+            if (this.shared) {
+                this.node.port.postMessage({ type: 'slot', buffer: this.slot.buffer });
+            } else {
+                this.node.port.onmessage = (e: MessageEvent) => {
+                    if (e.data.type !== 'pitch') return;
+                    this.slot[0] = e.data.frequency;
+                    this.slot[1] = e.data.confidence;
+                };
+            }
+            this.input.connect(this.node);
+            this.node.connect(this.frequency, 0);
+            this.node.connect(this.confidence, 1);
+        }).catch((err) => console.error('[PitchTracker] Worklet load failed:', err));
+    }
+
+    /**
+     * Add `ratio × pitch` (Hz) to a param. Calling again for the same param changes its ratio.
+     */
+    connectFrequency(param: AudioParam, ratio: number = 1): void {
+        const existing = this.followers.get(param);
+        if (existing) {
+            existing.gain.setTargetAtTime(ratio, this.ctx.currentTime, 0.01);
+            return;
+        }
+        const scale = this.ctx.createGain();
+        scale.gain.value = ratio;
+        this.frequency.connect(scale);
+        scale.connect(param);
+        this.followers.set(param, scale);
+    }
+
+    disconnectFrequency(param: AudioParam): void {
+        const scale = this.followers.get(param);
+        if (!scale) return;
+        scale.disconnect();
+        this.followers.delete(param);
+    }
+
+    /**
+     * Latest estimate. The frequency holds its last voiced value; confidence is 0 when unvoiced.
+     */
+    getPitch(): PitchEstimate {
+        return { frequency: this.slot[0], confidence: this.slot[1] };
+    }
+
+    dispose(): void {
+        this.followers.forEach(scale => scale.disconnect());
+        this.followers.clear();
+        this.input.disconnect();
+        this.frequency.disconnect();
+        this.confidence.disconnect();
+        this.node?.disconnect();
+        this.node?.port.close();
+        this.node = null;
+    }
+}
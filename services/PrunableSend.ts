@@ -0,0 +1,96 @@
+import { tracer } from './Tracer';
+
+// A send level below this (-80 dB) counts as off
+const OFF_LEVEL = 1e-4;
+// setTargetAtTime is within 1% of its target after this many time constants
+const SETTLE_TIME_CONSTANTS = 5;
+
+/**
+ * An effect send that takes its branch out of the graph while it is silent.
+ *
+ * A muted send still feeds its effect (a ConvolverNode behind a zero gain keeps
+ * convolving), so the renderer pays for a branch nobody hears. Level changes go
+ * through here instead of straight to the AudioParam: once the level has
+ * settled at zero and the effect's tail has rung out, the `from → to` edge is
+ * disconnected and the effect stops rendering; the edge is restored before the
+ * next non-zero ramp starts.
+ */
+export class PrunableSend {
+    private readonly ctx: BaseAudioContext;
+    private readonly from: AudioNode;
+    private readonly to: AudioNode;
+    private readonly level: AudioParam;
+    private readonly tailSeconds: number;
+    private connected = false;
+    private pruneTimer: number | null = null;
+
+    /**
+     * @param from - Node that feeds the effect
+     * @param to - Effect input; only the from → to edge is touched
+     * @param level - Gain that sets how much of the effect is heard
+     * @param tailSeconds - How long the effect keeps sounding after its input stops
+     */
+    constructor(ctx: BaseAudioContext, from: AudioNode, to: AudioNode, level: AudioParam, tailSeconds: number) {
+        this.ctx = ctx;
+        this.from = from;
+        this.to = to;
+        this.level = level;
+        this.tailSeconds = tailSeconds;
+        // Nothing has gone through a send that starts silent, so it can start pruned
+        if (level.value >= OFF_LEVEL) this.connect();
+    }
+
+    /**
+     * Glide the send level (setTargetAtTime semantics)
+     */
+    setTargetAtTime(value: number, startTime: number, timeConstant: number): void {
+        if (Math.abs(value) >= OFF_LEVEL) {
+            this.cancelPrune();
+            this.connect();
+            this.level.setTargetAtTime(value, startTime, timeConstant);
+            return;
+        }
+
+        this.level.setTargetAtTime(0, startTime, timeConstant);
+        // Already pruned or about to be: the earlier fade is still the one that counts
+        if (!this.connected || this.pruneTimer !== null) return;
+
+        const silentIn = Math.max(0, startTime - this.ctx.currentTime) + SETTLE_TIME_CONSTANTS * timeConstant + this.tailSeconds;
+        this.pruneTimer = window.setTimeout(() => {
+            this.pruneTimer = null;
+            this.disconnect();
+        }, silentIn * 1000);
+    }
+
+    isPruned(): boolean {
+        return !this.connected;
+    }
+
+    /**
+     * Stop managing the edge, leaving it connected if it currently is
+     */
+    dispose(): void {
+        this.cancelPrune();
+    }
+
+    private connect(): void {
+        if (this.connected) return;
+        this.from.connect(this.to);
+        this.connected = true;
+        if (__TRACE__) tracer.instant('graph', 'sendRestored', this.tailSeconds);
+    }
+
+    private disconnect(): void {
+        if (!this.connected) return;
+        this.from.disconnect(this.to);
+        this.connected = false;
+        if (__TRACE__) tracer.instant('graph', 'sendPruned', this.tailSeconds);
+    }
+
+    private cancelPrune(): void {
+        if (this.pruneTimer !== null) {
+            window.clearTimeout(this.pruneTimer);
+            this.pruneTimer = null;
+        }
+    }
+}
@@ -0,0 +1,36 @@
+import { ensureWorklets } from './worklets/workletLoader';
+import { watchdog } from './Watchdog';
+
+/**
+ * Reports render-thread gaps (likely output underruns) to the watchdog.
+ * Hangs off a node only so the audio thread keeps processing it.
+ */
+export class RenderWatch {
+    private node: AudioWorkletNode | null = null;
+    private disposed = false;
+
+    constructor(ctx: BaseAudioContext, source: AudioNode) {
+        ensureWorklets(ctx).then(() => {
+            if (this.disposed) return;
+            this.node = new AudioWorkletNode(ctx, 'render-watch', {
+                numberOfInputs: 1,
+                numberOfOutputs: 0,
+                channelCount: 1,
+                channelCountMode: 'explicit'
+            });
+            this.node.port.onmessage = (e: MessageEvent) => {
+                if (e.data.type === 'gap') watchdog.recordUnderrun(e.data.gapMs);
+            };
+            source.connect(this.node);
+        }).catch((err) => console.error('[RenderWatch] Worklet load failed:', err));
+    }
+
+    dispose(): void {
+        this.disposed = true;
+        if (this.node) {
+            this.node.port.onmessage = null;
+            this.node.disconnect();
+            this.node = null;
+        }
+    }
+}
@@ -0,0 +1,46 @@
+/**
+ * Seeded pseudo-random numbers (mulberry32), for renders and replays that must
+ * come out the same every time.
+ *
+ * Engines draw through AbstractSynthEngine.random(): from their own generator
+ * once setSeed() has been called (performance log replays), otherwise from
+ * Math.random. Offline renders leave engines unseeded and lend a generator to
+ * Math.random for the duration of a synchronous call with withRandom();
+ * JavaScript runs one call at a time, so the live engines never see it.
+ * Worklet kernels (modulation, additive bank, grains) run their own xorshift
+ * generators on the audio thread, seeded by message through the engine's
+ * onSeed() (setSeed, or seedAudioThread for each render chunk).
+ */
+export class SeededRandom {
+    private s: number;
+
+    constructor(seed: number) {
+        this.s = seed >>> 0;
+    }
+
+    /** Uniform in [0, 1), like Math.random */
+    next(): number {
+        let t = (this.s = (this.s + 0x6d2b79f5) >>> 0);
+        t = Math.imul(t ^ (t >>> 15), t | 1);
+        t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+        return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+    }
+
+    /** Current position in the sequence; a generator built from it continues from here */
+    get state(): number {
+        return this.s;
+    }
+}
+
+/**
+ * Run `fn` with Math.random drawing from `rng`
+ */
+export function withRandom<T>(rng: SeededRandom, fn: () => T): T {
+    const native = Math.random;
+    Math.random = () => rng.next();
+    try {
+        return fn();
+    } finally {
+        Math.random = native;
+    }
+}
@@ -0,0 +1,28 @@
+/**
+ * Per-context cache of immutable audio resources (impulse responses, noise
+ * tables, ...). Engine instances on the same context get the same object, so a
+ * second instance of an engine costs its voices, not another copy of its buffers.
+ * Worklet modules are shared the same way by workletLoader.
+ */
+
+const caches = new WeakMap<BaseAudioContext, Map<string, unknown>>();
+
+/**
+ * Return the resource stored under `key` for this context, creating it on first use.
+ * Callers must treat the result as read-only.
+ * @param ctx - Context the resource belongs to
+ * @param key - Identifies the resource and every parameter it was built from
+ * @param create - Builds the resource when it is not cached yet
+ */
+export function getSharedResource<T>(ctx: BaseAudioContext, key: string, create: () => T): T {
+    let cache = caches.get(ctx);
+    if (!cache) {
+        cache = new Map();
+        caches.set(ctx, cache);
+    }
+
+    if (!cache.has(key)) {
+        cache.set(key, create());
+    }
+    return cache.get(key) as T;
+}
@@ -0,0 +1,173 @@
+import { ISynthEngine } from './BaseSynthEngine';
+import { ChunkedRender, RenderPiece, ScoreEvent, RENDER_DIR, RENDER_SAMPLE_RATE, preRollSeconds } from './OfflineRenderer';
+import { tracer } from './Tracer';
+import WavFileWorker from './wavFile.worker?worker';
+
+/**
+ * Multi-stem offline rendering of a scene.
+ *
+ * Every engine of the scene is a stem with its own ChunkedRender, fed from one
+ * shared event log. Stems advance chunk by chunk together: the chunk of every
+ * stem renders concurrently (each OfflineAudioContext renders on its own audio
+ * thread; all stems share the longest pre-roll, so their chunks line up), then each stem is handed to its own worker, which converts and
+ * writes its WAV file, while the main thread sums the mixdown. Writes overlap
+ * the next chunk's rendering, so memory is at most two chunks per stem.
+ */
+
+export interface SceneStem {
+    /** File and event-log name of the stem */
+    name: string;
+    /** Registered engine name */
+    engine: string;
+    /** Called once at time 0 (e.g. to start a sequencer) */
+    start?: (engine: ISynthEngine) => void;
+    /** Engine seed; derived from the scene seed when absent */
+    seed?: number;
+}
+
+export interface SceneScore {
+    duration: number;
+    seed: number;
+    stems: SceneStem[];
+    /** Shared log, sorted by time; each event names the stem it plays on */
+    events: (ScoreEvent & { stem: string })[];
+}
+
+export interface StemFiles {
+    stems: File[];
+    mix: File;
+}
+
+export const MIX_NAME = 'mix';
+
+/**
+ * One WAV file written by a worker. Calls are serialised and each waits for the
+ * worker, so no more than one chunk per file is ever in flight.
+ */
+class WavFileTask {
+    private readonly worker = new WavFileWorker();
+    private pending: { resolve: () => void; reject: (err: Error) => void } | null = null;
+
+    constructor() {
+        this.worker.onmessage = (e: MessageEvent) => {
+            const pending = this.pending;
+            this.pending = null;
+            if (e.data.type === 'ok') pending?.resolve();
+            else pending?.reject(new Error(e.data.message));
+        };
+    }
+
+    open(dir: string, name: string, sampleRate: number): Promise<void> {
+        return this.send({ type: 'open', dir, name, sampleRate });
+    }
+
+    /** Frames are transferred: the caller must not use them afterwards */
+    write(frames: Float32Array[]): Promise<void> {
+        return this.send({ type: 'write', frames }, frames.map(channel => channel.buffer));
+    }
+
+    async finish(): Promise<void> {
+        await this.send({ type: 'finish' });
+        this.worker.terminate();
+    }
+
+    abort(): void {
+        this.worker.terminate();
+        this.pending?.reject(new Error('Aborted'));
+        this.pending = null;
+    }
+
+    private send(message: unknown, transfer: Transferable[] = []): Promise<void> {
+        return new Promise((resolve, reject) => {
+            this.pending = { resolve, reject };
+            this.worker.postMessage(message, transfer);
+        });
+    }
+}
+
+/**
+ * Run tasks with at most `lanes` in flight; results keep the task order
+ */
+async function runPooled<T>(tasks: (() => Promise<T>)[], lanes: number): Promise<T[]> {
+    const results: T[] = new Array(tasks.length);
+    let next = 0;
+    const lane = async () => {
+        while (next < tasks.length) {
+            const i = next++;
+            results[i] = await tasks[i]();
+        }
+    };
+    await Promise.all(Array.from({ length: Math.min(lanes, tasks.length) }, lane));
+    return results;
+}
+
+/**
+ * Render every stem of a scene, and their sum, to WAV files under
+ * renders/<folder>/ in the origin private file system.
+ */
+export async function renderStems(
+    scene: SceneScore,
+    folder: string,
+    sampleRate: number = RENDER_SAMPLE_RATE,
+    onProgress?: (fraction: number) => void
+): Promise<StemFiles> {
+    const pieces: RenderPiece[] = scene.stems.map((stem, i) => ({
+        engine: stem.engine,
+        duration: scene.duration,
+        // Distinct per stem, so two stems of one engine do not play in unison
+        seed: stem.seed ?? (scene.seed + i * 0x632be5ab) >>> 0,
+        events: scene.events.filter(event => event.stem === stem.name),
+        start: stem.start
+    }));
+    // Chunk size follows the pre-roll: one value for all keeps every stem's chunks aligned
+    const preRoll = Math.max(0, ...pieces.map(preRollSeconds));
+    const renders = pieces.map(piece => new ChunkedRender(piece, sampleRate, preRoll));
+
+    // Leave a core for the UI; the render threads themselves are the browser's
+    const lanes = Math.max(1, (navigator.hardwareConcurrency || 2) - 1);
+    // Equal-power sum: uncorrelated stems keep their loudness in the mix
+    const mixGain = 1 / Math.sqrt(Math.max(1, scene.stems.length));
+
+    const dir = `${RENDER_DIR}/${folder}`;
+    const files = [...scene.stems.map(stem => stem.name), MIX_NAME].map(name => `${name}.wav`);
+    const tasks = files.map(() => new WavFileTask());
+    const stemTasks = tasks.slice(0, -1);
+    const mixTask = tasks[tasks.length - 1];
+
+    try {
+        await Promise.all(tasks.map((task, i) => task.open(dir, files[i], sampleRate)));
+
+        let writes: Promise<void>[] = [];
+        while (renders.some(render => !render.isDone())) {
+            if (__TRACE__) tracer.begin('render', 'stems');
+            const chunks = await runPooled(renders.map(render => () => render.next()), lanes);
+            if (__TRACE__) tracer.end('render', 'stems');
+
+            // Chunks are equal by construction; sum defensively all the same
+            const length = Math.max(...chunks.map(chunk => chunk[0].length));
+            const mix = [new Float32Array(length), new Float32Array(length)];
+            for (const chunk of chunks) {
+                for (let ch = 0; ch < 2; ch++) {
+                    const source = chunk[ch];
+                    const target = mix[ch];
+                    for (let i = 0; i < source.length; i++) target[i] += source[i] * mixGain;
+                }
+            }
+
+            // The previous chunk's writes overlap this chunk's rendering
+            await Promise.all(writes);
+            writes = [...chunks.map((chunk, i) => stemTasks[i].write(chunk)), mixTask.write(mix)];
+            onProgress?.(Math.min(...renders.map(render => render.getProgress())));
+        }
+        await Promise.all(writes);
+        await Promise.all(tasks.map(task => task.finish()));
+    } catch (err) {
+        tasks.forEach(task => task.abort());
+        throw err;
+    }
+
+    let handle = await navigator.storage.getDirectory();
+    for (const part of dir.split('/')) handle = await handle.getDirectoryHandle(part);
+    const outputs = await Promise.all(files.map(async name => (await handle.getFileHandle(name)).getFile()));
+    return { stems: outputs.slice(0, -1), mix: outputs[outputs.length - 1] };
+}
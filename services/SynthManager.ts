@@ -1,34 +1,89 @@
 import { ISynthEngine } from './BaseSynthEngine';
 import { SynthState } from '../types';
 import { engineRegistry } from './EngineRegistry';
+import { tracer } from './Tracer';
+import { OnsetProbe } from './OnsetProbe';
+import { RenderWatch } from './RenderWatch';
+import { LoudnessMeter, LoudnessReading } from './LoudnessMeter';
+import { PitchTracker } from './PitchTracker';
+import { ensureWorklets } from './worklets/workletLoader';
+import { performanceLog, Performance, applyControl, isCompleteState } from './PerformanceLog';
+import { CriosferaEngine } from './engines/CriosferaEngine';
 import { GearheartEngine } from './engines/GearheartEngine';
 import { EchoVesselEngine } from './engines/EchoVesselEngine';
 import { VocoderEngine } from './engines/VocoderEngine';
+import { GranularEngine } from './engines/GranularEngine';
+import { SamplerEngine } from './engines/SamplerEngine';
+import { BreitemaEngine } from './engines/BreitemaEngine';
 
 // Import engine registrations to ensure they're registered
 import './engines';
 
+// Loudness normalisation: each engine feeds its own trim gain, which is slowly
+// steered so the engine's short-term loudness sits near the target
+const TARGET_LUFS = -20;
+const LOUDNESS_GATE_LUFS = -50;     // Quieter than this counts as silence: hold the trim
+const STEADY_TOLERANCE_DB = 6;      // Momentary this far from short-term: attack or tail, hold
+const MAX_TRIM_DB = 12;
+const TRIM_ADJUST_RATE = 0.05;      // Fraction of the error corrected per 100 ms reading
+const TRIM_TIME_CONSTANT = 0.5;
+const METER_SLOTS = 9;              // Slot 0 is the master bus, then one per engine
+
+// Engine types that survive a context swap in place (see restoreAudioVolume)
+const REINIT_IN_PLACE = new Set(['gearheart', 'echo-vessel']);
+
+/** One engine's part of an oracle scene */
+export interface SceneSlice {
+  name: string;
+  state: SynthState;
+  /** Engine-specific extras (gear layout, step pattern...) */
+  apply?: (engine: ISynthEngine) => void;
+}
+
 class SynthManager {
   private activeEngineName: string = 'criosfera';
+  // Keyed by instance handle. The primary instance of each engine uses the engine
+  // name as its handle; extra instances (createInstance) are "<name>#<n>"
   private engines: Map<string, ISynthEngine> = new Map();
+  private instanceTypes: Map<string, string> = new Map();
+  private instanceCounters: Map<string, number> = new Map();
   private ctx: AudioContext | null = null;
+  // Resolves once the bundled worklet module is loaded on the current context
+  private workletsReady: Promise<void> = Promise.resolve();
   private masterGain: GainNode | null = null;
   private masterLimiter: DynamicsCompressorNode | null = null;
+  private onsetProbe: OnsetProbe | null = null;
+  private renderWatch: RenderWatch | null = null;
+  private loudnessMeter: LoudnessMeter | null = null;
+  private engineTrims: Map<string, GainNode> = new Map(); // Keyed by instance handle
+  // Survive context recreation, so learned trims and meter slots are kept
+  private trimDb: Map<string, number> = new Map();
+  private meterSlots: Map<string, number> = new Map();
+  private autoGainEnabled = true;
+  // Last parameters sent to each instance, logged in full when a recording picks it up
+  private paramStates: Map<string, SynthState> = new Map();
+  // Scene slices for engines not created yet, applied when they are
+  private pendingScene: Map<string, SceneSlice> = new Map();
+  private onsetProbeEnabled = false;
+  // Microphone pitch Criosfera's keyboard voices follow (setVoiceFollow)
+  private voiceFollow: { stream: MediaStream; source: MediaStreamAudioSourceNode; tracker: PitchTracker } | null = null;
 
   constructor() {
     // Don't create any engines in constructor - lazy creation only
   }
 
   /**
-   * Gets or creates an engine by name using the registry (lazy creation)
+   * Gets or creates an engine instance by handle using the registry (lazy creation)
    */
-  private getOrCreateEngine(name: string): ISynthEngine | undefined {
-    let engine = this.engines.get(name);
+  private getOrCreateEngine(handle: string): ISynthEngine | undefined {
+    let engine = this.engines.get(handle);
     if (!engine) {
       // Create engine using the registry
+      const name = this.instanceTypes.get(handle) ?? handle;
       engine = engineRegistry.createEngine(name);
       if (engine) {
-        this.engines.set(name, engine);
+        if (__TRACE__) tracer.instant(handle, 'create');
+        this.engines.set(handle, engine);
       } else {
         console.warn(`Engine "${name}" not found in registry`);
       }
@@ -37,28 +92,117 @@ class SynthManager {
     // Always ensure engine is initialized if context exists
     // (init() has early return if already initialized, so this is safe)
     if (engine && this.ctx) {
-      engine.init(this.ctx, this.masterGain || undefined);
+      engine.init(this.ctx, this.getEngineTrim(handle));
+    }
+    // Engines that first appear during a recording are seeded as they join it
+    if (engine && performanceLog.isRecording()) {
+      performanceLog.addEngine(handle, engine, this.paramStates.get(handle));
+    }
+    // A scene generated before the engine existed lands now
+    const name = this.instanceTypes.get(handle) ?? handle;
+    const pending = this.pendingScene.get(name);
+    if (engine && this.ctx && pending) {
+      this.pendingScene.delete(name);
+      this.paramStates.set(handle, pending.state);
+      engine.updateParameters(pending.state);
+      pending.apply?.(engine);
+    }
+    // Voice following reaches Criosfera whenever it is created or rebuilt
+    if (engine && this.ctx && handle === 'criosfera' && this.voiceFollow) {
+      (engine as CriosferaEngine).setPitchSource(this.voiceFollow.tracker);
     }
 
     return engine;
   }
 
+  /**
+   * Create an additional instance of an engine, independent of the primary one.
+   * Instances on the same context share immutable resources (impulse responses,
+   * noise tables, curves, worklet modules), so a layer costs only its voices.
+   * @returns The instance handle, or undefined if the engine is unknown
+   */
+  createInstance(engineName: string): string | undefined {
+    if (!engineRegistry.has(engineName)) {
+      console.warn(`Cannot create instance of unknown engine: ${engineName}`);
+      return undefined;
+    }
+    const n = (this.instanceCounters.get(engineName) ?? 1) + 1;
+    this.instanceCounters.set(engineName, n);
+
+    const handle = `${engineName}#${n}`;
+    this.instanceTypes.set(handle, engineName);
+    this.getOrCreateEngine(handle);
+    return handle;
+  }
+
+  /**
+   * Get an engine instance by handle (a plain engine name gives the primary instance)
+   */
+  getInstance(handle: string): ISynthEngine | undefined {
+    return this.engines.get(handle);
+  }
+
+  /**
+   * Handles of every live instance of an engine, primary first
+   */
+  getInstances(engineName: string): string[] {
+    const handles = this.engines.has(engineName) ? [engineName] : [];
+    this.instanceTypes.forEach((name, handle) => {
+      if (name === engineName && this.engines.has(handle)) handles.push(handle);
+    });
+    return handles;
+  }
+
+  /**
+   * Tear down an instance created with createInstance (primary instances stay)
+   */
+  destroyInstance(handle: string) {
+    if (!this.instanceTypes.has(handle)) return;
+    const engine = this.engines.get(handle);
+    if (engine) {
+      if (__TRACE__) tracer.instant(handle, 'destroy');
+      engine.reset?.();
+      engine.destroy?.();
+    }
+    this.engineTrims.get(handle)?.disconnect();
+    this.engineTrims.delete(handle);
+    this.engines.delete(handle);
+    this.instanceTypes.delete(handle);
+    this.trimDb.delete(handle);
+    this.meterSlots.delete(handle);
+  }
+
   async init() {
     if (!this.ctx) {
       this.ctx = new (window.AudioContext || (window as any).webkitAudioContext)({
         latencyHint: 'interactive'
       });
+      if (__TRACE__) tracer.setClock(this.ctx);
+      if (__TRACE__) tracer.instant('manager', 'contextCreated', this.ctx.sampleRate);
     }
 
     this.setupMasterBus();
 
     // Only create and initialize the active engine
     this.getOrCreateEngine(this.activeEngineName);
+
+    await this.whenWorkletsReady();
+  }
+
+  /**
+   * Resolves when every worklet processor is available on the current context.
+   * Worklet-backed nodes wait on the same load, so this is one module per context.
+   */
+  whenWorkletsReady(): Promise<void> {
+    return this.workletsReady.catch(err => console.error('[SynthManager] Worklet module failed to load:', err));
   }
 
   private setupMasterBus() {
     if (!this.ctx) return;
 
+    // Start the worklet module load first; everything below that needs it waits on it
+    this.workletsReady = ensureWorklets(this.ctx);
+
     // Create master nodes on the CURRENT context
     this.masterGain = this.ctx.createGain();
     this.masterGain.gain.value = 0.8; // Safe default headroom
@@ -72,26 +216,149 @@ class SynthManager {
 
     this.masterGain.connect(this.masterLimiter);
     this.masterLimiter.connect(this.ctx.destination);
+
+    // Trims belong to the old context; engines get new ones as they are (re)initialised
+    this.engineTrims.clear();
+    this.loudnessMeter?.dispose();
+    this.loudnessMeter = new LoudnessMeter(this.ctx, METER_SLOTS);
+    this.loudnessMeter.connect(this.masterGain, 0);
+    this.loudnessMeter.onReading = (readings) => this.steerTrims(readings);
+
+    this.renderWatch?.dispose();
+    this.renderWatch = new RenderWatch(this.ctx, this.masterLimiter);
+
+    // The probe listens to the bus of the current context, so rebuild it with the bus
+    this.onsetProbe?.dispose();
+    this.onsetProbe = this.onsetProbeEnabled ? new OnsetProbe(this.ctx, this.masterLimiter) : null;
   }
 
-  updateParameters(state: SynthState) {
-    const engine = this.engines.get(this.activeEngineName);
+  /**
+   * Per-instance trim gain between the engine's output and the master bus (created on demand)
+   */
+  private getEngineTrim(name: string): GainNode | undefined {
+    if (!this.ctx || !this.masterGain) return undefined;
+    let trim = this.engineTrims.get(name);
+    if (!trim) {
+      trim = this.ctx.createGain();
+      trim.gain.value = Math.pow(10, (this.trimDb.get(name) ?? 0) / 20);
+      trim.connect(this.masterGain);
+      this.engineTrims.set(name, trim);
+
+      if (!this.meterSlots.has(name)) {
+        const used = new Set(this.meterSlots.values());
+        for (let slot = 1; slot < METER_SLOTS; slot++) {
+          if (!used.has(slot)) {
+            this.meterSlots.set(name, slot);
+            break;
+          }
+        }
+      }
+      const slot = this.meterSlots.get(name);
+      if (slot !== undefined) this.loudnessMeter?.connect(trim, slot);
+    }
+    return trim;
+  }
+
+  /**
+   * Nudge each sounding engine's trim towards the target loudness.
+   * Readings are taken after the trim, so this is a slow feedback loop.
+   */
+  private steerTrims(readings: LoudnessReading[]) {
+    if (!this.autoGainEnabled || !this.ctx) return;
+    const t = this.ctx.currentTime;
+
+    this.engineTrims.forEach((trim, name) => {
+      const slot = this.meterSlots.get(name);
+      if (slot === undefined) return;
+      const measured = readings[slot].shortTerm;
+      if (measured < LOUDNESS_GATE_LUFS) return;
+      // Only steer on steady material, so note tails fading out do not pump the trim up
+      if (Math.abs(readings[slot].momentary - measured) > STEADY_TOLERANCE_DB) return;
+
+      const current = this.trimDb.get(name) ?? 0;
+      const next = Math.max(-MAX_TRIM_DB, Math.min(MAX_TRIM_DB, current + (TARGET_LUFS - measured) * TRIM_ADJUST_RATE));
+      if (Math.abs(next - current) < 0.01) return;
+      this.trimDb.set(name, next);
+      trim.gain.setTargetAtTime(Math.pow(10, next / 20), t, TRIM_TIME_CONSTANT);
+    });
+  }
+
+  /**
+   * Enable or disable loudness auto-gain. Disabling returns every trim to unity.
+   */
+  setAutoGainEnabled(enabled: boolean) {
+    this.autoGainEnabled = enabled;
+    if (enabled || !this.ctx) return;
+    const t = this.ctx.currentTime;
+    this.trimDb.clear();
+    this.engineTrims.forEach(trim => trim.gain.setTargetAtTime(1, t, TRIM_TIME_CONSTANT));
+  }
+
+  isAutoGainEnabled(): boolean {
+    return this.autoGainEnabled;
+  }
+
+  /**
+   * Latest loudness readings: the master bus and every metered engine
+   */
+  getLoudnessReadings(): { name: string; momentary: number; shortTerm: number; trimDb: number }[] {
+    const meter = this.loudnessMeter;
+    if (!meter) return [];
+    const result: { name: string; momentary: number; shortTerm: number; trimDb: number }[] = [];
+    const master = meter.getReading(0);
+    if (master) result.push({ name: 'master', ...master, trimDb: 0 });
+    this.meterSlots.forEach((slot, name) => {
+      const reading = meter.getReading(slot);
+      if (reading && this.engineTrims.has(name)) {
+        result.push({ name, ...reading, trimDb: this.trimDb.get(name) ?? 0 });
+      }
+    });
+    return result;
+  }
+
+  /**
+   * Detect onsets at the master output and match them against scheduled triggers
+   * (see TimingTelemetry). Off by default: it is a diagnostics tool.
+   */
+  setOnsetProbeEnabled(enabled: boolean) {
+    this.onsetProbeEnabled = enabled;
+    this.onsetProbe?.dispose();
+    this.onsetProbe = enabled && this.ctx && this.masterLimiter ? new OnsetProbe(this.ctx, this.masterLimiter) : null;
+  }
+
+  isOnsetProbeEnabled(): boolean {
+    return this.onsetProbeEnabled;
+  }
+
+  /**
+   * @param handle - Instance to address (defaults to the active engine)
+   */
+  updateParameters(state: SynthState, handle: string = this.activeEngineName) {
+    const engine = this.engines.get(handle);
     if (engine) {
+      if (__TRACE__) tracer.instant(handle, 'updateParameters');
+      this.paramStates.set(handle, state);
+      performanceLog.state(handle, state);
       engine.updateParameters(state);
     }
   }
 
-  playNote(frequency: number, velocity?: number) {
-    const engine = this.engines.get(this.activeEngineName);
+  playNote(frequency: number, velocity?: number, handle: string = this.activeEngineName) {
+    const engine = this.engines.get(handle);
     if (engine) {
-      return engine.playNote(frequency, velocity);
+      if (__TRACE__) tracer.instant(handle, 'playNote', frequency);
+      const id = engine.playNote(frequency, velocity);
+      performanceLog.noteOn(handle, id, frequency, velocity);
+      return id;
     }
     return undefined;
   }
 
-  stopNote(id: number) {
-    const engine = this.engines.get(this.activeEngineName);
+  stopNote(id: number, handle: string = this.activeEngineName) {
+    const engine = this.engines.get(handle);
     if (engine) {
+      if (__TRACE__) tracer.instant(handle, 'stopNote', id);
+      performanceLog.noteOff(handle, id);
       engine.stopNote(id);
     }
   }
@@ -102,21 +369,153 @@ class SynthManager {
     }
   }
 
+  /**
+   * @param engineName - Engine name, or an instance handle from createInstance
+   */
   switchEngine(engineName: string) {
-    // Validate that engine exists in registry
-    if (!engineRegistry.has(engineName)) {
+    // Validate that engine exists in registry (or is a live extra instance)
+    if (!engineRegistry.has(engineName) && !this.instanceTypes.has(engineName)) {
       console.warn(`Cannot switch to unknown engine: ${engineName}`);
       return;
     }
 
     // We no longer reset the previous engine automatically.
     // The principle is that all engines keep sounding unless stopped explicitly.
+    if (__TRACE__) tracer.instant(engineName, 'switchTo');
     this.activeEngineName = engineName;
+    performanceLog.engine(engineName);
 
     // NOTE: Engine creation is now lazy - it happens when UI requests the engine
     // This avoids lag during switch navigation
   }
 
+  /**
+   * Start recording the performance into a compact log (see PerformanceLog).
+   * Every engine is seeded, so its random choices replay the same.
+   * @returns False if audio has not started yet
+   */
+  startRecording(seed: number): boolean {
+    if (!this.ctx) return false;
+    performanceLog.start(this.ctx, seed, [...this.engines.entries()].map(([handle, engine]) =>
+      [handle, engine, this.paramStates.get(handle)] as [string, ISynthEngine, SynthState | undefined]));
+    performanceLog.engine(this.activeEngineName);
+    return true;
+  }
+
+  /**
+   * Stop recording; engines go back to unseeded randomness
+   * @returns The encoded log, or null if nothing was being recorded
+   */
+  stopRecording(): Uint8Array | null {
+    const bytes = performanceLog.stop();
+    this.engines.forEach(engine => engine.setSeed?.(null));
+    return bytes;
+  }
+
+  /**
+   * Play a recorded performance back live: each engine is seeded and set to
+   * its recorded starting state, then events are applied on the audio clock.
+   * Engine switches are not replayed (every engine keeps sounding anyway), so
+   * the UI stays where it is.
+   * @returns Cancels the replay and releases its notes
+   */
+  replay(performance: Performance, onDone?: () => void): () => void {
+    const ctx = this.ctx;
+    if (!ctx) {
+      onDone?.();
+      return () => { };
+    }
+
+    const engines = new Map<string, ISynthEngine>();
+    for (const entry of performance.engines) {
+      const engine = this.getOrCreateEngine(entry.name);
+      if (!engine) continue;
+      engine.setSeed?.(entry.seed);
+      if (entry.state !== undefined) engine.restoreState?.(entry.state);
+      engines.set(entry.name, engine);
+    }
+
+    const states = new Map<string, Partial<SynthState>>();
+    const notes = new Map<string, number>();
+    const origin = ctx.currentTime;
+    const events = performance.events;
+    let index = 0;
+    let timerId: ReturnType<typeof setTimeout> | null = null;
+
+    const finish = () => {
+      if (timerId) clearTimeout(timerId);
+      timerId = null;
+      notes.forEach((id, key) => engines.get(key.slice(0, key.lastIndexOf(':')))?.stopNote(id));
+      notes.clear();
+      engines.forEach(engine => engine.setSeed?.(null));
+    };
+
+    const pump = () => {
+      const now = ctx.currentTime - origin;
+      const changed = new Set<string>();
+      while (index < events.length && events[index].time <= now) {
+        const event = events[index++];
+        const engine = engines.get(event.engine);
+        if (!engine) continue;
+        const key = `${event.engine}:${'note' in event ? event.note : ''}`;
+        if (event.type === 'param') {
+          states.set(event.engine, { ...states.get(event.engine), [event.param]: event.value });
+          changed.add(event.engine);
+        } else if (event.type === 'noteOn') {
+          const id = engine.playNote(event.frequency, event.velocity);
+          if (id !== undefined) notes.set(key, id);
+        } else if (event.type === 'laneOn') {
+          const id = engine.playExpressive?.(event.lane, event.velocity);
+          if (id !== undefined) notes.set(key, id);
+        } else if (event.type === 'noteOff') {
+          const id = notes.get(key);
+          if (id !== undefined) engine.stopNote(id);
+          notes.delete(key);
+        } else if (event.type !== 'engine') {
+          applyControl(engine, event);
+        }
+      }
+      // A whole state per engine, once per batch
+      changed.forEach(name => {
+        const state = states.get(name)!;
+        if (isCompleteState(state)) engines.get(name)!.updateParameters(state);
+      });
+
+      if (index < events.length) {
+        timerId = setTimeout(pump, Math.max(0, (events[index].time - now) * 1000));
+      } else {
+        finish();
+        onDone?.();
+      }
+    };
+    pump();
+
+    return finish;
+  }
+
+  /**
+   * Touch surface: write a Criosfera expression lane (logged, so it replays)
+   */
+  setExpression(lane: number, frequency: number, brightness: number, pressure: number) {
+    const expression = this.getCriosferaEngine()?.getExpression();
+    if (!expression) return;
+    performanceLog.lane('criosfera', lane, frequency, brightness, pressure);
+    expression.set(lane, frequency, brightness, pressure);
+  }
+
+  /**
+   * Touch surface: start a Criosfera voice on a lane already written with
+   * setExpression. Stop it with stopNote(id, 'criosfera').
+   */
+  playExpressive(lane: number, velocity?: number): number | undefined {
+    const engine = this.getCriosferaEngine();
+    if (!engine) return undefined;
+    if (__TRACE__) tracer.instant('criosfera', 'playExpressive', lane);
+    const id = engine.playExpressive(lane, velocity);
+    performanceLog.laneOn('criosfera', id, lane, velocity);
+    return id;
+  }
+
   /**
    * Get typed access to Gearheart engine (for engine-specific methods)
    */
@@ -126,6 +525,14 @@ class SynthManager {
     return this.engines.get('gearheart') as GearheartEngine | undefined;
   }
 
+  /**
+   * Shared tempo in BPM: Brétema's sequencer when it exists, 120 otherwise.
+   * Recorded loops (Echo Vessel, Vocoder) can be stretched to fit it.
+   */
+  getTempo(): number {
+    return (this.engines.get('breitema') as BreitemaEngine | undefined)?.getTempo() ?? 120;
+  }
+
   /**
    * Get typed access to EchoVessel engine (for engine-specific methods)
    */
@@ -146,6 +553,106 @@ class SynthManager {
     return this.engines.get('vocoder') as VocoderEngine | undefined;
   }
 
+  /**
+   * Get typed access to the granular engine (for engine-specific methods)
+   */
+  getGranularEngine(): GranularEngine | undefined {
+    this.getOrCreateEngine('grans');
+    return this.engines.get('grans') as GranularEngine | undefined;
+  }
+
+  /**
+   * Get the Criosfera engine instance (for the touch surface's expressive voices)
+   */
+  getCriosferaEngine(): CriosferaEngine | undefined {
+    this.getOrCreateEngine('criosfera');
+    return this.engines.get('criosfera') as CriosferaEngine | undefined;
+  }
+
+  /**
+   * Let Criosfera's keyboard voices follow the pitch of whoever sings into the
+   * microphone. The mic only feeds the tracker; it is never heard.
+   * @returns Whether following is on (false if the microphone was refused)
+   */
+  async setVoiceFollow(enabled: boolean): Promise<boolean> {
+    if (!enabled) {
+      this.stopVoiceFollow();
+      return false;
+    }
+    if (this.voiceFollow) return true;
+    if (!this.ctx) await this.init();
+    const ctx = this.ctx;
+    if (!ctx) return false;
+
+    try {
+      // Raw signal: echo cancellation and AGC smear the pitch
+      const stream = await navigator.mediaDevices.getUserMedia({
+        audio: { echoCancellation: false, noiseSuppression: false, autoGainControl: false }
+      });
+      const source = ctx.createMediaStreamSource(stream);
+      const tracker = new PitchTracker(ctx);
+      source.connect(tracker.input);
+      this.voiceFollow = { stream, source, tracker };
+      // If Criosfera isn't open yet, getOrCreateEngine attaches the tracker when it is
+      (this.engines.get('criosfera') as CriosferaEngine | undefined)?.setPitchSource(tracker);
+      return true;
+    } catch (err) {
+      console.error('[SynthManager] Voice follow: microphone unavailable:', err);
+      return false;
+    }
+  }
+
+  isVoiceFollowEnabled(): boolean {
+    return this.voiceFollow !== null;
+  }
+
+  /** Latest tracked voice pitch while following, for display */
+  getVoicePitch() {
+    return this.voiceFollow?.tracker.getPitch() ?? null;
+  }
+
+  private stopVoiceFollow() {
+    if (!this.voiceFollow) return;
+    (this.engines.get('criosfera') as CriosferaEngine | undefined)?.setPitchSource(null);
+    this.voiceFollow.stream.getTracks().forEach(track => track.stop());
+    this.voiceFollow.source.disconnect();
+    this.voiceFollow.tracker.dispose();
+    this.voiceFollow = null;
+  }
+
+  /**
+   * Get the Sampler engine instance
+   */
+  getSamplerEngine(): SamplerEngine | undefined {
+    this.getOrCreateEngine('sampler');
+    return this.engines.get('sampler') as SamplerEngine | undefined;
+  }
+
+  /**
+   * Apply a whole scene in one pass: every live instance of each engine gets
+   * its slice now. Engines that were never opened are not created; their
+   * slice waits and is applied when they are.
+   */
+  applyScene(slices: SceneSlice[]) {
+    if (__TRACE__) tracer.begin('manager', 'applyScene');
+    for (const slice of slices) {
+      const handles = this.getInstances(slice.name);
+      if (handles.length === 0) {
+        this.pendingScene.set(slice.name, slice);
+        continue;
+      }
+      this.pendingScene.delete(slice.name);
+      for (const handle of handles) {
+        const engine = this.engines.get(handle)!;
+        this.paramStates.set(handle, slice.state);
+        performanceLog.state(handle, slice.state);
+        engine.updateParameters(slice.state);
+        slice.apply?.(engine);
+      }
+    }
+    if (__TRACE__) tracer.end('manager', 'applyScene');
+  }
+
   /**
    * Get an engine by name (for external access without type casting)
    */
@@ -200,23 +707,34 @@ class SynthManager {
    */
   async resetAudioContext() {
     if (!this.ctx) return;
+    if (__TRACE__) tracer.begin('manager', 'resetAudioContext');
+
+    // The tracker lives on the old context; following resumes on the new one
+    const following = this.voiceFollow !== null;
+    this.stopVoiceFollow();
 
     // Close the old context
     await this.ctx.close();
 
     // Create a new context
     this.ctx = new (window.AudioContext || (window as any).webkitAudioContext)();
+    if (__TRACE__) tracer.setClock(this.ctx);
 
     // RECREATE master bus on the new context
     this.setupMasterBus();
 
-    // Re-initialize all existing engines with the new context
+    // Re-initialize all existing engine instances with the new context. Tear the
+    // old ones down first: take subscriptions and stream workers outlive the context
     const oldEngines = Array.from(this.engines.keys());
+    this.engines.forEach(engine => engine.destroy?.());
     this.engines.clear();
 
-    for (const engineName of oldEngines) {
-      this.getOrCreateEngine(engineName);
+    for (const handle of oldEngines) {
+      this.getOrCreateEngine(handle);
     }
+    await this.whenWorkletsReady();
+    if (following) await this.setVoiceFollow(true);
+    if (__TRACE__) tracer.end('manager', 'resetAudioContext');
   }
 
   /**
@@ -225,27 +743,41 @@ class SynthManager {
    */
   async restoreAudioVolume(): Promise<void> {
     if (!this.ctx) return;
+    if (__TRACE__) tracer.begin('manager', 'restoreAudioVolume');
+
+    // The tracker lives on the old context; following resumes on the new one
+    const following = this.voiceFollow !== null;
+    this.stopVoiceFollow();
 
     // Close the old context
     await this.ctx.close();
 
     // Create a new context
     this.ctx = new (window.AudioContext || (window as any).webkitAudioContext)();
+    if (__TRACE__) tracer.setClock(this.ctx);
 
     // RECREATE master bus on the new context
     this.setupMasterBus();
 
-    // Reinitialize Criosfera (it's simpler, doesn't hold complex state)
-    if (this.engines.has('criosfera')) {
-      this.engines.delete('criosfera');
-      this.getOrCreateEngine('criosfera');
-    }
-
-    // Reinitialize Gearheart with new context while preserving gear state
-    const gearheartEngine = this.engines.get('gearheart') as GearheartEngine | undefined;
-    if (gearheartEngine && (gearheartEngine as any).reinitWithContext) {
-      (gearheartEngine as any).reinitWithContext(this.ctx, this.masterGain || undefined);
+    // Move every instance, primary or extra, onto the new context
+    for (const [handle, engine] of Array.from(this.engines.entries())) {
+      // Gearheart and Echo Vessel rebuild their nodes in place, keeping the gears
+      // and the recorded take. Every engine inherits reinitWithContext, but the
+      // rest only rebuild their master chain.
+      if (REINIT_IN_PLACE.has(this.instanceTypes.get(handle) ?? handle)) {
+        (engine as any).reinitWithContext(this.ctx, this.getEngineTrim(handle));
+        continue;
+      }
+      // Others are rebuilt; what they can snapshot (patterns, layouts...) is carried over
+      const saved = engine.saveState?.();
+      engine.destroy?.();
+      this.engines.delete(handle);
+      const rebuilt = this.getOrCreateEngine(handle);
+      if (saved !== undefined) rebuilt?.restoreState?.(saved);
     }
+    await this.whenWorkletsReady();
+    if (following) await this.setVoiceFollow(true);
+    if (__TRACE__) tracer.end('manager', 'restoreAudioVolume');
   }
 
   getAudioContext(): AudioContext | null {
@@ -0,0 +1,59 @@
+/**
+ * A recorded take published by an engine that captures audio.
+ */
+export interface RecordedTake {
+    /** Engine that recorded it (e.g. 'echo-vessel', 'vocoder') */
+    source: string;
+    buffer: AudioBuffer;
+    recordedAt: number;
+}
+
+type TakeListener = (take: RecordedTake) => void;
+
+/**
+ * Registry of the latest recorded take per engine.
+ * Lets engines that process recordings (granular, loopers) share them
+ * without depending on the engines that record.
+ */
+class TakeRegistry {
+    private takes = new Map<string, RecordedTake>();
+    private listeners = new Set<TakeListener>();
+
+    /**
+     * Publish a freshly recorded take, replacing the previous one from the same source
+     */
+    publish(source: string, buffer: AudioBuffer): void {
+        const take: RecordedTake = { source, buffer, recordedAt: Date.now() };
+        this.takes.set(source, take);
+        this.listeners.forEach(listener => listener(take));
+    }
+
+    /**
+     * Get the take recorded by a given engine
+     */
+    get(source: string): RecordedTake | undefined {
+        return this.takes.get(source);
+    }
+
+    /**
+     * Get the most recent take from any source
+     */
+    getLatest(): RecordedTake | undefined {
+        let latest: RecordedTake | undefined;
+        this.takes.forEach(take => {
+            if (!latest || take.recordedAt > latest.recordedAt) latest = take;
+        });
+        return latest;
+    }
+
+    /**
+     * Subscribe to new takes. Returns an unsubscribe function.
+     */
+    subscribe(listener: TakeListener): () => void {
+        this.listeners.add(listener);
+        return () => { this.listeners.delete(listener); };
+    }
+}
+
+// Singleton instance
+export const takeRegistry = new TakeRegistry();
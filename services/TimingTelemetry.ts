@@ -0,0 +1,188 @@
+import { watchdog } from './Watchdog';
+
+/**
+ * Trigger timing telemetry for the sequencing engines.
+ *
+ * Schedulers report, per trigger, when the note was meant to sound and when it
+ * was actually scheduled on the audio clock, plus how much lookahead slack was
+ * left when the step was queued. The optional onset probe (see OnsetProbe.ts)
+ * adds when the onset really appeared at the output. Everything lands in
+ * fixed-bin histograms so recording costs a few increments and no allocation.
+ */
+
+export type TimingMetric = 'error' | 'slack' | 'onset';
+
+export interface HistogramSnapshot {
+    /** Lower edge of the first bin, in ms */
+    min: number;
+    /** Bin width, in ms */
+    binWidth: number;
+    bins: number[];
+    count: number;
+    mean: number;
+    p50: number;
+    p95: number;
+    max: number;
+}
+
+export type TimingSnapshot = Record<string, Record<TimingMetric, HistogramSnapshot>>;
+
+// Ranges in ms; values outside land in the edge bins
+const HISTOGRAM_LAYOUT: Record<TimingMetric, { min: number; max: number; binWidth: number }> = {
+    error: { min: 0, max: 40, binWidth: 1 },
+    slack: { min: -20, max: 120, binWidth: 5 },
+    onset: { min: -10, max: 50, binWidth: 2 }
+};
+
+// Expected onsets kept for matching against the probe
+const PENDING_ONSETS = 64;
+// Probe onsets further than this from any expected onset are ignored
+const ONSET_MATCH_WINDOW = 0.06;
+
+class Histogram {
+    readonly min: number;
+    readonly binWidth: number;
+    readonly bins: Uint32Array;
+    count = 0;
+    private sum = 0;
+    private max = -Infinity;
+
+    constructor(min: number, max: number, binWidth: number) {
+        this.min = min;
+        this.binWidth = binWidth;
+        this.bins = new Uint32Array(Math.ceil((max - min) / binWidth));
+    }
+
+    add(valueMs: number): void {
+        let bin = Math.floor((valueMs - this.min) / this.binWidth);
+        if (bin < 0) bin = 0;
+        else if (bin >= this.bins.length) bin = this.bins.length - 1;
+        this.bins[bin]++;
+        this.count++;
+        this.sum += valueMs;
+        if (valueMs > this.max) this.max = valueMs;
+    }
+
+    reset(): void {
+        this.bins.fill(0);
+        this.count = 0;
+        this.sum = 0;
+        this.max = -Infinity;
+    }
+
+    /**
+     * Percentile from the bins (upper edge of the bin that crosses it)
+     */
+    percentile(p: number): number {
+        if (this.count === 0) return 0;
+        const target = p * this.count;
+        let seen = 0;
+        for (let i = 0; i < this.bins.length; i++) {
+            seen += this.bins[i];
+            if (seen >= target) return this.min + (i + 1) * this.binWidth;
+        }
+        return this.min + this.bins.length * this.binWidth;
+    }
+
+    snapshot(): HistogramSnapshot {
+        return {
+            min: this.min,
+            binWidth: this.binWidth,
+            bins: Array.from(this.bins),
+            count: this.count,
+            mean: this.count > 0 ? this.sum / this.count : 0,
+            p50: this.percentile(0.5),
+            p95: this.percentile(0.95),
+            max: this.count > 0 ? this.max : 0
+        };
+    }
+}
+
+class TimingTelemetry {
+    private readonly sources = new Map<string, Record<TimingMetric, Histogram>>();
+
+    // Ring of expected onset times (audio clock seconds) and their sources
+    private readonly pendingTimes = new Float64Array(PENDING_ONSETS).fill(-1);
+    private readonly pendingSources: string[] = new Array(PENDING_ONSETS).fill('');
+    private pendingHead = 0;
+
+    /**
+     * Lookahead left when a step was queued: scheduled time minus ctx.currentTime
+     */
+    recordSlack(source: string, slackSeconds: number): void {
+        this.histograms(source).slack.add(slackSeconds * 1000);
+        // Negative slack: the step was queued after it was due, a stalled timer
+        if (slackSeconds < 0) watchdog.recordSchedulerMiss();
+    }
+
+    /**
+     * A trigger that was meant to sound at `intended` and was scheduled at `actual`
+     * (both audio clock seconds). A late scheduler shows up as actual > intended.
+     */
+    recordHit(source: string, intended: number, actual: number): void {
+        this.histograms(source).error.add((actual - intended) * 1000);
+
+        const i = this.pendingHead;
+        this.pendingTimes[i] = actual;
+        this.pendingSources[i] = source;
+        this.pendingHead = (i + 1) % PENDING_ONSETS;
+    }
+
+    /**
+     * Match an onset detected at the output against the nearest expected one.
+     * Each expected onset is consumed by the first detection that claims it.
+     */
+    recordOnset(detectedTime: number): void {
+        let best = -1;
+        let bestDistance = ONSET_MATCH_WINDOW;
+        for (let i = 0; i < PENDING_ONSETS; i++) {
+            const expected = this.pendingTimes[i];
+            if (expected < 0) continue;
+            const distance = Math.abs(detectedTime - expected);
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                best = i;
+            }
+        }
+        if (best < 0) return;
+
+        this.histograms(this.pendingSources[best]).onset.add((detectedTime - this.pendingTimes[best]) * 1000);
+        this.pendingTimes[best] = -1;
+    }
+
+    getSnapshot(): TimingSnapshot {
+        const snapshot: TimingSnapshot = {};
+        this.sources.forEach((histograms, source) => {
+            snapshot[source] = {
+                error: histograms.error.snapshot(),
+                slack: histograms.slack.snapshot(),
+                onset: histograms.onset.snapshot()
+            };
+        });
+        return snapshot;
+    }
+
+    reset(): void {
+        this.sources.forEach(histograms => {
+            histograms.error.reset();
+            histograms.slack.reset();
+            histograms.onset.reset();
+        });
+        this.pendingTimes.fill(-1);
+    }
+
+    private histograms(source: string): Record<TimingMetric, Histogram> {
+        let histograms = this.sources.get(source);
+        if (!histograms) {
+            const make = (metric: TimingMetric) => {
+                const layout = HISTOGRAM_LAYOUT[metric];
+                return new Histogram(layout.min, layout.max, layout.binWidth);
+            };
+            histograms = { error: make('error'), slack: make('slack'), onset: make('onset') };
+            this.sources.set(source, histograms);
+        }
+        return histograms;
+    }
+}
+
+export const timingTelemetry = new TimingTelemetry();
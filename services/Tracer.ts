@@ -0,0 +1,191 @@
+/**
+ * Low-overhead event tracer for post-mortem debugging of audio glitches.
+ *
+ * Events go into a fixed ring buffer of typed arrays (no per-event objects),
+ * stamped with both performance.now() and the AudioContext clock. The buffer
+ * can be exported in Chrome trace format (chrome://tracing, ui.perfetto.dev).
+ *
+ * Call sites are written as `if (__TRACE__) tracer.instant(...)`; building with
+ * TRACE=0 defines __TRACE__ as false and the minifier drops them entirely.
+ */
+
+// Phase codes stored per event; indexes into PHASE_CODES
+const INSTANT = 0;
+const BEGIN = 1;
+const END = 2;
+const COUNTER = 3;
+const PHASE_CODES = ['i', 'B', 'E', 'C'];
+
+interface ClockSource {
+    readonly currentTime: number;
+}
+
+interface TraceEvent {
+    name: string;
+    cat: string;
+    ph: string;
+    ts: number;
+    pid: number;
+    tid: number;
+    s?: string;
+    args?: Record<string, number | string>;
+}
+
+class Tracer {
+    private readonly capacity: number;
+    private readonly wallTimes: Float64Array;
+    private readonly audioTimes: Float64Array;
+    private readonly values: Float64Array;
+    private readonly nameIds: Uint16Array;
+    private readonly categoryIds: Uint8Array;
+    private readonly phases: Uint8Array;
+
+    private head = 0;
+    private count = 0;
+    private dropped = 0;
+
+    // Interned strings: call sites pass literals, so these stay tiny
+    private readonly names: string[] = [];
+    private readonly nameIndex = new Map<string, number>();
+    private readonly categories: string[] = [];
+    private readonly categoryIndex = new Map<string, number>();
+
+    private clock: ClockSource | null = null;
+
+    constructor(capacity: number = 16384) {
+        this.capacity = capacity;
+        this.wallTimes = new Float64Array(capacity);
+        this.audioTimes = new Float64Array(capacity);
+        this.values = new Float64Array(capacity);
+        this.nameIds = new Uint16Array(capacity);
+        this.categoryIds = new Uint8Array(capacity);
+        this.phases = new Uint8Array(capacity);
+    }
+
+    /**
+     * Audio clock used to stamp events (call again after the context is recreated)
+     */
+    setClock(clock: ClockSource | null): void {
+        this.clock = clock;
+    }
+
+    instant(category: string, name: string, value: number = NaN): void {
+        this.record(INSTANT, category, name, value);
+    }
+
+    begin(category: string, name: string): void {
+        this.record(BEGIN, category, name, NaN);
+    }
+
+    end(category: string, name: string): void {
+        this.record(END, category, name, NaN);
+    }
+
+    counter(category: string, name: string, value: number): void {
+        this.record(COUNTER, category, name, value);
+    }
+
+    clear(): void {
+        this.head = 0;
+        this.count = 0;
+        this.dropped = 0;
+    }
+
+    getEventCount(): number {
+        return this.count;
+    }
+
+    private record(phase: number, category: string, name: string, value: number): void {
+        const i = this.head;
+        this.wallTimes[i] = performance.now();
+        this.audioTimes[i] = this.clock ? this.clock.currentTime : -1;
+        this.values[i] = value;
+        this.nameIds[i] = this.intern(name, this.names, this.nameIndex);
+        this.categoryIds[i] = this.intern(category, this.categories, this.categoryIndex);
+        this.phases[i] = phase;
+
+        this.head = (i + 1) % this.capacity;
+        if (this.count < this.capacity) this.count++;
+        else this.dropped++;
+    }
+
+    private intern(text: string, table: string[], index: Map<string, number>): number {
+        let id = index.get(text);
+        if (id === undefined) {
+            id = table.length;
+            table.push(text);
+            index.set(text, id);
+        }
+        return id;
+    }
+
+    /**
+     * Oldest-to-newest events in Chrome trace JSON. Each category becomes a track;
+     * audio-clock time (seconds) travels in args.audioTime.
+     */
+    exportChromeTrace(): { traceEvents: TraceEvent[]; displayTimeUnit: string; metadata: Record<string, string | number> } {
+        const pid = 1;
+        const events: TraceEvent[] = [
+            { name: 'process_name', cat: '__metadata', ph: 'M', ts: 0, pid, tid: 0, args: { name: 'FantaGal' } }
+        ];
+        this.categories.forEach((category, id) => {
+            events.push({ name: 'thread_name', cat: '__metadata', ph: 'M', ts: 0, pid, tid: id + 1, args: { name: category } });
+        });
+
+        const start = (this.head - this.count + this.capacity) % this.capacity;
+        for (let n = 0; n < this.count; n++) {
+            const i = (start + n) % this.capacity;
+            const phase = this.phases[i];
+            const name = this.names[this.nameIds[i]];
+            const event: TraceEvent = {
+                name,
+                cat: this.categories[this.categoryIds[i]],
+                ph: PHASE_CODES[phase],
+                ts: Math.round(this.wallTimes[i] * 1000),
+                pid,
+                tid: this.categoryIds[i] + 1
+            };
+
+            const args: Record<string, number> = {};
+            if (this.audioTimes[i] >= 0) args.audioTime = this.audioTimes[i];
+            if (phase === COUNTER) {
+                args[name] = this.values[i];
+            } else if (!Number.isNaN(this.values[i])) {
+                args.value = this.values[i];
+            }
+            if (phase === INSTANT) event.s = 't';
+            event.args = args;
+            events.push(event);
+        }
+
+        return {
+            traceEvents: events,
+            displayTimeUnit: 'ms',
+            metadata: {
+                'capture-time': new Date().toISOString(),
+                'dropped-events': this.dropped,
+                'user-agent': navigator.userAgent
+            }
+        };
+    }
+
+    /**
+     * Save the current buffer as a .json file loadable in chrome://tracing
+     */
+    download(): void {
+        const json = JSON.stringify(this.exportChromeTrace());
+        const url = URL.createObjectURL(new Blob([json], { type: 'application/json' }));
+        const link = document.createElement('a');
+        link.href = url;
+        link.download = `fantagal-trace-${new Date().toISOString().replace(/[:.]/g, '-')}.json`;
+        link.click();
+        setTimeout(() => URL.revokeObjectURL(url), 1000);
+    }
+}
+
+export const tracer = new Tracer();
+
+if (__TRACE__ && typeof window !== 'undefined') {
+    // Reachable from the devtools console on a device: __fantagalTrace.download()
+    (window as unknown as { __fantagalTrace: Tracer }).__fantagalTrace = tracer;
+}
@@ -0,0 +1,97 @@
+import { EXPRESSION_LANES, EXPRESSION_STRIDE } from './dsp/AdditiveBank';
+
+/**
+ * Per-voice expression block read by the additive bank processor.
+ * The touch surface writes lanes straight into it, with no React state in
+ * between. When the page is cross-origin isolated the block is a
+ * SharedArrayBuffer the processor reads in place; otherwise a frame's writes
+ * are gathered and posted as one copy per animation frame.
+ */
+export class VoiceExpression {
+    readonly values: Float32Array;
+    readonly shared: boolean;
+
+    private port: MessagePort | null = null;
+    private frameId = 0;
+    private readonly listeners = new Set<() => void>();
+
+    constructor() {
+        const bytes = EXPRESSION_LANES * EXPRESSION_STRIDE * Float32Array.BYTES_PER_ELEMENT;
+        this.shared = typeof SharedArrayBuffer !== 'undefined' && globalThis.crossOriginIsolated === true;
+        this.values = new Float32Array(this.shared ? new SharedArrayBuffer(bytes) : new ArrayBuffer(bytes));
+    }
+
+    /**
+     * Hand the block to the processor (once its node exists)
+     */
+    attach(port: MessagePort): void {
+        this.port = port;
+        if (this.shared) {
+            port.postMessage({ type: 'expression', buffer: this.values.buffer });
+        } else {
+            port.postMessage({ type: 'expression', values: this.values.slice() });
+        }
+    }
+
+    /**
+     * Write one lane. Cheap enough to call on every pointer move.
+     */
+    set(lane: number, frequency: number, brightness: number, pressure: number): void {
+        const i = lane * EXPRESSION_STRIDE;
+        this.values[i] = frequency;
+        this.values[i + 1] = brightness;
+        this.values[i + 2] = pressure;
+        this.schedule();
+    }
+
+    getFrequency(lane: number): number {
+        return this.values[lane * EXPRESSION_STRIDE];
+    }
+
+    getBrightness(lane: number): number {
+        return this.values[lane * EXPRESSION_STRIDE + 1];
+    }
+
+    getPressure(lane: number): number {
+        return this.values[lane * EXPRESSION_STRIDE + 2];
+    }
+
+    /**
+     * Run a listener once per animation frame in which some lane changed
+     * @returns Unsubscribe function
+     */
+    onFrame(listener: () => void): () => void {
+        this.listeners.add(listener);
+        return () => this.listeners.delete(listener);
+    }
+
+    /**
+     * Deliver pending writes now instead of on the next animation frame
+     */
+    flush(): void {
+        if (!this.frameId) return;
+        cancelAnimationFrame(this.frameId);
+        this.frameId = 0;
+        this.deliver();
+    }
+
+    dispose(): void {
+        if (this.frameId) cancelAnimationFrame(this.frameId);
+        this.frameId = 0;
+        this.listeners.clear();
+        this.port = null;
+    }
+
+    private schedule(): void {
+        if (this.frameId) return;
+        this.frameId = requestAnimationFrame(() => {
+            this.frameId = 0;
+            this.deliver();
+        });
+    }
+
+    private deliver(): void {
+        if (!this.shared) this.port?.postMessage({ type: 'expression', values: this.values.slice() });
+        this.listeners.forEach(listener => listener());
+    }
+}
@@ -0,0 +1,261 @@
+import { tracer } from './Tracer';
+
+/**
+ * Main-thread watchdog.
+ *
+ * Audio here is scheduled from the main thread (lookahead timers, AudioParam
+ * writes, physics ticks), so a stalled main thread is the usual cause of an
+ * audible glitch. Stalls are detected two ways: the Long Tasks API where the
+ * browser has it, and an event-loop lag sampler everywhere. Each stall is
+ * correlated with the scheduler misses and render-thread gaps that followed it
+ * and attributed to whichever instrumented component was running at the time.
+ *
+ * When auto-downgrade is on, repeated stalls lower the quality tier, which the
+ * canvas scenes read to draw fewer frames; a calm period raises it again.
+ */
+
+export type WatchdogComponent = 'render' | 'canvas' | 'ir' | 'oracle';
+export type QualityTier = 'high' | 'medium' | 'low';
+
+export interface StallRecord {
+    kind: 'longtask' | 'lag';
+    /** performance.now() timeline, ms */
+    start: number;
+    duration: number;
+    culprit: WatchdogComponent | 'unknown';
+    schedulerMisses: number;
+    underruns: number;
+}
+
+const COMPONENTS: WatchdogComponent[] = ['render', 'canvas', 'ir', 'oracle'];
+const TIERS: QualityTier[] = ['high', 'medium', 'low'];
+const FRAME_STRIDE: Record<QualityTier, number> = { high: 1, medium: 2, low: 3 };
+
+const LAG_INTERVAL_MS = 50;
+const STALL_THRESHOLD_MS = 50;          // Same threshold the Long Tasks API uses
+const SPAN_CAPACITY = 256;
+const EVENT_CAPACITY = 128;
+const STALL_HISTORY = 32;
+const CORRELATION_WINDOW_MS = 250;      // Misses show up once the stalled loop resumes
+
+// Auto-downgrade: this many stalls inside the window drop one tier
+const DOWNGRADE_STALLS = 3;
+const DOWNGRADE_WINDOW_MS = 10000;
+const UPGRADE_CALM_MS = 30000;
+
+class MainThreadWatchdog {
+    // Ring of component spans (start/end on the performance.now() timeline)
+    private readonly spanStarts = new Float64Array(SPAN_CAPACITY);
+    private readonly spanEnds = new Float64Array(SPAN_CAPACITY);
+    private readonly spanComponents = new Uint8Array(SPAN_CAPACITY);
+    private spanHead = 0;
+
+    // Rings of scheduler misses and render-thread gaps
+    private readonly missTimes = new Float64Array(EVENT_CAPACITY).fill(-Infinity);
+    private missHead = 0;
+    private readonly underrunTimes = new Float64Array(EVENT_CAPACITY).fill(-Infinity);
+    private underrunHead = 0;
+
+    private readonly stalls: StallRecord[] = [];
+
+    private started = false;
+    private lagTimer: number | null = null;
+    private observer: PerformanceObserver | null = null;
+
+    private tier: QualityTier = 'high';
+    private autoDowngrade = false;
+    private lastTierChange = 0;
+
+    /**
+     * Start observing (idempotent)
+     */
+    start(): void {
+        if (this.started || typeof window === 'undefined') return;
+        this.started = true;
+
+        if (typeof PerformanceObserver !== 'undefined' &&
+            PerformanceObserver.supportedEntryTypes?.includes('longtask')) {
+            this.observer = new PerformanceObserver(list => {
+                for (const entry of list.getEntries()) {
+                    this.recordStall('longtask', entry.startTime, entry.duration);
+                }
+            });
+            this.observer.observe({ type: 'longtask', buffered: true });
+        }
+
+        let expected = performance.now() + LAG_INTERVAL_MS;
+        this.lagTimer = window.setInterval(() => {
+            const now = performance.now();
+            const lag = now - expected;
+            expected = now + LAG_INTERVAL_MS;
+            if (lag >= STALL_THRESHOLD_MS) this.recordStall('lag', now - lag, lag);
+            this.maybeUpgrade(now);
+        }, LAG_INTERVAL_MS);
+    }
+
+    stop(): void {
+        this.observer?.disconnect();
+        this.observer = null;
+        if (this.lagTimer !== null) {
+            window.clearInterval(this.lagTimer);
+            this.lagTimer = null;
+        }
+        this.started = false;
+    }
+
+    /**
+     * Record that `component` ran from `startMs` (performance.now()) until now.
+     * Call sites take the start time themselves so nothing is allocated.
+     */
+    span(component: WatchdogComponent, startMs: number, endMs: number = performance.now()): void {
+        const i = this.spanHead;
+        this.spanStarts[i] = startMs;
+        this.spanEnds[i] = endMs;
+        this.spanComponents[i] = COMPONENTS.indexOf(component);
+        this.spanHead = (i + 1) % SPAN_CAPACITY;
+    }
+
+    /**
+     * A step or trigger that was queued after its time had already passed
+     */
+    recordSchedulerMiss(): void {
+        this.missTimes[this.missHead] = performance.now();
+        this.missHead = (this.missHead + 1) % EVENT_CAPACITY;
+    }
+
+    /**
+     * A render-thread gap reported by the render watch worklet, ending now
+     */
+    recordUnderrun(gapMs: number): void {
+        this.underrunTimes[this.underrunHead] = performance.now() - gapMs;
+        this.underrunHead = (this.underrunHead + 1) % EVENT_CAPACITY;
+        if (__TRACE__) tracer.instant('watchdog', 'underrun', gapMs);
+    }
+
+    /**
+     * Most recent stalls first, with misses and underruns counted around each
+     */
+    getStalls(): StallRecord[] {
+        return this.stalls.map(stall => ({
+            ...stall,
+            schedulerMisses: this.countNear(this.missTimes, stall),
+            underruns: this.countNear(this.underrunTimes, stall)
+        })).reverse();
+    }
+
+    clear(): void {
+        this.stalls.length = 0;
+        this.missTimes.fill(-Infinity);
+        this.underrunTimes.fill(-Infinity);
+    }
+
+    // ============ Quality tiers ============
+
+    getQualityTier(): QualityTier {
+        return this.tier;
+    }
+
+    /**
+     * Draw one frame out of this many (canvas scenes)
+     */
+    getFrameStride(): number {
+        return FRAME_STRIDE[this.tier];
+    }
+
+    setQualityTier(tier: QualityTier): void {
+        if (tier === this.tier) return;
+        this.tier = tier;
+        this.lastTierChange = performance.now();
+        if (__TRACE__) tracer.instant('watchdog', 'qualityTier', TIERS.indexOf(tier));
+    }
+
+    setAutoDowngrade(enabled: boolean): void {
+        this.autoDowngrade = enabled;
+    }
+
+    isAutoDowngradeEnabled(): boolean {
+        return this.autoDowngrade;
+    }
+
+    // ============ Internals ============
+
+    private recordStall(kind: StallRecord['kind'], start: number, duration: number): void {
+        // A long task usually also shows up as loop lag: keep one record per stall
+        const last = this.stalls[this.stalls.length - 1];
+        if (last && start < last.start + last.duration && start + duration > last.start) {
+            if (kind === 'longtask') {
+                last.kind = kind;
+                last.start = start;
+                last.duration = duration;
+                last.culprit = this.attribute(start, start + duration);
+            }
+            return;
+        }
+
+        const stall: StallRecord = {
+            kind,
+            start,
+            duration,
+            culprit: this.attribute(start, start + duration),
+            schedulerMisses: 0,
+            underruns: 0
+        };
+        this.stalls.push(stall);
+        if (this.stalls.length > STALL_HISTORY) this.stalls.shift();
+        if (__TRACE__) tracer.instant('watchdog', 'stall', duration);
+
+        this.maybeDowngrade(start + duration);
+    }
+
+    /**
+     * The component whose spans overlap the stall the most
+     */
+    private attribute(start: number, end: number): StallRecord['culprit'] {
+        const overlap = new Float64Array(COMPONENTS.length);
+        for (let i = 0; i < SPAN_CAPACITY; i++) {
+            const shared = Math.min(end, this.spanEnds[i]) - Math.max(start, this.spanStarts[i]);
+            if (shared > 0) overlap[this.spanComponents[i]] += shared;
+        }
+
+        let best = -1;
+        let bestOverlap = 0;
+        for (let c = 0; c < COMPONENTS.length; c++) {
+            if (overlap[c] > bestOverlap) {
+                bestOverlap = overlap[c];
+                best = c;
+            }
+        }
+        return best >= 0 ? COMPONENTS[best] : 'unknown';
+    }
+
+    private countNear(times: Float64Array, stall: StallRecord): number {
+        const from = stall.start;
+        const to = stall.start + stall.duration + CORRELATION_WINDOW_MS;
+        let count = 0;
+        for (let i = 0; i < times.length; i++) {
+            if (times[i] >= from && times[i] <= to) count++;
+        }
+        return count;
+    }
+
+    private maybeDowngrade(now: number): void {
+        if (!this.autoDowngrade) return;
+        const recent = this.stalls.filter(stall => now - stall.start < DOWNGRADE_WINDOW_MS &&
+            stall.start > this.lastTierChange).length;
+        const index = TIERS.indexOf(this.tier);
+        if (recent >= DOWNGRADE_STALLS && index < TIERS.length - 1) {
+            this.setQualityTier(TIERS[index + 1]);
+        }
+    }
+
+    private maybeUpgrade(now: number): void {
+        if (!this.autoDowngrade || this.tier === 'high') return;
+        const last = this.stalls[this.stalls.length - 1];
+        const calmSince = Math.max(this.lastTierChange, last ? last.start + last.duration : 0);
+        if (now - calmSince > UPGRADE_CALM_MS) {
+            this.setQualityTier(TIERS[TIERS.indexOf(this.tier) - 1]);
+        }
+    }
+}
+
+export const watchdog = new MainThreadWatchdog();
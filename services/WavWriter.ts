@@ -0,0 +1,90 @@
+/**
+ * Streaming 16-bit PCM WAV writer.
+ *
+ * Frames are converted and written as they arrive, so memory use does not
+ * depend on the length of the file. The header is written with zero sizes
+ * first and patched in finish(), which is why the sink must be seekable
+ * (a FileSystemWritableFileStream from the origin private file system is).
+ */
+
+const HEADER_BYTES = 44;
+const BYTES_PER_SAMPLE = 2;
+// RIFF sizes are 32-bit
+const MAX_DATA_BYTES = 0xffffffff - HEADER_BYTES;
+
+export interface WavSink {
+    write(data: ArrayBuffer): Promise<void>;
+    seek(position: number): Promise<void>;
+    close(): Promise<void>;
+}
+
+export class WavWriter {
+    private readonly sink: WavSink;
+    private readonly sampleRate: number;
+    private readonly channels: number;
+    private dataBytes = 0;
+
+    constructor(sink: WavSink, sampleRate: number, channels: number = 2) {
+        this.sink = sink;
+        this.sampleRate = sampleRate;
+        this.channels = channels;
+    }
+
+    async begin(): Promise<void> {
+        await this.sink.write(this.header(0));
+    }
+
+    /**
+     * Append planar frames (one array per channel, all the same length).
+     * A mono source feeds every channel.
+     */
+    async write(frames: Float32Array[]): Promise<void> {
+        const length = frames[0]?.length ?? 0;
+        if (length === 0) return;
+        if (this.dataBytes + length * this.channels * BYTES_PER_SAMPLE > MAX_DATA_BYTES) {
+            throw new Error('WAV file would exceed 4 GB');
+        }
+
+        const pcm = new Int16Array(length * this.channels);
+        for (let ch = 0; ch < this.channels; ch++) {
+            const source = frames[ch] ?? frames[0];
+            for (let i = 0, j = ch; i < length; i++, j += this.channels) {
+                const x = Math.max(-1, Math.min(1, source[i]));
+                pcm[j] = Math.round(x * 32767);
+            }
+        }
+        await this.sink.write(pcm.buffer);
+        this.dataBytes += pcm.byteLength;
+    }
+
+    /** Patch the sizes into the header and close the sink */
+    async finish(): Promise<void> {
+        await this.sink.seek(0);
+        await this.sink.write(this.header(this.dataBytes));
+        await this.sink.close();
+    }
+
+    private header(dataBytes: number): ArrayBuffer {
+        const header = new ArrayBuffer(HEADER_BYTES);
+        const view = new DataView(header);
+        const blockAlign = this.channels * BYTES_PER_SAMPLE;
+        const tag = (offset: number, text: string) => {
+            for (let i = 0; i < 4; i++) view.setUint8(offset + i, text.charCodeAt(i));
+        };
+
+        tag(0, 'RIFF');
+        view.setUint32(4, 36 + dataBytes, true);
+        tag(8, 'WAVE');
+        tag(12, 'fmt ');
+        view.setUint32(16, 16, true);                           // fmt chunk size
+        view.setUint16(20, 1, true);                            // PCM
+        view.setUint16(22, this.channels, true);
+        view.setUint32(24, this.sampleRate, true);
+        view.setUint32(28, this.sampleRate * blockAlign, true); // Byte rate
+        view.setUint16(32, blockAlign, true);
+        view.setUint16(34, BYTES_PER_SAMPLE * 8, true);
+        tag(36, 'data');
+        view.setUint32(40, dataBytes, true);
+        return header;
+    }
+}
@@ -1,3 +1,6 @@
+import { watchdog } from './Watchdog';
+import { getSharedResource } from './SharedResources';
+
 /**
  * Utilidades de audio compartidas entre los diferentes engines.
  */
@@ -45,6 +48,7 @@ export function createReverbImpulse(
     duration: number = 2.0,
     decayPower: number = 2
 ): AudioBuffer {
+    const start = performance.now();
     const rate = ctx.sampleRate;
     const length = rate * duration;
     const impulse = ctx.createBuffer(2, length, rate);
@@ -56,6 +60,7 @@ export function createReverbImpulse(
             data[i] = (Math.random() * 2 - 1) * decay;
         }
     }
+    watchdog.span('ir', start);
     return impulse;
 }
 
@@ -73,3 +78,38 @@ export function createNoiseBuffer(ctx: AudioContext, duration: number = 2): Audi
     }
     return buffer;
 }
+
+// ============ Recursos compartidos ============
+// Versiones cacheadas por contexto: todas las instancias de un engine reciben el
+// mismo buffer o curva en lugar de generar una copia propia.
+
+const distortionCurves = new Map<string, Float32Array<ArrayBuffer>>();
+
+/**
+ * Curva de distorsión compartida (las curvas no dependen del contexto).
+ * WaveShaperNode copia la curva al asignarla, así que compartirla es seguro.
+ */
+export function sharedDistortionCurve(amount: number, samples: number = 44100): Float32Array<ArrayBuffer> {
+    const key = `${amount}:${samples}`;
+    let curve = distortionCurves.get(key);
+    if (!curve) {
+        curve = makeDistortionCurve(amount, samples);
+        distortionCurves.set(key, curve);
+    }
+    return curve;
+}
+
+/**
+ * Impulso de reverb compartido por contexto y parámetros.
+ */
+export function sharedReverbImpulse(ctx: AudioContext, duration: number = 2.0, decayPower: number = 2): AudioBuffer {
+    return getSharedResource(ctx, `reverb:${duration}:${decayPower}`, () => createReverbImpulse(ctx, duration, decayPower));
+}
+
+/**
+ * Tabla de ruido blanco compartida por contexto.
+ * Para golpes cortos, reproducir un tramo desde un offset aleatorio evita crear un buffer por nota.
+ */
+export function sharedNoiseBuffer(ctx: AudioContext, duration: number = 2): AudioBuffer {
+    return getSharedResource(ctx, `noise:${duration}`, () => createNoiseBuffer(ctx, duration));
+}
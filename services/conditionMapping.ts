@@ -0,0 +1,17 @@
+import { PlanetaryCondition, SynthState } from '../types';
+
+const clamp = (v: number) => Math.max(0, Math.min(1, v));
+
+/**
+ * Map an oracle condition onto the five synth parameters.
+ * Shared by single-engine patches and whole scenes.
+ */
+export function conditionToSynthState(condition: PlanetaryCondition): SynthState {
+    return {
+        turbulence: clamp(condition.stormLevel ?? 0.5),
+        viscosity: clamp(condition.methaneDensity ?? 0.5),
+        pressure: clamp(condition.temperature ?? 0.5),
+        resonance: clamp(0.5 + ((condition.stormLevel ?? 0.5) * 0.5)),
+        diffusion: clamp(0.3 + ((condition.methaneDensity ?? 0.5) * 0.4))
+    };
+}
@@ -0,0 +1,356 @@
+/**
+ * Additive "ghost harmonics" bank.
+ * Up to 512 sine partials shared by all voices, each one a recursive
+ * rotation-matrix oscillator: one complex multiply per sample, no table
+ * lookups and no nodes. Spectra are recomputed once per block (k-rate);
+ * amplitudes ramp linearly across the block so shape changes never click.
+ *
+ * Every voice owns a fixed slice of the pool: harmonic partials plus a few
+ * inharmonic "ghost" partials whose ratios and levels drift slowly.
+ *
+ * A voice can be bound to an expression lane: a few floats in a block written
+ * by the UI (one lane per finger) and read here once per block, giving the
+ * voice its own gliding pitch, brightness and pressure.
+ *
+ * The other voices can follow an external pitch (a tracked voice): each one
+ * is transposed by pitch / FOLLOW_REFERENCE_HZ, so a chord played on the keys
+ * moves in parallel with the singer.
+ */
+
+export const MAX_PARTIALS = 512;
+export const MAX_VOICES = 16;
+export const PARTIALS_PER_VOICE = MAX_PARTIALS / MAX_VOICES;
+
+const HARMONICS = 24;
+const GHOSTS = PARTIALS_PER_VOICE - HARMONICS;
+
+/** Fingers on the touch surface; each lane is EXPRESSION_STRIDE floats */
+export const EXPRESSION_LANES = 10;
+/** Per lane: frequency (Hz), brightness (0..1), pressure (0..1) */
+export const EXPRESSION_STRIDE = 3;
+
+const ATTACK_TIME = 0.05;
+// Smoothing of lane values, so pitch glides and the block-rate steps never zipper
+const EXPRESSION_TIME = 0.012;
+// Smoothing of the followed pitch; the tracker already ramps, this only hides the block steps
+const FOLLOW_TIME = 0.005;
+/** Followed pitch at which voices sound as played (C3) */
+export const FOLLOW_REFERENCE_HZ = 130.81;
+const SWEEP_TIME = 1.5;
+const VOICE_LEVEL = 0.25;
+
+export interface AdditiveShape {
+    /** Brightness: flattens the spectral tilt and opens the cutoff */
+    pressure: number;
+    /** Height and position of the formant bump */
+    resonance: number;
+    /** Level, drift speed and spread of the ghost partials */
+    turbulence: number;
+}
+
+export class AdditiveBankKernel {
+    private readonly sampleRate: number;
+    private readonly nyquistLimit: number;
+
+    // Partial oscillators (rotation state and per-block coefficients)
+    private readonly re = new Float64Array(MAX_PARTIALS);
+    private readonly im = new Float64Array(MAX_PARTIALS);
+    private readonly cosW = new Float64Array(MAX_PARTIALS);
+    private readonly sinW = new Float64Array(MAX_PARTIALS);
+    private readonly amp = new Float32Array(MAX_PARTIALS);
+    private readonly target = new Float32Array(MAX_PARTIALS);
+    private readonly detune = new Float32Array(MAX_PARTIALS);
+    private readonly weights = new Float32Array(PARTIALS_PER_VOICE);
+
+    // Ghost partial drift (per voice slice)
+    private readonly ghostRatio = new Float32Array(MAX_VOICES * GHOSTS);
+    private readonly ghostDrift = new Float32Array(MAX_VOICES * GHOSTS);
+    private readonly ghostDriftTarget = new Float32Array(MAX_VOICES * GHOSTS);
+    private readonly ghostPhase = new Float32Array(MAX_VOICES * GHOSTS);
+
+    // Voices
+    private readonly voiceId = new Int32Array(MAX_VOICES);
+    private readonly voiceFreq = new Float32Array(MAX_VOICES);
+    private readonly voiceVelocity = new Float32Array(MAX_VOICES);
+    private readonly voiceEnv = new Float32Array(MAX_VOICES);
+    private readonly voiceReleaseStep = new Float32Array(MAX_VOICES);
+    private readonly voiceAge = new Float32Array(MAX_VOICES);
+    private readonly voiceGate = new Uint8Array(MAX_VOICES);
+    private readonly voiceActive = new Uint8Array(MAX_VOICES);
+    // Expression lane per voice (-1: none) and its smoothed values
+    private readonly voiceLane = new Int8Array(MAX_VOICES).fill(-1);
+    private readonly voiceBrightness = new Float32Array(MAX_VOICES);
+    private readonly voicePressure = new Float32Array(MAX_VOICES);
+
+    private expression: Float32Array | null = null;
+    // Transposition of non-lane voices by the followed pitch (1: not following)
+    private followTarget = 1;
+    private followRatio = 1;
+
+    private seed = 0x2545f491;
+
+    constructor(sampleRate: number) {
+        this.sampleRate = sampleRate;
+        this.nyquistLimit = sampleRate * 0.45;
+    }
+
+    /**
+     * Attach the expression block (EXPRESSION_LANES * EXPRESSION_STRIDE floats).
+     * It may be shared memory the UI writes to, or a copy posted each frame.
+     */
+    setExpression(values: Float32Array): void {
+        this.expression = values;
+    }
+
+    /**
+     * Restart the phase, detune and ghost sequence, so a replay or render draws the same voices
+     */
+    setSeed(seed: number): void {
+        this.seed = (seed >>> 0) || 0x2545f491;
+    }
+
+    /**
+     * Pitch to follow, in Hz, or 0 to play voices as they were triggered
+     */
+    setFollow(frequency: number): void {
+        this.followTarget = frequency > 0 ? frequency / FOLLOW_REFERENCE_HZ : 1;
+    }
+
+    /**
+     * @param lane - Expression lane that drives this voice until its noteOff, or -1
+     */
+    noteOn(id: number, frequency: number, velocity: number, lane: number = -1): void {
+        const v = this.allocateVoice();
+        this.voiceId[v] = id;
+        this.voiceFreq[v] = frequency;
+        this.voiceLane[v] = lane >= 0 && lane < EXPRESSION_LANES ? lane : -1;
+        this.voiceBrightness[v] = 0.5;
+        this.voicePressure[v] = 1;
+        if (this.voiceLane[v] >= 0) this.readLane(v, 1);
+        this.voiceVelocity[v] = velocity;
+        this.voiceEnv[v] = 0;
+        this.voiceAge[v] = 0;
+        this.voiceGate[v] = 1;
+        this.voiceActive[v] = 1;
+
+        const base = v * PARTIALS_PER_VOICE;
+        for (let k = 0; k < PARTIALS_PER_VOICE; k++) {
+            const p = base + k;
+            // Random start phase so stacked partials don't all peak together
+            const phase = this.random() * 2 * Math.PI;
+            this.re[p] = Math.cos(phase);
+            this.im[p] = Math.sin(phase);
+            this.amp[p] = 0;
+            // Slight per-partial detune (±8 cents) for the icy beating
+            this.detune[p] = Math.pow(2, ((this.random() * 2 - 1) * 8) / 1200);
+        }
+
+        for (let g = 0; g < GHOSTS; g++) {
+            const i = v * GHOSTS + g;
+            // Ghosts sit between harmonics n and n+1 (n = 1..10), never on them
+            this.ghostRatio[i] = 1 + Math.floor(this.random() * 10) + 0.2 + this.random() * 0.6;
+            this.ghostDrift[i] = 0;
+            this.ghostDriftTarget[i] = 0;
+            this.ghostPhase[i] = this.random() * 2 * Math.PI;
+        }
+    }
+
+    noteOff(id: number, releaseSeconds: number): void {
+        const step = 1 / Math.max(0.01, releaseSeconds * this.sampleRate);
+        for (let v = 0; v < MAX_VOICES; v++) {
+            if (this.voiceActive[v] && this.voiceGate[v] && this.voiceId[v] === id) {
+                this.voiceGate[v] = 0;
+                this.voiceReleaseStep[v] = step;
+                // The lane goes to the next finger; the tail keeps its last values
+                this.voiceLane[v] = -1;
+            }
+        }
+    }
+
+    allNotesOff(): void {
+        for (let v = 0; v < MAX_VOICES; v++) {
+            this.voiceActive[v] = 0;
+            this.voiceGate[v] = 0;
+            this.voiceLane[v] = -1;
+        }
+        this.amp.fill(0);
+    }
+
+    /**
+     * Render one block (mono). Always overwrites the output.
+     */
+    process(out: Float32Array, shape: AdditiveShape): void {
+        out.fill(0);
+        const blockLength = out.length;
+        this.followRatio += (this.followTarget - this.followRatio) * (1 - Math.exp(-blockLength / (this.sampleRate * FOLLOW_TIME)));
+
+        for (let v = 0; v < MAX_VOICES; v++) {
+            if (!this.voiceActive[v]) continue;
+
+            this.updateVoice(v, blockLength, shape);
+
+            const base = v * PARTIALS_PER_VOICE;
+            for (let p = base; p < base + PARTIALS_PER_VOICE; p++) {
+                let a = this.amp[p];
+                const aEnd = this.target[p];
+                if (a === 0 && aEnd === 0) continue;
+
+                const da = (aEnd - a) / blockLength;
+                const c = this.cosW[p];
+                const s = this.sinW[p];
+                let re = this.re[p];
+                let im = this.im[p];
+                for (let i = 0; i < blockLength; i++) {
+                    out[i] += im * a;
+                    a += da;
+                    const nextRe = re * c - im * s;
+                    im = re * s + im * c;
+                    re = nextRe;
+                }
+                // First-order renormalisation keeps the rotation on the unit circle
+                const g = 1.5 - 0.5 * (re * re + im * im);
+                this.re[p] = re * g;
+                this.im[p] = im * g;
+                this.amp[p] = aEnd;
+            }
+
+            if (!this.voiceGate[v] && this.voiceEnv[v] <= 0) {
+                this.voiceActive[v] = 0;
+                this.amp.fill(0, base, base + PARTIALS_PER_VOICE);
+            }
+        }
+    }
+
+    /**
+     * Envelope, spectrum and oscillator coefficients for one voice (once per block).
+     */
+    private updateVoice(v: number, blockLength: number, shape: AdditiveShape): void {
+        const blockSeconds = blockLength / this.sampleRate;
+
+        // Linear attack / release, evaluated at the end of the block
+        let env = this.voiceEnv[v];
+        if (this.voiceGate[v]) {
+            env = Math.min(1, env + blockSeconds / ATTACK_TIME);
+        } else {
+            env = Math.max(0, env - this.voiceReleaseStep[v] * blockLength);
+        }
+        this.voiceEnv[v] = env;
+        this.voiceAge[v] += blockSeconds;
+
+        if (this.voiceLane[v] >= 0) {
+            this.readLane(v, 1 - Math.exp(-blockSeconds / EXPRESSION_TIME));
+        }
+        const brightness = this.voiceBrightness[v];
+
+        // Lane voices have their own pitch; the rest follow the external one
+        const f0 = this.voiceLane[v] >= 0 ? this.voiceFreq[v] : this.voiceFreq[v] * this.followRatio;
+        const base = v * PARTIALS_PER_VOICE;
+        const weights = this.weights;
+
+        // Cutoff sweeps open over the first 1.5 s (like the old per-note filter), pressure lifts it
+        const sweep = Math.min(1, this.voiceAge[v] / SWEEP_TIME);
+        // Voice brightness (0.5 when not expressive) scales the cutoff and tilt around the global shape
+        const cutoff = f0 * (0.8 + 2.2 * sweep) * (1 + shape.pressure * 4) * (0.25 + brightness * 1.5);
+        const tilt = 1.6 - shape.pressure * 0.9 + (0.5 - brightness) * 0.8;
+        const formantCentre = 2 + shape.resonance * 10;
+        const formantGain = shape.resonance * 3;
+        const ghostLevel = shape.turbulence * 0.6;
+        const driftRate = (0.05 + shape.turbulence * 0.5) * blockSeconds;
+
+        let weightSum = 1e-6;
+        for (let k = 0; k < PARTIALS_PER_VOICE; k++) {
+            let ratio: number;
+            let level: number;
+            if (k < HARMONICS) {
+                ratio = k + 1;
+                level = 1;
+            } else {
+                const i = v * GHOSTS + (k - HARMONICS);
+                // Random-walk drift towards a new target, re-picked when reached
+                const drift = this.ghostDrift[i];
+                const driftTarget = this.ghostDriftTarget[i];
+                const delta = driftTarget - drift;
+                if (Math.abs(delta) < driftRate) {
+                    this.ghostDriftTarget[i] = (this.random() * 2 - 1) * (0.1 + shape.turbulence * 0.4);
+                } else {
+                    this.ghostDrift[i] = drift + (delta > 0 ? driftRate : -driftRate);
+                }
+                this.ghostPhase[i] += 2 * Math.PI * (0.05 + shape.turbulence * 0.4) * blockSeconds;
+                // Drift wanders, but not onto the harmonics either side
+                const harmonic = Math.floor(this.ghostRatio[i]);
+                ratio = Math.min(harmonic + 0.9, Math.max(harmonic + 0.1, this.ghostRatio[i] + this.ghostDrift[i]));
+                level = ghostLevel * (0.5 + 0.5 * Math.sin(this.ghostPhase[i]));
+            }
+
+            const freq = f0 * ratio * this.detune[base + k];
+            if (freq >= this.nyquistLimit || level <= 0) {
+                weights[k] = 0;
+                this.setFrequency(base + k, Math.min(freq, this.nyquistLimit));
+                continue;
+            }
+
+            const x = freq / cutoff;
+            const d = ratio - formantCentre;
+            let w = level * Math.pow(ratio, -tilt);
+            w /= 1 + x * x * x * x;
+            w *= 1 + formantGain * Math.exp(-d * d * 0.25);
+            weights[k] = w;
+            weightSum += w;
+
+            this.setFrequency(base + k, freq);
+        }
+
+        // Normalise so brightness changes don't change loudness
+        const scale = (env * this.voiceVelocity[v] * this.voicePressure[v] * VOICE_LEVEL) / weightSum;
+        for (let k = 0; k < PARTIALS_PER_VOICE; k++) {
+            this.target[base + k] = weights[k] * scale;
+        }
+    }
+
+    /**
+     * Move a voice's frequency, brightness and pressure towards its lane's values
+     * @param k - Smoothing coefficient, 1 to jump
+     */
+    private readLane(v: number, k: number): void {
+        const values = this.expression;
+        if (!values) return;
+        const i = this.voiceLane[v] * EXPRESSION_STRIDE;
+        const frequency = values[i];
+        if (frequency > 0) this.voiceFreq[v] += (frequency - this.voiceFreq[v]) * k;
+        this.voiceBrightness[v] += (values[i + 1] - this.voiceBrightness[v]) * k;
+        this.voicePressure[v] += (values[i + 2] - this.voicePressure[v]) * k;
+    }
+
+    private setFrequency(p: number, freq: number): void {
+        const w = (2 * Math.PI * freq) / this.sampleRate;
+        this.cosW[p] = Math.cos(w);
+        this.sinW[p] = Math.sin(w);
+    }
+
+    private allocateVoice(): number {
+        for (let v = 0; v < MAX_VOICES; v++) {
+            if (!this.voiceActive[v]) return v;
+        }
+        // Steal the quietest voice, preferring released ones
+        let victim = 0;
+        let lowest = Infinity;
+        for (let v = 0; v < MAX_VOICES; v++) {
+            const score = this.voiceEnv[v] + this.voiceGate[v];
+            if (score < lowest) {
+                lowest = score;
+                victim = v;
+            }
+        }
+        return victim;
+    }
+
+    private random(): number {
+        // xorshift32
+        let x = this.seed;
+        x ^= x << 13;
+        x ^= x >>> 17;
+        x ^= x << 5;
+        this.seed = x >>> 0;
+        return this.seed / 4294967296;
+    }
+}
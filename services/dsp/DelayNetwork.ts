@@ -0,0 +1,203 @@
+/**
+ * Modulated multi-tap feedback delay kernel.
+ *
+ * The feedback loop runs per sample inside the kernel, so delays go down to a
+ * single sample (combs, flangers) instead of the one-quantum minimum a
+ * DelayNode/GainNode cycle has. Reads are cubic-interpolated, which keeps
+ * modulated times from aliasing; the loop is damped by a one-pole low-pass and
+ * optionally saturated.
+ *
+ * With nothing connected to its input the kernel keeps rendering until the
+ * loop has decayed, then idles (silent output, no per-sample work) until
+ * input returns, so a disconnected send costs nothing.
+ */
+
+export const MAX_TAPS = 4;
+
+// Extra taps (below the main one) play at this gain
+const SUB_TAP_GAIN = 0.5;
+
+// Output below this (about -100 dBFS) counts as decayed
+const SILENCE = 1e-5;
+
+export interface DelayNetworkParams {
+    /** Main tap time in seconds */
+    time: number;
+    /** Loop gain, 0..0.98 */
+    feedback: number;
+    /** Modulation depth in seconds, either side of `time` */
+    modDepth: number;
+    /** Modulation rate in Hz */
+    modRate: number;
+    /** Loop low-pass cutoff in Hz */
+    damping: number;
+    /** Loop saturation, 0 = clean */
+    drive: number;
+    /** Number of evenly spaced taps within the main time (1 = plain delay) */
+    taps: number;
+}
+
+export class DelayNetworkKernel {
+    private readonly sampleRate: number;
+    private readonly size: number;
+    private readonly buffers: Float32Array[];
+    private writeIndex = 0;
+
+    // Smoothed state
+    private delaySamples = -1;
+    private readonly dampState: Float64Array;
+    private lfoPhase = 0;
+
+    // Input-less silent samples so far, and whether the loop has decayed
+    private silentSamples = 0;
+    private idle = false;
+
+    constructor(sampleRate: number, maxSeconds: number, channels: number = 2) {
+        this.sampleRate = sampleRate;
+        // Room for the longest delay, the deepest modulation and the interpolation taps
+        this.size = Math.ceil(maxSeconds * sampleRate) + 4;
+        this.buffers = Array.from({ length: channels }, () => new Float32Array(this.size));
+        this.dampState = new Float64Array(channels);
+    }
+
+    /**
+     * Render one block. `input` may have fewer channels than the kernel
+     * (mono input feeds every channel); an empty array means nothing is connected.
+     */
+    process(input: Float32Array[], output: Float32Array[], params: DelayNetworkParams): void {
+        if (input.length > 0) {
+            this.idle = false;
+            this.silentSamples = 0;
+        } else if (this.idle) {
+            output.forEach(channel => channel.fill(0));
+            return;
+        }
+
+        const n = output[0].length;
+        const channels = Math.min(this.buffers.length, output.length);
+        const sr = this.sampleRate;
+        const size = this.size;
+
+        const maxDelay = size - 4;
+        const target = Math.min(maxDelay, Math.max(1, params.time * sr));
+        if (this.delaySamples < 0) this.delaySamples = target;
+        // ~20 ms glide on time changes, like a tape head moving
+        const glide = 1 - Math.exp(-1 / (0.02 * sr));
+
+        const feedback = Math.min(0.98, Math.max(0, params.feedback));
+        const modDepth = Math.max(0, params.modDepth * sr);
+        const lfoIncrement = 2 * Math.PI * Math.max(0, params.modRate) / sr;
+        const dampCoeff = 1 - Math.exp(-2 * Math.PI * Math.min(params.damping, sr * 0.45) / sr);
+        const drive = Math.max(0, params.drive) * 4;
+        const taps = Math.max(1, Math.min(MAX_TAPS, Math.round(params.taps)));
+
+        let delay = this.delaySamples;
+        let phase = this.lfoPhase;
+        let w = this.writeIndex;
+
+        for (let i = 0; i < n; i++) {
+            delay += glide * (target - delay);
+            // Swings either side of the set time, so modulation leaves the average delay alone
+            const modulated = Math.min(maxDelay, Math.max(1, delay + modDepth * Math.sin(phase)));
+            phase += lfoIncrement;
+            if (phase > 2 * Math.PI) phase -= 2 * Math.PI;
+
+            for (let ch = 0; ch < channels; ch++) {
+                const buffer = this.buffers[ch];
+                const source = ch < input.length ? input[ch] : input[0];
+                const x = source ? source[i] : 0;
+
+                // Main tap closes the loop
+                const main = this.read(buffer, w, modulated);
+                let damped = this.dampState[ch] + dampCoeff * (main - this.dampState[ch]);
+                this.dampState[ch] = damped;
+                if (drive > 0) damped = Math.tanh(damped * (1 + drive)) / (1 + drive);
+                buffer[w] = x + damped * feedback;
+
+                // Sub-taps at k/taps of the main time (a beat subdivided when time is a beat)
+                let out = main;
+                for (let k = 1; k < taps; k++) {
+                    out += SUB_TAP_GAIN * this.read(buffer, w, Math.max(1, modulated * k / taps));
+                }
+                output[ch][i] = out;
+            }
+
+            w = w + 1 === size ? 0 : w + 1;
+        }
+
+        // Channels the kernel does not own mirror the first one
+        for (let ch = channels; ch < output.length; ch++) output[ch].set(output[0]);
+
+        this.delaySamples = delay;
+        this.lfoPhase = phase;
+        this.writeIndex = w;
+
+        if (input.length === 0) this.trackDecay(output, Math.min(maxDelay, delay + modDepth) + 4);
+    }
+
+    isIdle(): boolean {
+        return this.idle;
+    }
+
+    reset(): void {
+        this.buffers.forEach(buffer => buffer.fill(0));
+        this.dampState.fill(0);
+        this.delaySamples = -1;
+        this.silentSamples = 0;
+    }
+
+    /**
+     * Go idle once the output has stayed silent for longer than the furthest
+     * read: everything the loop can still play back is then silent too.
+     */
+    private trackDecay(output: Float32Array[], reach: number): void {
+        let peak = 0;
+        for (let ch = 0; ch < output.length; ch++) {
+            const channel = output[ch];
+            for (let i = 0; i < channel.length; i++) {
+                const level = Math.abs(channel[i]);
+                if (level > peak) peak = level;
+            }
+        }
+
+        if (peak >= SILENCE) {
+            this.silentSamples = 0;
+            return;
+        }
+        this.silentSamples += output[0].length;
+        if (this.silentSamples > reach) {
+            this.reset();
+            this.idle = true;
+        }
+    }
+
+    /**
+     * Read `delay` samples behind the write head (not yet written this sample).
+     * Cubic Hermite where four neighbours exist, linear right next to the head.
+     */
+    private read(buffer: Float32Array, writeIndex: number, delay: number): number {
+        const size = this.size;
+        const whole = Math.floor(delay);
+        const frac = delay - whole;
+
+        let i1 = writeIndex - whole;
+        if (i1 < 0) i1 += size;
+        let i2 = i1 - 1;
+        if (i2 < 0) i2 += size;
+
+        if (whole < 2) {
+            return buffer[i1] + frac * (buffer[i2] - buffer[i1]);
+        }
+
+        let i0 = i1 + 1;
+        if (i0 >= size) i0 -= size;
+        let i3 = i2 - 1;
+        if (i3 < 0) i3 += size;
+
+        const y0 = buffer[i0], y1 = buffer[i1], y2 = buffer[i2], y3 = buffer[i3];
+        const c1 = 0.5 * (y2 - y0);
+        const c2 = y0 - 2.5 * y1 + 2 * y2 - 0.5 * y3;
+        const c3 = 0.5 * (y3 - y0) + 1.5 * (y1 - y2);
+        return ((c3 * frac + c2) * frac + c1) * frac + y1;
+    }
+}
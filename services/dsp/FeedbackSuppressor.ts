@@ -0,0 +1,367 @@
+/**
+ * Adaptive feedback (howl) suppressor.
+ * A bank of narrow notch filters sits in line with the signal and adds no
+ * latency. A side-chain analysis of the filtered output looks for howl: a
+ * spectral peak that towers over the frame's mean and its neighbours, has no
+ * harmonics of its own (howl is close to a pure tone) and persists while
+ * steady or growing for several frames. A confirmed howl gets a notch, or
+ * deepens the notch already there. Notches recover slowly once it is gone, so
+ * the bank adapts as the performer and speakers move.
+ */
+
+export const MAX_NOTCHES = 8;
+
+const FFT_SIZE = 2048;
+const HOP = 512;
+const MIN_HZ = 100;
+const MAX_HZ = 10000;
+
+const FLOOR_DB = -60;               // Quieter peaks are never howl
+const PAPR_DB = 25;                 // Peak over the band's (geometric) mean power
+const PNPR_DB = 15;                 // Peak over its neighbours (3 to 8 bins away)
+const PHPR_DB = 15;                 // Peak over its second harmonic
+const CONFIRM_FRAMES = 5;           // ~53 ms at 48 kHz
+const GROWTH_DB = 0.3;              // Average rise per frame that marks howl building up
+const STEADY_FRAMES = 15;           // ...or this long without decaying
+const STEADY_PAPR_DB = 40;          // ...when the peak is this dominant
+
+const NOTCH_Q = 40;
+const FIRST_DEPTH_DB = -12;
+const DEEPEN_DB = -6;
+const MAX_DEPTH_DB = -30;
+const MERGE_RATIO = 1.02;           // Howl this close to a notch deepens it
+const SLEW_DB_PER_SECOND = 120;     // Depth changes ramp, so notches never click
+const RELEASE_DB_PER_SECOND = 0.25;
+
+const MAX_CANDIDATES = 16;
+const MAX_CHANNELS = 2;
+
+export interface NotchInfo {
+    frequency: number;
+    depthDb: number;
+}
+
+export class FeedbackSuppressorKernel {
+    private readonly sampleRate: number;
+
+    // Analysis
+    private readonly ring = new Float32Array(FFT_SIZE);
+    private ringPos = 0;
+    private sinceHop = 0;
+    private readonly window = new Float32Array(FFT_SIZE);
+    private readonly re = new Float32Array(FFT_SIZE);
+    private readonly im = new Float32Array(FFT_SIZE);
+    private readonly power = new Float32Array(FFT_SIZE / 2 + 1);
+    private readonly cosTable = new Float32Array(FFT_SIZE / 2);
+    private readonly sinTable = new Float32Array(FFT_SIZE / 2);
+    private readonly bitReverse = new Uint16Array(FFT_SIZE);
+    private readonly minBin: number;
+    private readonly maxBin: number;
+
+    // Howl candidates, tracked across frames by bin
+    private readonly candidateBin = new Int32Array(MAX_CANDIDATES).fill(-1);
+    private readonly candidateFrames = new Int32Array(MAX_CANDIDATES);
+    private readonly candidateFirstDb = new Float32Array(MAX_CANDIDATES);
+    private readonly candidateLastDb = new Float32Array(MAX_CANDIDATES);
+    private readonly candidateSeen = new Uint8Array(MAX_CANDIDATES);
+
+    // Notch bank: RBJ peaking filters with negative gain
+    private readonly notchFreq = new Float32Array(MAX_NOTCHES);
+    private readonly notchDepth = new Float32Array(MAX_NOTCHES);
+    private readonly notchTarget = new Float32Array(MAX_NOTCHES);
+    private readonly notchActive = new Uint8Array(MAX_NOTCHES);
+    private readonly b0 = new Float64Array(MAX_NOTCHES);
+    private readonly b1 = new Float64Array(MAX_NOTCHES);
+    private readonly b2 = new Float64Array(MAX_NOTCHES);
+    private readonly a1 = new Float64Array(MAX_NOTCHES);
+    private readonly a2 = new Float64Array(MAX_NOTCHES);
+    private readonly z1 = new Float64Array(MAX_NOTCHES * MAX_CHANNELS);
+    private readonly z2 = new Float64Array(MAX_NOTCHES * MAX_CHANNELS);
+
+    private changed = false;
+
+    constructor(sampleRate: number) {
+        this.sampleRate = sampleRate;
+        const binHz = sampleRate / FFT_SIZE;
+        this.minBin = Math.max(2, Math.floor(MIN_HZ / binHz));
+        this.maxBin = Math.min(FFT_SIZE / 2 - 9, Math.ceil(Math.min(MAX_HZ, sampleRate * 0.45) / binHz));
+
+        for (let i = 0; i < FFT_SIZE; i++) {
+            this.window[i] = 0.5 - 0.5 * Math.cos((2 * Math.PI * i) / FFT_SIZE);
+        }
+        for (let i = 0; i < FFT_SIZE / 2; i++) {
+            this.cosTable[i] = Math.cos((2 * Math.PI * i) / FFT_SIZE);
+            this.sinTable[i] = Math.sin((2 * Math.PI * i) / FFT_SIZE);
+        }
+        const bits = Math.log2(FFT_SIZE);
+        for (let i = 0; i < FFT_SIZE; i++) {
+            let r = 0;
+            for (let b = 0; b < bits; b++) r |= ((i >> b) & 1) << (bits - 1 - b);
+            this.bitReverse[i] = r;
+        }
+    }
+
+    /**
+     * Filter one block in place (each channel through the same notches),
+     * then feed the first channel to the analysis.
+     */
+    process(channels: Float32Array[]): void {
+        const blockLength = channels[0].length;
+        this.updateNotches(blockLength);
+
+        const count = Math.min(channels.length, MAX_CHANNELS);
+        for (let n = 0; n < MAX_NOTCHES; n++) {
+            if (!this.notchActive[n]) continue;
+            const b0 = this.b0[n], b1 = this.b1[n], b2 = this.b2[n], a1 = this.a1[n], a2 = this.a2[n];
+            for (let ch = 0; ch < count; ch++) {
+                const data = channels[ch];
+                const s = n * MAX_CHANNELS + ch;
+                let z1 = this.z1[s];
+                let z2 = this.z2[s];
+                // Transposed direct form II
+                for (let i = 0; i < blockLength; i++) {
+                    const x = data[i];
+                    const y = b0 * x + z1;
+                    z1 = b1 * x - a1 * y + z2;
+                    z2 = b2 * x - a2 * y;
+                    data[i] = y;
+                }
+                this.z1[s] = z1;
+                this.z2[s] = z2;
+            }
+        }
+
+        const input = channels[0];
+        for (let i = 0; i < blockLength; i++) {
+            this.ring[this.ringPos] = input[i];
+            this.ringPos = (this.ringPos + 1) % FFT_SIZE;
+        }
+        this.sinceHop += blockLength;
+        if (this.sinceHop >= HOP) {
+            this.sinceHop -= HOP;
+            this.analyse();
+        }
+    }
+
+    /** Active notches, deepest first */
+    getNotches(): NotchInfo[] {
+        const notches: NotchInfo[] = [];
+        for (let n = 0; n < MAX_NOTCHES; n++) {
+            if (this.notchActive[n]) notches.push({ frequency: this.notchFreq[n], depthDb: this.notchTarget[n] });
+        }
+        return notches.sort((a, b) => a.depthDb - b.depthDb);
+    }
+
+    /** True once after a notch was added, deepened or freed */
+    takeChanged(): boolean {
+        const changed = this.changed;
+        this.changed = false;
+        return changed;
+    }
+
+    /** Forget every notch (e.g. after moving to another room) */
+    reset(): void {
+        this.notchActive.fill(0);
+        this.z1.fill(0);
+        this.z2.fill(0);
+        this.candidateBin.fill(-1);
+        this.changed = true;
+    }
+
+    private updateNotches(blockLength: number): void {
+        const seconds = blockLength / this.sampleRate;
+        const slew = SLEW_DB_PER_SECOND * seconds;
+        for (let n = 0; n < MAX_NOTCHES; n++) {
+            if (!this.notchActive[n]) continue;
+
+            // Recover slowly; deepening happens in analyse()
+            const target = Math.min(0, this.notchTarget[n] + RELEASE_DB_PER_SECOND * seconds);
+            this.notchTarget[n] = target;
+            const depth = this.notchDepth[n];
+            if (depth === target) continue;
+
+            const next = depth < target ? Math.min(target, depth + slew) : Math.max(target, depth - slew);
+            this.notchDepth[n] = next;
+            if (next > -0.05 && target > -0.05) {
+                this.notchActive[n] = 0;
+                this.changed = true;
+                continue;
+            }
+            this.setCoefficients(n, next);
+        }
+    }
+
+    private setCoefficients(n: number, depthDb: number): void {
+        const w0 = (2 * Math.PI * this.notchFreq[n]) / this.sampleRate;
+        const cos = Math.cos(w0);
+        const alpha = Math.sin(w0) / (2 * NOTCH_Q);
+        const A = Math.pow(10, depthDb / 40);
+        const a0 = 1 + alpha / A;
+        this.b0[n] = (1 + alpha * A) / a0;
+        this.b1[n] = (-2 * cos) / a0;
+        this.b2[n] = (1 - alpha * A) / a0;
+        this.a1[n] = (-2 * cos) / a0;
+        this.a2[n] = (1 - alpha / A) / a0;
+    }
+
+    private analyse(): void {
+        const re = this.re;
+        const im = this.im;
+        for (let i = 0; i < FFT_SIZE; i++) {
+            const sample = this.ring[(this.ringPos + i) % FFT_SIZE] * this.window[i];
+            const j = this.bitReverse[i];
+            re[j] = sample;
+            im[j] = 0;
+        }
+        this.fft(re, im);
+
+        const power = this.power;
+        let mean = 0;
+        for (let k = 0; k <= FFT_SIZE / 2; k++) {
+            power[k] = re[k] * re[k] + im[k] * im[k];
+        }
+        // Geometric mean: a strong peak cannot raise its own reference much
+        for (let k = this.minBin; k <= this.maxBin; k++) mean += Math.log(power[k] + 1e-30);
+        mean = Math.exp(mean / (this.maxBin - this.minBin + 1));
+
+        // Full-scale sine through a Hann window: (N/4)^2
+        const reference = (FFT_SIZE / 4) * (FFT_SIZE / 4);
+        const floor = reference * Math.pow(10, FLOOR_DB / 10);
+        const papr = Math.pow(10, PAPR_DB / 10);
+        const pnpr = Math.pow(10, PNPR_DB / 10);
+        const phpr = Math.pow(10, PHPR_DB / 10);
+
+        this.candidateSeen.fill(0);
+        for (let k = this.minBin; k <= this.maxBin; k++) {
+            const p = power[k];
+            if (p < floor || p < mean * papr || p <= power[k - 1] || p < power[k + 1]) continue;
+
+            let neighbours = 0;
+            for (let d = 3; d <= 8; d++) {
+                neighbours = Math.max(neighbours, power[k - d], power[k + d]);
+            }
+            if (p < neighbours * pnpr) continue;
+
+            const h = 2 * k;
+            if (h < FFT_SIZE / 2 && p < Math.max(power[h - 1], power[h], power[h + 1]) * phpr) continue;
+
+            this.track(k, 10 * Math.log10(p / reference), p / Math.max(mean, 1e-20));
+        }
+
+        for (let c = 0; c < MAX_CANDIDATES; c++) {
+            if (!this.candidateSeen[c]) this.candidateBin[c] = -1;
+        }
+    }
+
+    private track(bin: number, levelDb: number, paprRatio: number): void {
+        let slot = -1;
+        let free = -1;
+        for (let c = 0; c < MAX_CANDIDATES; c++) {
+            const b = this.candidateBin[c];
+            if (b >= 0 && Math.abs(b - bin) <= 1) {
+                slot = c;
+                break;
+            }
+            if (b < 0 && free < 0) free = c;
+        }
+
+        if (slot < 0) {
+            if (free < 0) return;
+            slot = free;
+            this.candidateFrames[slot] = 0;
+            this.candidateFirstDb[slot] = levelDb;
+        }
+        this.candidateBin[slot] = bin;
+        this.candidateSeen[slot] = 1;
+        this.candidateFrames[slot]++;
+        this.candidateLastDb[slot] = levelDb;
+
+        const frames = this.candidateFrames[slot];
+        if (frames < CONFIRM_FRAMES) return;
+        const slope = (levelDb - this.candidateFirstDb[slot]) / (frames - 1);
+        const growing = slope >= GROWTH_DB;
+        const steady = frames >= STEADY_FRAMES && slope > -GROWTH_DB && paprRatio >= Math.pow(10, STEADY_PAPR_DB / 10);
+        if (!growing && !steady) return;
+
+        this.suppress(this.peakFrequency(bin));
+        // Start over: if it keeps building through the notch, the notch deepens
+        this.candidateFrames[slot] = 0;
+        this.candidateFirstDb[slot] = levelDb;
+    }
+
+    // Parabolic interpolation on log power
+    private peakFrequency(k: number): number {
+        const l = Math.log(this.power[k - 1] + 1e-30);
+        const c = Math.log(this.power[k] + 1e-30);
+        const r = Math.log(this.power[k + 1] + 1e-30);
+        const denominator = l - 2 * c + r;
+        const offset = denominator < 0 ? (0.5 * (l - r)) / denominator : 0;
+        return ((k + Math.max(-0.5, Math.min(0.5, offset))) * this.sampleRate) / FFT_SIZE;
+    }
+
+    private suppress(frequency: number): void {
+        // Deepen the notch already covering this frequency
+        for (let n = 0; n < MAX_NOTCHES; n++) {
+            if (!this.notchActive[n]) continue;
+            const ratio = frequency / this.notchFreq[n];
+            if (ratio < MERGE_RATIO && ratio > 1 / MERGE_RATIO) {
+                this.notchTarget[n] = Math.max(MAX_DEPTH_DB, Math.min(this.notchTarget[n], this.notchDepth[n]) + DEEPEN_DB);
+                this.changed = true;
+                return;
+            }
+        }
+
+        // New notch in a free slot
+        let slot = -1;
+        let shallowest = -1;
+        for (let n = 0; n < MAX_NOTCHES; n++) {
+            if (!this.notchActive[n]) {
+                slot = n;
+                break;
+            }
+            if (shallowest < 0 || this.notchTarget[n] > this.notchTarget[shallowest]) shallowest = n;
+        }
+        if (slot < 0) {
+            // Bank full: ramp the shallowest notch out rather than cutting it (the howl
+            // it holds would return at once). This howl is confirmed again and takes
+            // the slot once it is free, or deepens the old notch if that one returns.
+            if (this.notchTarget[shallowest] < 0) {
+                this.notchTarget[shallowest] = 0;
+                this.changed = true;
+            }
+            return;
+        }
+        this.notchActive[slot] = 1;
+        this.notchFreq[slot] = frequency;
+        this.notchDepth[slot] = 0;
+        this.notchTarget[slot] = FIRST_DEPTH_DB;
+        for (let ch = 0; ch < MAX_CHANNELS; ch++) {
+            this.z1[slot * MAX_CHANNELS + ch] = 0;
+            this.z2[slot * MAX_CHANNELS + ch] = 0;
+        }
+        this.setCoefficients(slot, 0);
+        this.changed = true;
+    }
+
+    // In-place radix-2 FFT; input already in bit-reversed order
+    private fft(re: Float32Array, im: Float32Array): void {
+        for (let size = 2; size <= FFT_SIZE; size *= 2) {
+            const half = size / 2;
+            const step = FFT_SIZE / size;
+            for (let start = 0; start < FFT_SIZE; start += size) {
+                for (let j = 0; j < half; j++) {
+                    const wr = this.cosTable[j * step];
+                    const wi = -this.sinTable[j * step];
+                    const a = start + j;
+                    const b = a + half;
+                    const tr = re[b] * wr - im[b] * wi;
+                    const ti = re[b] * wi + im[b] * wr;
+                    re[b] = re[a] - tr;
+                    im[b] = im[a] - ti;
+                    re[a] += tr;
+                    im[a] += ti;
+                }
+            }
+        }
+    }
+}
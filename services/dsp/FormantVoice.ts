@@ -0,0 +1,248 @@
+/**
+ * Formant speech kernel (Klatt-style cascade synthesizer).
+ * Pure DSP with no Web Audio dependencies, so it runs inside an
+ * AudioWorkletProcessor or any other sample-pushing host.
+ *
+ * A "score" is a flat Float32Array of segments, VOICE_SEGMENT_STRIDE floats each:
+ *   [duration (s), f0 (Hz), F1, F2, F3, voicing amp, frication amp, frication centre (Hz)]
+ */
+
+export const VOICE_SEGMENT_STRIDE = 8;
+
+// Coefficients are recomputed every CONTROL_INTERVAL samples
+const CONTROL_INTERVAL = 32;
+// Coarticulation: formants glide slower than amplitudes
+const FORMANT_GLIDE_SECONDS = 0.035;
+const AMPLITUDE_GLIDE_SECONDS = 0.008;
+const PITCH_GLIDE_SECONDS = 0.05;
+// Short tail so the last resonances ring out before the kernel goes idle
+const RELEASE_SECONDS = 0.08;
+
+const OUTPUT_GAIN = 0.35;
+const ASPIRATION_LEVEL = 0.04;
+
+/**
+ * Two-pole resonator with unity DC gain (Klatt 1980).
+ */
+class Resonator {
+    private a = 1;
+    private b = 0;
+    private c = 0;
+    private y1 = 0;
+    private y2 = 0;
+
+    set(freq: number, bandwidth: number, sampleRate: number): void {
+        const t = 1 / sampleRate;
+        this.c = -Math.exp(-2 * Math.PI * bandwidth * t);
+        this.b = 2 * Math.exp(-Math.PI * bandwidth * t) * Math.cos(2 * Math.PI * freq * t);
+        this.a = 1 - this.b - this.c;
+    }
+
+    tick(x: number): number {
+        const y = this.a * x + this.b * this.y1 + this.c * this.y2;
+        this.y2 = this.y1;
+        this.y1 = y;
+        return y;
+    }
+
+    clear(): void {
+        this.y1 = 0;
+        this.y2 = 0;
+    }
+}
+
+export class FormantVoiceKernel {
+    private readonly sampleRate: number;
+
+    private score: Float32Array = new Float32Array(0);
+    private segmentCount = 0;
+    private segment = 0;
+    private segmentRemaining = 0;
+    private active = false;
+    private releaseRemaining = 0;
+
+    // Smoothed synthesis parameters
+    private f0 = 100;
+    private f1 = 500;
+    private f2 = 1500;
+    private f3 = 2500;
+    private voice = 0;
+    private noise = 0;
+    private noiseFreq = 4000;
+
+    private readonly formantCoef: number;
+    private readonly amplitudeCoef: number;
+    private readonly pitchCoef: number;
+
+    private readonly r1 = new Resonator();
+    private readonly r2 = new Resonator();
+    private readonly r3 = new Resonator();
+    private readonly frication = new Resonator();
+
+    private phase = 0;
+    private prevGlottal = 0;
+    private prevNoise = 0;
+    private seed = 0x2545f491;
+    private controlCounter = 0;
+
+    constructor(sampleRate: number) {
+        this.sampleRate = sampleRate;
+        const block = CONTROL_INTERVAL / sampleRate;
+        this.formantCoef = 1 - Math.exp(-block / FORMANT_GLIDE_SECONDS);
+        this.amplitudeCoef = 1 - Math.exp(-block / AMPLITUDE_GLIDE_SECONDS);
+        this.pitchCoef = 1 - Math.exp(-block / PITCH_GLIDE_SECONDS);
+    }
+
+    /**
+     * Start rendering a new score, replacing whatever was playing.
+     */
+    load(score: Float32Array): void {
+        this.score = score;
+        this.segmentCount = Math.floor(score.length / VOICE_SEGMENT_STRIDE);
+        this.segment = 0;
+        this.active = this.segmentCount > 0;
+        this.releaseRemaining = Math.round(RELEASE_SECONDS * this.sampleRate);
+        if (!this.active) return;
+
+        // Start from the first segment's shape so the onset doesn't glide in from stale formants
+        this.f0 = score[1];
+        this.f1 = score[2];
+        this.f2 = score[3];
+        this.f3 = score[4];
+        this.voice = 0;
+        this.noise = 0;
+        this.segmentRemaining = Math.round(score[0] * this.sampleRate);
+        this.controlCounter = 0;
+    }
+
+    /**
+     * Jump straight to the release tail.
+     */
+    stop(): void {
+        if (!this.active) return;
+        this.segment = this.segmentCount;
+        this.segmentRemaining = 0;
+    }
+
+    isActive(): boolean {
+        return this.active;
+    }
+
+    /**
+     * Render one block. Returns false once the score (and its tail) has finished.
+     */
+    process(out: Float32Array): boolean {
+        if (!this.active) {
+            out.fill(0);
+            return false;
+        }
+
+        const sr = this.sampleRate;
+        for (let i = 0; i < out.length; i++) {
+            if (this.controlCounter === 0) {
+                this.updateControl();
+            }
+            this.controlCounter = (this.controlCounter + 1) % CONTROL_INTERVAL;
+
+            // Rosenberg glottal pulse, differentiated for lip radiation
+            this.phase += this.f0 / sr;
+            if (this.phase >= 1) this.phase -= 1;
+            const p = this.phase;
+            let glottal = 0;
+            if (p < 0.4) {
+                glottal = 0.5 * (1 - Math.cos(Math.PI * p / 0.4));
+            } else if (p < 0.6) {
+                glottal = Math.cos(Math.PI * (p - 0.4) / 0.4);
+            }
+            const flow = (glottal - this.prevGlottal) * (sr / (this.f0 * 4));
+            this.prevGlottal = glottal;
+
+            const white = this.nextNoise();
+            const source = (flow + white * ASPIRATION_LEVEL) * this.voice;
+            const voiced = this.r3.tick(this.r2.tick(this.r1.tick(source)));
+
+            // High-passed noise through a single resonance for fricatives and bursts
+            const hissed = white - this.prevNoise;
+            this.prevNoise = white;
+            const fricative = this.frication.tick(hissed) * this.noise;
+
+            const y = (voiced + fricative) * OUTPUT_GAIN;
+            out[i] = y / (1 + Math.abs(y));
+
+            if (this.segment < this.segmentCount) {
+                if (--this.segmentRemaining <= 0) {
+                    this.advanceSegment();
+                }
+            } else if (--this.releaseRemaining <= 0) {
+                out.fill(0, i + 1);
+                this.finish();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    private advanceSegment(): void {
+        this.segment++;
+        if (this.segment < this.segmentCount) {
+            const base = this.segment * VOICE_SEGMENT_STRIDE;
+            this.segmentRemaining = Math.max(1, Math.round(this.score[base] * this.sampleRate));
+        }
+    }
+
+    private updateControl(): void {
+        let tf0 = this.f0;
+        let tf1 = this.f1;
+        let tf2 = this.f2;
+        let tf3 = this.f3;
+        let tVoice = 0;
+        let tNoise = 0;
+        let tNoiseFreq = this.noiseFreq;
+
+        if (this.segment < this.segmentCount) {
+            const s = this.score;
+            const base = this.segment * VOICE_SEGMENT_STRIDE;
+            tf0 = s[base + 1];
+            tf1 = s[base + 2];
+            tf2 = s[base + 3];
+            tf3 = s[base + 4];
+            tVoice = s[base + 5];
+            tNoise = s[base + 6];
+            tNoiseFreq = s[base + 7];
+        }
+
+        this.f0 += (tf0 - this.f0) * this.pitchCoef;
+        this.f1 += (tf1 - this.f1) * this.formantCoef;
+        this.f2 += (tf2 - this.f2) * this.formantCoef;
+        this.f3 += (tf3 - this.f3) * this.formantCoef;
+        this.voice += (tVoice - this.voice) * this.amplitudeCoef;
+        this.noise += (tNoise - this.noise) * this.amplitudeCoef;
+        this.noiseFreq += (tNoiseFreq - this.noiseFreq) * this.amplitudeCoef;
+
+        const sr = this.sampleRate;
+        this.r1.set(this.f1, 60 + this.f1 * 0.08, sr);
+        this.r2.set(this.f2, 90 + this.f2 * 0.05, sr);
+        this.r3.set(this.f3, 150 + this.f3 * 0.04, sr);
+        this.frication.set(this.noiseFreq, this.noiseFreq * 0.45, sr);
+    }
+
+    private finish(): void {
+        this.active = false;
+        this.voice = 0;
+        this.noise = 0;
+        this.r1.clear();
+        this.r2.clear();
+        this.r3.clear();
+        this.frication.clear();
+    }
+
+    private nextNoise(): number {
+        // xorshift32
+        let x = this.seed;
+        x ^= x << 13;
+        x ^= x >>> 17;
+        x ^= x << 5;
+        this.seed = x >>> 0;
+        return (this.seed / 4294967296) * 2 - 1;
+    }
+}
@@ -0,0 +1,188 @@
+/**
+ * Granular cloud kernel with a fixed, preallocated grain pool.
+ * Grains are plain slots in typed arrays: spawning one is a few stores,
+ * so dense clouds cost arithmetic rather than object or node creation.
+ */
+
+export const MAX_GRAINS = 256;
+
+const WINDOW_SIZE = 1024;
+const MIN_GRAIN_SAMPLES = 64;
+
+export interface GrainCloudParams {
+    /** Centre read position, 0..1 of the take */
+    position: number;
+    /** Random scatter of position, pitch and pan, 0..1 */
+    spray: number;
+    /** Grains per second */
+    density: number;
+    /** Grain length in seconds */
+    size: number;
+    /** Playback ratio (1 = original pitch) */
+    pitch: number;
+}
+
+export class GrainCloudKernel {
+    private readonly sampleRate: number;
+
+    // Source take (mono or stereo)
+    private left: Float32Array = new Float32Array(0);
+    private right: Float32Array = new Float32Array(0);
+    private sourceLength = 0;
+
+    // Grain pool; `order` keeps live grains packed at the front
+    private readonly order = new Int16Array(MAX_GRAINS);
+    private liveCount = 0;
+    private readonly readPos = new Float64Array(MAX_GRAINS);
+    private readonly increment = new Float32Array(MAX_GRAINS);
+    private readonly age = new Int32Array(MAX_GRAINS);
+    private readonly length = new Int32Array(MAX_GRAINS);
+    private readonly startOffset = new Int32Array(MAX_GRAINS);
+    private readonly gainL = new Float32Array(MAX_GRAINS);
+    private readonly gainR = new Float32Array(MAX_GRAINS);
+
+    private readonly window = new Float32Array(WINDOW_SIZE + 1);
+    private samplesToNextGrain = 0;
+    private running = false;
+    private seed = 0x9e3779b9;
+
+    constructor(sampleRate: number) {
+        this.sampleRate = sampleRate;
+        for (let i = 0; i < MAX_GRAINS; i++) this.order[i] = i;
+        // Hann window, with a guard point for interpolation-free lookup at the end
+        for (let i = 0; i <= WINDOW_SIZE; i++) {
+            this.window[i] = 0.5 - 0.5 * Math.cos((2 * Math.PI * i) / WINDOW_SIZE);
+        }
+    }
+
+    setSource(channels: Float32Array[]): void {
+        this.left = channels[0] ?? new Float32Array(0);
+        this.right = channels[1] ?? this.left;
+        this.sourceLength = this.left.length;
+        this.liveCount = 0;
+    }
+
+    /**
+     * Restart the grain scatter sequence, so a replay or render draws the same grains
+     */
+    setSeed(seed: number): void {
+        this.seed = (seed >>> 0) || 0x9e3779b9;
+    }
+
+    setRunning(running: boolean): void {
+        this.running = running;
+        if (running) this.samplesToNextGrain = 0;
+    }
+
+    hasSource(): boolean {
+        return this.sourceLength > 0;
+    }
+
+    getLiveGrainCount(): number {
+        return this.liveCount;
+    }
+
+    /**
+     * Render one block (adds nothing when idle, but always overwrites the outputs).
+     */
+    process(outL: Float32Array, outR: Float32Array, params: GrainCloudParams): void {
+        outL.fill(0);
+        outR.fill(0);
+        const blockLength = outL.length;
+
+        if (this.running && this.sourceLength > MIN_GRAIN_SAMPLES) {
+            this.scheduleGrains(blockLength, params);
+        }
+
+        const left = this.left;
+        const right = this.right;
+        const lastIndex = this.sourceLength - 1;
+        const window = this.window;
+
+        for (let n = 0; n < this.liveCount; n++) {
+            const g = this.order[n];
+            const len = this.length[g];
+            const inc = this.increment[g];
+            const windowStep = WINDOW_SIZE / len;
+            const gl = this.gainL[g];
+            const gr = this.gainR[g];
+            let pos = this.readPos[g];
+            let age = this.age[g];
+
+            let i = this.startOffset[g];
+            this.startOffset[g] = 0;
+            for (; i < blockLength && age < len; i++, age++) {
+                // Wrap inside the take so grains near the end keep reading
+                if (pos >= lastIndex) pos -= lastIndex;
+                else if (pos < 0) pos += lastIndex;
+                const idx = pos | 0;
+                const frac = pos - idx;
+                const w = window[(age * windowStep) | 0];
+                const l = left[idx] + (left[idx + 1] - left[idx]) * frac;
+                const r = right[idx] + (right[idx + 1] - right[idx]) * frac;
+                outL[i] += l * w * gl;
+                outR[i] += r * w * gr;
+                pos += inc;
+            }
+
+            this.readPos[g] = pos;
+            this.age[g] = age;
+
+            if (age >= len) {
+                // Retire: swap with the last live slot and revisit this index
+                this.liveCount--;
+                this.order[n] = this.order[this.liveCount];
+                this.order[this.liveCount] = g;
+                n--;
+            }
+        }
+    }
+
+    private scheduleGrains(blockLength: number, params: GrainCloudParams): void {
+        const density = Math.max(0.5, params.density);
+        const interval = this.sampleRate / density;
+        // Overlapping grains add up; normalise roughly by expected overlap
+        const overlap = Math.max(1, density * params.size);
+        const level = 0.7 / Math.sqrt(overlap);
+
+        while (this.samplesToNextGrain < blockLength) {
+            if (this.liveCount < MAX_GRAINS) {
+                this.spawn(this.samplesToNextGrain, params, level);
+            }
+            // Jitter the inter-onset time so dense clouds don't buzz at the grain rate
+            this.samplesToNextGrain += interval * (0.5 + this.random() * (0.5 + params.spray));
+        }
+        this.samplesToNextGrain -= blockLength;
+    }
+
+    private spawn(offset: number, params: GrainCloudParams, level: number): void {
+        const g = this.order[this.liveCount++];
+        const spray = params.spray;
+
+        const scatter = (this.random() * 2 - 1) * spray * 0.5;
+        let position = params.position + scatter;
+        position -= Math.floor(position);
+
+        const detune = (this.random() * 2 - 1) * spray * 7; // up to ±7 semitones
+        const pan = 0.5 + (this.random() * 2 - 1) * spray * 0.5;
+
+        this.readPos[g] = position * (this.sourceLength - 1);
+        this.increment[g] = params.pitch * Math.pow(2, detune / 12);
+        this.length[g] = Math.max(MIN_GRAIN_SAMPLES, Math.round(params.size * this.sampleRate));
+        this.age[g] = 0;
+        this.startOffset[g] = offset | 0;
+        // Equal-power pan
+        this.gainL[g] = level * Math.cos(pan * Math.PI * 0.5);
+        this.gainR[g] = level * Math.sin(pan * Math.PI * 0.5);
+    }
+
+    private random(): number {
+        // xorshift32
+        let x = this.seed;
+        x ^= x << 13;
+        x ^= x >>> 17;
+        x ^= x << 5;
+        this.seed = x >>> 0;
+        return this.seed / 4294967296;
+    }
+}
@@ -0,0 +1,141 @@
+/**
+ * EBU R128 / ITU-R BS.1770 loudness meter kernel.
+ * K-weighting (high-shelf pre-filter + RLB high-pass) per channel, mean square
+ * gathered in 100 ms blocks, then momentary (400 ms) and short-term (3 s)
+ * loudness in LUFS over the most recent blocks. Left/right weights are 1.
+ */
+
+export const BLOCK_SECONDS = 0.1;
+const MOMENTARY_BLOCKS = 4;
+const SHORT_TERM_BLOCKS = 30;
+
+/** Reported for silence instead of -Infinity */
+export const LUFS_FLOOR = -100;
+
+export class LoudnessMeterKernel {
+    private readonly channels: number;
+    private readonly blockSamples: number;
+
+    // Biquad coefficients: pre-filter (shelf) then RLB high-pass
+    private readonly sb0: number; private readonly sb1: number; private readonly sb2: number;
+    private readonly sa1: number; private readonly sa2: number;
+    private readonly ha1: number; private readonly ha2: number;
+
+    // Direct form II state per channel: [shelf z1, shelf z2, hp z1, hp z2]
+    private readonly state: Float64Array;
+
+    // Current block: per-channel sum of squares
+    private readonly blockSums: Float64Array;
+    private blockCount = 0;
+
+    // Ring of finished block energies (channel-summed mean square)
+    private readonly blocks = new Float64Array(SHORT_TERM_BLOCKS);
+    private blockHead = 0;
+    private blocksFilled = 0;
+
+    constructor(sampleRate: number, channels: number = 2) {
+        this.channels = channels;
+        this.blockSamples = Math.round(BLOCK_SECONDS * sampleRate);
+        this.state = new Float64Array(channels * 4);
+        this.blockSums = new Float64Array(channels);
+
+        // Coefficients re-derived for any sample rate (as in libebur128)
+        let f0 = 1681.974450955533;
+        const gainDb = 3.999843853973347;
+        let q = 0.7071752369554196;
+        let k = Math.tan(Math.PI * f0 / sampleRate);
+        const vh = Math.pow(10, gainDb / 20);
+        const vb = Math.pow(vh, 0.4996667741545416);
+        let a0 = 1 + k / q + k * k;
+        this.sb0 = (vh + vb * k / q + k * k) / a0;
+        this.sb1 = 2 * (k * k - vh) / a0;
+        this.sb2 = (vh - vb * k / q + k * k) / a0;
+        this.sa1 = 2 * (k * k - 1) / a0;
+        this.sa2 = (1 - k / q + k * k) / a0;
+
+        f0 = 38.13547087602444;
+        q = 0.5003270373238773;
+        k = Math.tan(Math.PI * f0 / sampleRate);
+        a0 = 1 + k / q + k * k;
+        this.ha1 = 2 * (k * k - 1) / a0;
+        this.ha2 = (1 - k / q + k * k) / a0;
+    }
+
+    /**
+     * Feed one render quantum. Returns true when a 100 ms block was completed,
+     * i.e. when momentary()/shortTerm() have a new value.
+     */
+    process(input: Float32Array[]): boolean {
+        const n = input.length > 0 ? input[0].length : 0;
+        const channels = Math.min(this.channels, input.length);
+
+        for (let ch = 0; ch < channels; ch++) {
+            const x = input[ch];
+            const s = ch * 4;
+            let z1 = this.state[s], z2 = this.state[s + 1];
+            let h1 = this.state[s + 2], h2 = this.state[s + 3];
+            let sum = 0;
+
+            for (let i = 0; i < n; i++) {
+                // Shelf (DF II)
+                const w = x[i] - this.sa1 * z1 - this.sa2 * z2;
+                const y = this.sb0 * w + this.sb1 * z1 + this.sb2 * z2;
+                z2 = z1; z1 = w;
+                // High-pass, numerator [1, -2, 1]
+                const v = y - this.ha1 * h1 - this.ha2 * h2;
+                const out = v - 2 * h1 + h2;
+                h2 = h1; h1 = v;
+                sum += out * out;
+            }
+
+            this.state[s] = z1; this.state[s + 1] = z2;
+            this.state[s + 2] = h1; this.state[s + 3] = h2;
+            this.blockSums[ch] += sum;
+        }
+
+        this.blockCount += n;
+        if (this.blockCount < this.blockSamples) return false;
+
+        // Close the block at the quantum boundary, normalised by its real length
+        let energy = 0;
+        for (let ch = 0; ch < this.channels; ch++) {
+            energy += this.blockSums[ch] / this.blockCount;
+            this.blockSums[ch] = 0;
+        }
+        this.blockCount = 0;
+
+        this.blocks[this.blockHead] = energy;
+        this.blockHead = (this.blockHead + 1) % SHORT_TERM_BLOCKS;
+        if (this.blocksFilled < SHORT_TERM_BLOCKS) this.blocksFilled++;
+        return true;
+    }
+
+    momentary(): number {
+        return this.loudness(MOMENTARY_BLOCKS);
+    }
+
+    shortTerm(): number {
+        return this.loudness(SHORT_TERM_BLOCKS);
+    }
+
+    reset(): void {
+        this.state.fill(0);
+        this.blockSums.fill(0);
+        this.blockCount = 0;
+        this.blocks.fill(0);
+        this.blockHead = 0;
+        this.blocksFilled = 0;
+    }
+
+    private loudness(blockCount: number): number {
+        const count = Math.min(blockCount, this.blocksFilled);
+        if (count === 0) return LUFS_FLOOR;
+
+        let sum = 0;
+        for (let b = 1; b <= count; b++) {
+            sum += this.blocks[(this.blockHead - b + SHORT_TERM_BLOCKS) % SHORT_TERM_BLOCKS];
+        }
+        const meanSquare = sum / count;
+        return meanSquare > 0 ? Math.max(LUFS_FLOOR, -0.691 + 10 * Math.log10(meanSquare)) : LUFS_FLOOR;
+    }
+}
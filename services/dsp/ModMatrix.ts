@@ -0,0 +1,211 @@
+/**
+ * Modulation matrix kernel, evaluated once per render quantum.
+ *
+ * Sources: four LFOs, an envelope follower on the node's input and a smoothed
+ * random walk. Routes add `depth × source` into a target; each target is one
+ * mono output, ramped linearly across the quantum, meant to be connected to an
+ * AudioParam (which sums it with the param's own value). Cost is fixed by the
+ * number of routes, not by the number of oscillator and gain nodes.
+ */
+
+export const LFO_COUNT = 4;
+export const SOURCE_ENVELOPE = LFO_COUNT;
+export const SOURCE_RANDOM = LFO_COUNT + 1;
+export const SOURCE_COUNT = LFO_COUNT + 2;
+export const MAX_ROUTES = 16;
+
+export const LFO_SHAPES = ['sine', 'triangle', 'saw', 'square', 'sampleHold'] as const;
+export type LfoShape = typeof LFO_SHAPES[number];
+
+// Route depths glide towards new values with this time constant (seconds)
+const DEPTH_SMOOTHING = 0.05;
+
+export class ModMatrixKernel {
+    private readonly sampleRate: number;
+    private readonly targetCount: number;
+
+    // LFO state
+    private readonly lfoRate = new Float32Array(LFO_COUNT);
+    private readonly lfoShape = new Uint8Array(LFO_COUNT);
+    private readonly lfoPhase = new Float64Array(LFO_COUNT);
+    private readonly lfoHeld = new Float32Array(LFO_COUNT);
+
+    // Envelope follower (rectified, one-pole attack/release)
+    private envAttack = 0;
+    private envRelease = 0;
+    private envelope = 0;
+
+    // Random walk: cosine glide between successive random points
+    private randomRate = 0.5;
+    private randomPhase = 0;
+    private randomFrom = 0;
+    private randomTo = 0;
+    private seed = 0x6d2b79f5;
+
+    private readonly sources = new Float32Array(SOURCE_COUNT);
+
+    // Routes, packed at the front
+    private readonly routeSource = new Uint8Array(MAX_ROUTES);
+    private readonly routeTarget = new Uint8Array(MAX_ROUTES);
+    private readonly routeDepth = new Float32Array(MAX_ROUTES);
+    private readonly routeTargetDepth = new Float32Array(MAX_ROUTES);
+    private routeCount = 0;
+
+    // Target values at the end of the previous quantum (ramp start)
+    private readonly previous: Float32Array;
+    private readonly current: Float32Array;
+
+    constructor(sampleRate: number, targetCount: number) {
+        this.sampleRate = sampleRate;
+        this.targetCount = targetCount;
+        this.previous = new Float32Array(targetCount);
+        this.current = new Float32Array(targetCount);
+        this.setEnvelope(0.01, 0.2);
+        this.randomTo = this.random() * 2 - 1;
+    }
+
+    /**
+     * Restart the sample-and-hold and random-walk sequence, so a replay or
+     * render draws the same values
+     */
+    setSeed(seed: number): void {
+        this.seed = (seed >>> 0) || 0x6d2b79f5;
+    }
+
+    setLfo(index: number, rate: number, shape: LfoShape): void {
+        if (index < 0 || index >= LFO_COUNT) return;
+        this.lfoRate[index] = Math.max(0, rate);
+        this.lfoShape[index] = Math.max(0, LFO_SHAPES.indexOf(shape));
+    }
+
+    setEnvelope(attackSeconds: number, releaseSeconds: number): void {
+        this.envAttack = 1 - Math.exp(-1 / (Math.max(1e-4, attackSeconds) * this.sampleRate));
+        this.envRelease = 1 - Math.exp(-1 / (Math.max(1e-4, releaseSeconds) * this.sampleRate));
+    }
+
+    setRandom(rate: number): void {
+        this.randomRate = Math.max(0, rate);
+    }
+
+    /**
+     * Add, update or (with depth 0) remove the route from `source` to `target`
+     */
+    setRoute(source: number, target: number, depth: number): void {
+        if (source < 0 || source >= SOURCE_COUNT || target < 0 || target >= this.targetCount) return;
+
+        for (let r = 0; r < this.routeCount; r++) {
+            if (this.routeSource[r] === source && this.routeTarget[r] === target) {
+                // A route set to 0 fades out and is dropped in process()
+                this.routeTargetDepth[r] = depth;
+                return;
+            }
+        }
+        if (depth === 0 || this.routeCount === MAX_ROUTES) return;
+
+        const r = this.routeCount++;
+        this.routeSource[r] = source;
+        this.routeTarget[r] = target;
+        this.routeDepth[r] = 0;
+        this.routeTargetDepth[r] = depth;
+    }
+
+    /**
+     * Advance one quantum and write every target's ramp.
+     * @param input - Envelope follower input (mono), or undefined if nothing is connected
+     * @param outputs - One mono buffer per target
+     */
+    process(input: Float32Array | undefined, outputs: Float32Array[], frames: number): void {
+        const dt = frames / this.sampleRate;
+        this.updateLfos(dt);
+        this.updateEnvelope(input);
+        this.updateRandom(dt);
+
+        // Evaluate the matrix
+        const current = this.current;
+        current.fill(0);
+        const depthGlide = 1 - Math.exp(-dt / DEPTH_SMOOTHING);
+        for (let r = 0; r < this.routeCount; r++) {
+            this.routeDepth[r] += depthGlide * (this.routeTargetDepth[r] - this.routeDepth[r]);
+            current[this.routeTarget[r]] += this.routeDepth[r] * this.sources[this.routeSource[r]];
+        }
+
+        // Drop routes that have faded out completely
+        for (let r = this.routeCount - 1; r >= 0; r--) {
+            if (this.routeTargetDepth[r] === 0 && Math.abs(this.routeDepth[r]) < 1e-6) this.removeRoute(r);
+        }
+
+        for (let t = 0; t < this.targetCount; t++) {
+            const out = outputs[t];
+            if (!out) continue;
+            const from = this.previous[t];
+            const step = (current[t] - from) / frames;
+            for (let i = 0; i < frames; i++) out[i] = from + step * (i + 1);
+            this.previous[t] = current[t];
+        }
+    }
+
+    private updateLfos(dt: number): void {
+        for (let l = 0; l < LFO_COUNT; l++) {
+            let phase = this.lfoPhase[l] + this.lfoRate[l] * dt;
+            const wrapped = phase >= 1;
+            if (wrapped) phase -= Math.floor(phase);
+            this.lfoPhase[l] = phase;
+
+            let value: number;
+            switch (LFO_SHAPES[this.lfoShape[l]]) {
+                case 'triangle': value = 1 - 4 * Math.abs(phase - 0.5); break;
+                case 'saw': value = 2 * phase - 1; break;
+                case 'square': value = phase < 0.5 ? 1 : -1; break;
+                case 'sampleHold':
+                    if (wrapped) this.lfoHeld[l] = this.random() * 2 - 1;
+                    value = this.lfoHeld[l];
+                    break;
+                default: value = Math.sin(2 * Math.PI * phase);
+            }
+            this.sources[l] = value;
+        }
+    }
+
+    private updateEnvelope(input: Float32Array | undefined): void {
+        let env = this.envelope;
+        if (input) {
+            for (let i = 0; i < input.length; i++) {
+                const level = Math.abs(input[i]);
+                env += (level > env ? this.envAttack : this.envRelease) * (level - env);
+            }
+        } else {
+            env *= Math.pow(1 - this.envRelease, 128);
+        }
+        this.envelope = env;
+        this.sources[SOURCE_ENVELOPE] = Math.min(1, env);
+    }
+
+    private updateRandom(dt: number): void {
+        this.randomPhase += this.randomRate * dt;
+        if (this.randomPhase >= 1) {
+            this.randomPhase -= Math.floor(this.randomPhase);
+            this.randomFrom = this.randomTo;
+            this.randomTo = this.random() * 2 - 1;
+        }
+        const blend = 0.5 - 0.5 * Math.cos(Math.PI * this.randomPhase);
+        this.sources[SOURCE_RANDOM] = this.randomFrom + blend * (this.randomTo - this.randomFrom);
+    }
+
+    private removeRoute(r: number): void {
+        const last = --this.routeCount;
+        this.routeSource[r] = this.routeSource[last];
+        this.routeTarget[r] = this.routeTarget[last];
+        this.routeDepth[r] = this.routeDepth[last];
+        this.routeTargetDepth[r] = this.routeTargetDepth[last];
+    }
+
+    private random(): number {
+        // xorshift32
+        let x = this.seed;
+        x ^= x << 13;
+        x ^= x >>> 17;
+        x ^= x << 5;
+        this.seed = x >>> 0;
+        return this.seed / 4294967296;
+    }
+}
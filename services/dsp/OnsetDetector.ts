@@ -0,0 +1,72 @@
+/**
+ * Onset detector kernel: fires when a fast energy envelope jumps well above a
+ * slow one. Cheap enough to sit on the master bus; used to measure when
+ * scheduled triggers actually reach the output.
+ */
+
+export interface OnsetDetectorOptions {
+    /** Fast envelope time constant in seconds */
+    fastTime?: number;
+    /** Slow (background) envelope time constant in seconds */
+    slowTime?: number;
+    /** Fast/slow energy ratio that counts as an onset */
+    ratio?: number;
+    /** Absolute energy floor, so silence plus noise never triggers */
+    floor?: number;
+    /** Minimum spacing between onsets in seconds */
+    refractory?: number;
+}
+
+export class OnsetDetectorKernel {
+    private readonly fastCoeff: number;
+    private readonly slowCoeff: number;
+    private readonly ratio: number;
+    private readonly floor: number;
+    private readonly refractorySamples: number;
+
+    private fast = 0;
+    private slow = 0;
+    private holdoff = 0;
+
+    constructor(sampleRate: number, options: OnsetDetectorOptions = {}) {
+        this.fastCoeff = 1 - Math.exp(-1 / ((options.fastTime ?? 0.001) * sampleRate));
+        this.slowCoeff = 1 - Math.exp(-1 / ((options.slowTime ?? 0.08) * sampleRate));
+        this.ratio = options.ratio ?? 4;
+        this.floor = options.floor ?? 1e-5;
+        this.refractorySamples = Math.round((options.refractory ?? 0.04) * sampleRate);
+    }
+
+    /**
+     * Scan one block. Returns the sample offset of the first onset in it, or -1.
+     */
+    process(input: Float32Array): number {
+        let found = -1;
+        let fast = this.fast;
+        let slow = this.slow;
+        let holdoff = this.holdoff;
+
+        for (let i = 0; i < input.length; i++) {
+            const energy = input[i] * input[i];
+            fast += this.fastCoeff * (energy - fast);
+            slow += this.slowCoeff * (energy - slow);
+
+            if (holdoff > 0) {
+                holdoff--;
+            } else if (found < 0 && fast > this.floor && fast > this.ratio * slow) {
+                found = i;
+                holdoff = this.refractorySamples;
+            }
+        }
+
+        this.fast = fast;
+        this.slow = slow;
+        this.holdoff = holdoff;
+        return found;
+    }
+
+    reset(): void {
+        this.fast = 0;
+        this.slow = 0;
+        this.holdoff = 0;
+    }
+}
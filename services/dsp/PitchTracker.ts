@@ -0,0 +1,196 @@
+/**
+ * Low-latency monophonic pitch tracker (YIN on a decimated signal).
+ * The input is low-passed and decimated to ~12 kHz, which cuts the cost of
+ * the difference function by the decimation factor squared while keeping
+ * voice fundamentals well inside the band. Every HOP input samples the
+ * newest WINDOW decimated samples are analysed: cumulative-mean-normalised
+ * difference, first dip under the threshold (or the deepest dip when none
+ * is), parabolic refinement. Confidence is 1 minus the normalised difference
+ * at the dip, so breathy or noisy frames that only reach the fallback dip
+ * score low.
+ *
+ * The reported pitch holds its last voiced value through silence and
+ * consonants, so anything following it never drops to 0 Hz; confidence
+ * falls to 0 instead.
+ */
+
+export const MIN_PITCH_HZ = 60;
+export const MAX_PITCH_HZ = 1000;
+/** Reported before the first voiced frame */
+export const DEFAULT_PITCH_HZ = 110;
+
+const TARGET_RATE = 12000;
+const WINDOW_SECONDS = 0.010;
+const HOP = 128;                    // Input samples between analyses (2.7 ms at 48 kHz)
+const THRESHOLD = 0.15;             // YIN absolute threshold
+const MIN_CONFIDENCE = 0.5;         // Below this the held pitch is not updated
+const GATE_DB = -50;                // Quieter windows are unvoiced
+
+export interface PitchEstimate {
+    frequency: number;
+    confidence: number;
+}
+
+export class PitchTrackerKernel {
+    readonly factor: number;
+    private readonly rate: number;
+    private readonly window: number;
+    private readonly minLag: number;
+    private readonly maxLag: number;
+
+    // Anti-alias low-pass: two cascaded biquads (4th-order Butterworth)
+    private readonly coeffs: Float64Array;
+    private readonly state = new Float64Array(8);
+    private phase = 0;
+
+    // Decimated history, newest last
+    private readonly ring: Float32Array;
+    private ringPos = 0;
+    private readonly frame: Float32Array;
+    private readonly diff: Float32Array;
+    private sinceHop = 0;
+
+    private frequency = DEFAULT_PITCH_HZ;
+    private confidence = 0;
+
+    constructor(sampleRate: number) {
+        this.factor = Math.max(1, Math.round(sampleRate / TARGET_RATE));
+        this.rate = sampleRate / this.factor;
+        this.window = Math.round(WINDOW_SECONDS * this.rate);
+        this.minLag = Math.max(2, Math.floor(this.rate / MAX_PITCH_HZ));
+        this.maxLag = Math.ceil(this.rate / MIN_PITCH_HZ);
+        this.ring = new Float32Array(this.window + this.maxLag + 1);
+        this.frame = new Float32Array(this.ring.length);
+        this.diff = new Float32Array(this.maxLag + 2);
+
+        // Cutoff well below the decimated Nyquist
+        const cutoff = Math.min(0.4 * this.rate, 0.45 * sampleRate);
+        this.coeffs = new Float64Array(10);
+        [0.5412, 1.3066].forEach((q, stage) => {
+            const w0 = (2 * Math.PI * cutoff) / sampleRate;
+            const alpha = Math.sin(w0) / (2 * q);
+            const cos = Math.cos(w0);
+            const a0 = 1 + alpha;
+            const c = this.coeffs;
+            const o = stage * 5;
+            c[o] = (1 - cos) / 2 / a0;
+            c[o + 1] = (1 - cos) / a0;
+            c[o + 2] = (1 - cos) / 2 / a0;
+            c[o + 3] = (-2 * cos) / a0;
+            c[o + 4] = (1 - alpha) / a0;
+        });
+    }
+
+    /**
+     * Feed one block. Returns true when a new estimate was made.
+     */
+    process(input: Float32Array): boolean {
+        const c = this.coeffs;
+        const s = this.state;
+        for (let i = 0; i < input.length; i++) {
+            let x = input[i];
+            for (let stage = 0; stage < 2; stage++) {
+                const o = stage * 5;
+                const z = stage * 4;
+                // Direct form I
+                const y = c[o] * x + c[o + 1] * s[z] + c[o + 2] * s[z + 1] - c[o + 3] * s[z + 2] - c[o + 4] * s[z + 3];
+                s[z + 1] = s[z];
+                s[z] = x;
+                s[z + 3] = s[z + 2];
+                s[z + 2] = y;
+                x = y;
+            }
+            if (++this.phase >= this.factor) {
+                this.phase = 0;
+                this.ring[this.ringPos] = x;
+                this.ringPos = (this.ringPos + 1) % this.ring.length;
+            }
+        }
+
+        this.sinceHop += input.length;
+        if (this.sinceHop < HOP) return false;
+        this.sinceHop -= HOP;
+        this.analyse();
+        return true;
+    }
+
+    getEstimate(): PitchEstimate {
+        return { frequency: this.frequency, confidence: this.confidence };
+    }
+
+    getFrequency(): number {
+        return this.frequency;
+    }
+
+    getConfidence(): number {
+        return this.confidence;
+    }
+
+    private analyse(): void {
+        // Unroll the ring, oldest first
+        const frame = this.frame;
+        const length = frame.length;
+        let energy = 0;
+        for (let i = 0; i < length; i++) {
+            const x = this.ring[(this.ringPos + i) % length];
+            frame[i] = x;
+        }
+
+        // Analyse the newest samples: the window ends at the latest input
+        const start = length - this.window - this.maxLag;
+        for (let j = 0; j < this.window; j++) {
+            const x = frame[start + this.maxLag + j];
+            energy += x * x;
+        }
+        if (10 * Math.log10(energy / this.window + 1e-20) < GATE_DB) {
+            this.confidence = 0;
+            return;
+        }
+
+        // Difference against the window shifted back by tau
+        const diff = this.diff;
+        const base = start + this.maxLag;
+        diff[0] = 1;
+        let running = 0;
+        let found = -1;
+        let deepest = -1;
+        for (let tau = 1; tau <= this.maxLag; tau++) {
+            let sum = 0;
+            for (let j = 0; j < this.window; j++) {
+                const d = frame[base + j] - frame[base + j - tau];
+                sum += d * d;
+            }
+            running += sum;
+            // Cumulative mean normalised difference
+            diff[tau] = running > 0 ? (sum * tau) / running : 1;
+            if (tau > this.minLag && (deepest < 0 || diff[tau] < diff[deepest])) deepest = tau;
+            if (found < 0 && tau > this.minLag && diff[tau - 1] < THRESHOLD && diff[tau] >= diff[tau - 1]) {
+                found = tau - 1;
+                break;
+            }
+        }
+
+        // No dip under the threshold: fall back to the deepest one and let confidence judge it
+        if (found < 0) found = deepest;
+        if (found < 0) {
+            this.confidence = 0;
+            return;
+        }
+
+        // Parabolic refinement of the dip
+        let lag = found;
+        if (found > 1 && found < this.maxLag) {
+            const a = diff[found - 1];
+            const b = diff[found];
+            const d = diff[found + 1];
+            const denominator = a - 2 * b + d;
+            if (denominator > 0) lag += Math.max(-0.5, Math.min(0.5, (0.5 * (a - d)) / denominator));
+        }
+
+        const confidence = Math.max(0, Math.min(1, 1 - diff[found]));
+        this.confidence = confidence;
+        if (confidence >= MIN_CONFIDENCE) {
+            this.frequency = Math.max(MIN_PITCH_HZ, Math.min(MAX_PITCH_HZ, this.rate / lag));
+        }
+    }
+}
@@ -0,0 +1,37 @@
+/**
+ * Render-thread gap detector. The audio thread renders in bursts of quanta,
+ * one burst per hardware buffer; a gap between bursts much longer than usual
+ * means the device ran dry and the output most likely glitched.
+ * Works on wall-clock milliseconds (Date.now() inside the worklet).
+ */
+
+// Calls closer than this belong to the same burst
+const BURST_MS = 1;
+
+export class RenderGapDetector {
+    private lastCall = -1;
+    private typicalGap = 0;
+
+    /**
+     * Call once per process(). Returns the gap in ms if it was a stall, else -1.
+     */
+    tick(nowMs: number): number {
+        const last = this.lastCall;
+        this.lastCall = nowMs;
+        if (last < 0) return -1;
+
+        const gap = nowMs - last;
+        if (gap < BURST_MS) return -1;
+
+        if (this.typicalGap === 0) {
+            this.typicalGap = gap;
+            return -1;
+        }
+        if (gap > Math.max(3 * this.typicalGap, this.typicalGap + 20)) {
+            // Stalls stay out of the running estimate
+            return gap;
+        }
+        this.typicalGap += 0.05 * (gap - this.typicalGap);
+        return -1;
+    }
+}
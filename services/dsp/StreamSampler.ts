@@ -0,0 +1,253 @@
+/**
+ * Streaming sampler kernel.
+ *
+ * Only the start (head) of each zone's sample is resident; the rest arrives in
+ * chunks from a reader (the sample stream worker) into a per-voice ring buffer.
+ * A voice plays from the head while its first chunks are being read, then from
+ * the ring, asking for the next chunk whenever less than half a ring is
+ * buffered ahead of the play position. Voices live in preallocated slots.
+ */
+
+export const MAX_VOICES = 16;
+export const RING_FRAMES = 32768;       // Per voice; a power of two
+export const CHUNK_FRAMES = 8192;       // At most half a ring
+
+const RING_MASK = RING_FRAMES - 1;
+const ATTACK_SECONDS = 0.002;           // Click-free start, even from an offset
+const SILENT_ENVELOPE = 1e-4;           // -80 dB: a releasing voice is freed here
+
+export interface SampleZone {
+    /** Resident head of the sample (one or two channels) */
+    head: Float32Array[];
+    /** Length of the whole sample in frames */
+    frames: number;
+}
+
+/** Ask the reader for `frames` frames from `frame` of `zone`, answered with writeChunk */
+export type ReadRequest = (slot: number, token: number, zone: number, frame: number, frames: number) => void;
+
+export class StreamSamplerKernel {
+    private readonly sampleRate: number;
+    private zones: SampleZone[] = [];
+
+    /** Called from process() when a voice needs more data */
+    public onRead: ReadRequest | null = null;
+
+    // Voice slots (noteId -1 = free)
+    private readonly noteId = new Int32Array(MAX_VOICES).fill(-1);
+    private readonly token = new Uint32Array(MAX_VOICES);
+    private readonly zone = new Int16Array(MAX_VOICES);
+    private readonly position = new Float64Array(MAX_VOICES);
+    private readonly increment = new Float64Array(MAX_VOICES);
+    private readonly gain = new Float32Array(MAX_VOICES);
+    private readonly envelope = new Float32Array(MAX_VOICES);
+    private readonly releasing = new Uint8Array(MAX_VOICES);
+    private readonly releaseCoeff = new Float32Array(MAX_VOICES);
+    private readonly startedAt = new Float64Array(MAX_VOICES);
+    // Streamed data: the ring holds frames up to ringEnd; requested runs ahead of it
+    private readonly ringEnd = new Float64Array(MAX_VOICES);
+    private readonly requested = new Float64Array(MAX_VOICES);
+    private readonly ringL: Float32Array[] = [];
+    private readonly ringR: Float32Array[] = [];
+
+    private readonly attackCoeff: number;
+    private clock = 0;
+    private underruns = 0;
+
+    constructor(sampleRate: number) {
+        this.sampleRate = sampleRate;
+        this.attackCoeff = 1 - Math.exp(-1 / (ATTACK_SECONDS * sampleRate));
+        for (let s = 0; s < MAX_VOICES; s++) {
+            this.ringL.push(new Float32Array(RING_FRAMES));
+            this.ringR.push(new Float32Array(RING_FRAMES));
+        }
+    }
+
+    /**
+     * Replace the instrument. Sounding voices stop; chunks still in flight are dropped.
+     */
+    setZones(zones: SampleZone[]): void {
+        this.zones = zones;
+        this.allOff();
+    }
+
+    /**
+     * Start a voice.
+     * @param id - Note id shared by every voice of one note (noteOff stops them together)
+     * @param increment - Sample frames advanced per output sample (pitch and rate ratio)
+     * @param startFrame - Start offset; clamped into the resident head
+     */
+    noteOn(id: number, zoneIndex: number, increment: number, gain: number, startFrame: number): void {
+        const zone = this.zones[zoneIndex];
+        if (!zone || zone.head.length === 0) return;
+        const headFrames = zone.head[0].length;
+
+        const s = this.allocate();
+        this.token[s]++;
+        this.noteId[s] = id;
+        this.zone[s] = zoneIndex;
+        this.position[s] = Math.max(0, Math.min(startFrame, headFrames - 2));
+        this.increment[s] = increment;
+        this.gain[s] = gain;
+        this.envelope[s] = 0;
+        this.releasing[s] = 0;
+        this.startedAt[s] = this.clock;
+        this.ringEnd[s] = headFrames;
+        this.requested[s] = headFrames;
+    }
+
+    /**
+     * Release every voice of a note
+     * @param releaseSeconds - Time to fade to -80 dB
+     */
+    noteOff(id: number, releaseSeconds: number): void {
+        // -80 dB is about 9.2 time constants
+        const coeff = Math.exp(-9.2 / (Math.max(0.005, releaseSeconds) * this.sampleRate));
+        for (let s = 0; s < MAX_VOICES; s++) {
+            if (this.noteId[s] === id && !this.releasing[s]) {
+                this.releasing[s] = 1;
+                this.releaseCoeff[s] = coeff;
+            }
+        }
+    }
+
+    allOff(): void {
+        for (let s = 0; s < MAX_VOICES; s++) this.free(s);
+    }
+
+    /**
+     * Store a chunk read for a voice. Chunks arrive in request order; any for a
+     * voice that has since been freed or restarted are ignored.
+     */
+    writeChunk(slot: number, token: number, frame: number, channels: Float32Array[]): void {
+        if (slot < 0 || slot >= MAX_VOICES || this.noteId[slot] < 0 || this.token[slot] !== token) return;
+        if (frame !== this.ringEnd[slot] || channels.length === 0) return;
+
+        const left = channels[0];
+        const right = channels[1] ?? left;
+        const ringL = this.ringL[slot];
+        const ringR = this.ringR[slot];
+        for (let i = 0; i < left.length; i++) {
+            const r = (frame + i) & RING_MASK;
+            ringL[r] = left[i];
+            ringR[r] = right[i];
+        }
+        this.ringEnd[slot] = frame + left.length;
+    }
+
+    process(outL: Float32Array, outR: Float32Array): void {
+        const n = outL.length;
+        outL.fill(0);
+        outR.fill(0);
+        this.clock += n;
+
+        for (let s = 0; s < MAX_VOICES; s++) {
+            if (this.noteId[s] < 0) continue;
+            const zone = this.zones[this.zone[s]];
+            if (!zone) {
+                this.free(s);
+                continue;
+            }
+
+            const headL = zone.head[0];
+            const headR = zone.head[1] ?? headL;
+            const headFrames = headL.length;
+            const frames = zone.frames;
+            const ringL = this.ringL[s];
+            const ringR = this.ringR[s];
+            const ringEnd = this.ringEnd[s];
+            const inc = this.increment[s];
+            const gain = this.gain[s];
+            const releasing = this.releasing[s] === 1;
+            const releaseCoeff = this.releaseCoeff[s];
+            let pos = this.position[s];
+            let env = this.envelope[s];
+            let starved = false;
+            let finished = false;
+
+            for (let i = 0; i < n; i++) {
+                const i0 = Math.floor(pos);
+                if (i0 + 1 >= frames) {
+                    finished = true;
+                    break;
+                }
+                const frac = pos - i0;
+
+                let l0: number, l1: number, r0: number, r1: number;
+                if (i0 + 1 < headFrames) {
+                    l0 = headL[i0]; l1 = headL[i0 + 1];
+                    r0 = headR[i0]; r1 = headR[i0 + 1];
+                } else if (i0 + 1 < ringEnd) {
+                    // i0 may still be the last head frame
+                    const a = i0 & RING_MASK;
+                    const b = (i0 + 1) & RING_MASK;
+                    l0 = i0 < headFrames ? headL[i0] : ringL[a]; l1 = ringL[b];
+                    r0 = i0 < headFrames ? headR[i0] : ringR[a]; r1 = ringR[b];
+                } else {
+                    // Reader fell behind: play silence but keep time
+                    starved = true;
+                    l0 = l1 = r0 = r1 = 0;
+                }
+
+                if (releasing) {
+                    env *= releaseCoeff;
+                } else {
+                    env += this.attackCoeff * (1 - env);
+                }
+                const g = env * gain;
+                outL[i] += (l0 + frac * (l1 - l0)) * g;
+                outR[i] += (r0 + frac * (r1 - r0)) * g;
+                pos += inc;
+            }
+
+            this.position[s] = pos;
+            this.envelope[s] = env;
+            if (starved) this.underruns++;
+            if (finished || (releasing && env < SILENT_ENVELOPE)) {
+                this.free(s);
+                continue;
+            }
+
+            // Keep half a ring buffered ahead of the play position
+            const requested = this.requested[s];
+            if (requested < frames && requested - pos < RING_FRAMES / 2 && this.onRead) {
+                const count = Math.min(CHUNK_FRAMES, frames - requested);
+                this.onRead(s, this.token[s], this.zone[s], requested, count);
+                this.requested[s] = requested + count;
+            }
+        }
+    }
+
+    getActiveVoiceCount(): number {
+        let count = 0;
+        for (let s = 0; s < MAX_VOICES; s++) if (this.noteId[s] >= 0) count++;
+        return count;
+    }
+
+    /** Blocks in which some voice ran out of streamed data */
+    getUnderrunCount(): number {
+        return this.underruns;
+    }
+
+    /**
+     * A free slot, else the quietest releasing voice, else the oldest one
+     */
+    private allocate(): number {
+        let best = -1;
+        let bestScore = Infinity;
+        for (let s = 0; s < MAX_VOICES; s++) {
+            if (this.noteId[s] < 0) return s;
+            const score = this.releasing[s] ? this.envelope[s] - 2 : this.startedAt[s];
+            if (score < bestScore) {
+                bestScore = score;
+                best = s;
+            }
+        }
+        return best;
+    }
+
+    private free(s: number): void {
+        this.noteId[s] = -1;
+        this.token[s]++;
+    }
+}
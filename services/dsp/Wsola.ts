@@ -0,0 +1,213 @@
+/**
+ * WSOLA (waveform-similarity overlap-add) loop player.
+ * Time-stretches and pitch-shifts a looped take independently:
+ * - speed: how fast the read head walks through the take (1 = original tempo)
+ * - pitch: resampling ratio applied inside each grain (1 = original pitch)
+ *
+ * Each hop places one Hann-windowed frame at 50% overlap. Before placing it,
+ * the frame start is nudged within a small window so it lines up with the
+ * natural continuation of the previous frame, which avoids the phasiness of
+ * plain overlap-add. The similarity search is coarse-to-fine on a decimated
+ * overlap, which keeps the cost to a few MACs per output sample.
+ */
+
+const CORRELATION_DECIMATION = 4;
+const COARSE_STEP = 8;
+
+export class WsolaKernel {
+    private readonly frameSize: number;
+    private readonly hopSize: number;
+    private readonly seekRange: number;
+    private readonly window: Float32Array;
+
+    // Source take (looped)
+    private left: Float32Array = new Float32Array(0);
+    private right: Float32Array = new Float32Array(0);
+    private sourceLength = 0;
+
+    // Overlap-add accumulator and the finished hop being drained
+    private readonly accL: Float32Array;
+    private readonly accR: Float32Array;
+    private readonly readyL: Float32Array;
+    private readonly readyR: Float32Array;
+    private readIndex: number;
+
+    // Read head (nominal analysis position) and the start of the last placed frame
+    private position = 0;
+    private lastFrameStart = 0;
+    private hasPreviousFrame = false;
+    private playing = false;
+
+    constructor(sampleRate: number) {
+        // ~21 ms frames at 44.1/48 kHz, doubled at high rates
+        this.frameSize = sampleRate > 64000 ? 2048 : 1024;
+        this.hopSize = this.frameSize / 2;
+        this.seekRange = this.hopSize / 2;
+
+        // Periodic Hann: two frames at 50% overlap sum to exactly 1
+        this.window = new Float32Array(this.frameSize);
+        for (let i = 0; i < this.frameSize; i++) {
+            this.window[i] = 0.5 - 0.5 * Math.cos((2 * Math.PI * i) / this.frameSize);
+        }
+
+        this.accL = new Float32Array(this.frameSize);
+        this.accR = new Float32Array(this.frameSize);
+        this.readyL = new Float32Array(this.hopSize);
+        this.readyR = new Float32Array(this.hopSize);
+        this.readIndex = this.hopSize;
+    }
+
+    setSource(channels: Float32Array[]): void {
+        this.left = channels[0] ?? new Float32Array(0);
+        this.right = channels[1] ?? this.left;
+        this.sourceLength = this.left.length;
+        this.restart();
+    }
+
+    setPlaying(playing: boolean): void {
+        if (playing && !this.playing) this.restart();
+        this.playing = playing;
+    }
+
+    isPlaying(): boolean {
+        return this.playing;
+    }
+
+    /**
+     * Current read position, 0..1 of the take
+     */
+    getPosition(): number {
+        return this.sourceLength > 0 ? this.position / this.sourceLength : 0;
+    }
+
+    private restart(): void {
+        this.position = 0;
+        this.hasPreviousFrame = false;
+        this.accL.fill(0);
+        this.accR.fill(0);
+        this.readIndex = this.hopSize;
+    }
+
+    /**
+     * Render one block. Always overwrites the outputs.
+     */
+    process(outL: Float32Array, outR: Float32Array, speed: number, pitch: number): void {
+        const blockLength = outL.length;
+        if (!this.playing || this.sourceLength < this.frameSize * 2) {
+            outL.fill(0);
+            outR.fill(0);
+            return;
+        }
+
+        let written = 0;
+        while (written < blockLength) {
+            if (this.readIndex >= this.hopSize) {
+                this.synthesizeHop(speed, pitch);
+            }
+            const count = Math.min(blockLength - written, this.hopSize - this.readIndex);
+            outL.set(this.readyL.subarray(this.readIndex, this.readIndex + count), written);
+            outR.set(this.readyR.subarray(this.readIndex, this.readIndex + count), written);
+            this.readIndex += count;
+            written += count;
+        }
+    }
+
+    private synthesizeHop(speed: number, pitch: number): void {
+        const hop = this.hopSize;
+        const frame = this.frameSize;
+
+        let start = this.position;
+        if (this.hasPreviousFrame) {
+            start += this.findBestOffset(this.lastFrameStart + hop * pitch, this.position, pitch);
+        }
+        start = this.wrap(start);
+
+        // Overlap-add the new frame, read at the pitch ratio
+        const left = this.left;
+        const right = this.right;
+        const length = this.sourceLength;
+        const window = this.window;
+        let p = start;
+        for (let k = 0; k < frame; k++) {
+            const idx = p | 0;
+            const next = idx + 1 < length ? idx + 1 : 0;
+            const frac = p - idx;
+            const w = window[k];
+            this.accL[k] += (left[idx] + (left[next] - left[idx]) * frac) * w;
+            this.accR[k] += (right[idx] + (right[next] - right[idx]) * frac) * w;
+            p += pitch;
+            if (p >= length) p -= length;
+        }
+
+        // First half is complete: hand it out and shift the accumulator
+        this.readyL.set(this.accL.subarray(0, hop));
+        this.readyR.set(this.accR.subarray(0, hop));
+        this.accL.copyWithin(0, hop);
+        this.accR.copyWithin(0, hop);
+        this.accL.fill(0, hop);
+        this.accR.fill(0, hop);
+        this.readIndex = 0;
+
+        this.lastFrameStart = start;
+        this.hasPreviousFrame = true;
+        this.position = this.wrap(this.position + hop * speed);
+    }
+
+    /**
+     * Offset (in source samples) around `nominal` whose frame best matches the
+     * natural continuation of the previous frame. Normalised cross-correlation
+     * over a decimated overlap; coarse grid first, then refined around the peak.
+     */
+    private findBestOffset(continuation: number, nominal: number, pitch: number): number {
+        const range = this.seekRange;
+        let best = 0;
+        let bestScore = -Infinity;
+
+        for (let offset = -range; offset <= range; offset += COARSE_STEP) {
+            const score = this.similarity(continuation, nominal + offset, pitch);
+            if (score > bestScore) {
+                bestScore = score;
+                best = offset;
+            }
+        }
+
+        const coarseBest = best;
+        const lo = Math.max(-range, coarseBest - COARSE_STEP + 1);
+        const hi = Math.min(range, coarseBest + COARSE_STEP - 1);
+        for (let offset = lo; offset <= hi; offset++) {
+            if (offset === coarseBest) continue;
+            const score = this.similarity(continuation, nominal + offset, pitch);
+            if (score > bestScore) {
+                bestScore = score;
+                best = offset;
+            }
+        }
+        return best;
+    }
+
+    private similarity(template: number, candidate: number, pitch: number): number {
+        const data = this.left;
+        const length = this.sourceLength;
+        const step = pitch * CORRELATION_DECIMATION;
+        let a = this.wrap(template);
+        let b = this.wrap(candidate);
+        let cross = 0;
+        let energy = 1e-9;
+        for (let k = 0; k < this.hopSize; k += CORRELATION_DECIMATION) {
+            const y = data[b | 0];
+            cross += data[a | 0] * y;
+            energy += y * y;
+            a += step;
+            if (a >= length) a -= length;
+            b += step;
+            if (b >= length) b -= length;
+        }
+        return cross / Math.sqrt(energy);
+    }
+
+    private wrap(position: number): number {
+        const length = this.sourceLength;
+        position %= length;
+        return position < 0 ? position + length : position;
+    }
+}
@@ -1,12 +1,29 @@
-import { SynthState } from '../../types';
+import { SynthState, StepPattern } from '../../types';
 import { AbstractSynthEngine } from '../AbstractSynthEngine';
-import { createReverbImpulse } from '../audioUtils';
+import { tracer } from '../Tracer';
+import { timingTelemetry } from '../TimingTelemetry';
+import { sharedReverbImpulse } from '../audioUtils';
+import { ModMatrix } from '../ModMatrix';
+import { performanceLog } from '../PerformanceLog';
+
+/** Sequencer state carried between offline render chunks */
+interface BreitemaSnapshot {
+    playing: boolean;
+    step: number;
+    nextStepIn: number;
+    sweepElapsed: number;
+    steps: boolean[];
+    probabilities: number[];
+    rhythmMode: 'libre' | 'muineira' | 'ribeirada';
+}
 
 /**
  * Brétema Grid - Generative Step Sequencer
  * Probabilistic sequencer with FM synthesis, lo-fi aesthetics, and Galician rhythmic modes.
  */
 export class BreitemaEngine extends AbstractSynthEngine {
+    protected readonly traceCategory = 'breitema';
+
     // Sequencer state
     private readonly NUM_STEPS = 16;
     private steps: boolean[] = new Array(16).fill(false);
@@ -20,9 +37,12 @@ export class BreitemaEngine extends AbstractSynthEngine {
     private nextStepTime = 0;
     private readonly SCHEDULE_AHEAD_TIME = 0.1;
     private readonly LOOK_AHEAD_MS = 25;
+    // Offline rendering drives the scheduler through advanceTo() instead of timers
+    private manualClock = false;
 
     // Rhythm modes: 'libre' | 'muineira' | 'ribeirada'
     private rhythmMode: 'libre' | 'muineira' | 'ribeirada' = 'libre';
+    private hasPattern = false;
 
     // FM Synthesis
     private carrier: OscillatorNode | null = null;
@@ -41,8 +61,10 @@ export class BreitemaEngine extends AbstractSynthEngine {
     // Niebla (fog) modulation
     private fogDensity = 0.5;
     private fogMovement = 0.2;
-    private fogLfo: OscillatorNode | null = null;
-    private fogLfoGain: GainNode | null = null;
+    // Context time the probability sweep is measured from (moves when a render chunk restores state)
+    private sweepOrigin = 0;
+    // Fog LFO swells the reverb send (target 0 = reverbGain.gain)
+    private fogModulation: ModMatrix | null = null;
 
     // Note frequencies for melodic mode
     private readonly SCALE_NOTES = [
@@ -80,7 +102,7 @@ export class BreitemaEngine extends AbstractSynthEngine {
 
         // Reverb
         this.reverb = ctx.createConvolver();
-        this.reverb.buffer = createReverbImpulse(ctx, 4, 3);
+        this.reverb.buffer = sharedReverbImpulse(ctx, 4, 3);
 
         this.reverbGain = ctx.createGain();
         this.reverbGain.gain.value = 0.3;
@@ -88,14 +110,9 @@ export class BreitemaEngine extends AbstractSynthEngine {
         this.dryGain = ctx.createGain();
         this.dryGain.gain.value = 0.7;
 
-        // Fog LFO (modulates step probabilities)
-        this.fogLfo = ctx.createOscillator();
-        this.fogLfo.type = 'sine';
-        this.fogLfo.frequency.value = 0.1;
-        this.fogLfoGain = ctx.createGain();
-        this.fogLfoGain.gain.value = 0.3;
-        this.fogLfo.connect(this.fogLfoGain);
-        this.fogLfo.start();
+        // Fog LFO
+        this.fogModulation = new ModMatrix(ctx, [this.reverbGain.gain]);
+        this.fogModulation.setLfo(0, 0.1, 'sine');
 
         // Routing: filter -> [dry + reverb] -> compressor -> destination
         this.filter.connect(this.dryGain);
@@ -112,14 +129,25 @@ export class BreitemaEngine extends AbstractSynthEngine {
             masterGain.connect(ctx.destination);
         }
 
-        // Initialize random step pattern
-        this.generateRandomPattern();
+        // Initialize random step pattern (unless a scene already set one)
+        if (!this.hasPattern) {
+            this.fillPattern();
+        }
     }
 
     /**
      * Generate a random step pattern based on rhythm mode
      */
+    protected onSeed(seed: number): void {
+        this.fogModulation?.setSeed(seed);
+    }
+
     generateRandomPattern(): void {
+        performanceLog.randomize(this.traceCategory);
+        this.fillPattern();
+    }
+
+    private fillPattern(): void {
         const pattern = this.rhythmMode === 'muineira' ? this.MUINEIRA_PATTERN :
             this.rhythmMode === 'ribeirada' ? this.RIBEIRADA_PATTERN :
                 null;
@@ -129,8 +157,8 @@ export class BreitemaEngine extends AbstractSynthEngine {
                 this.stepProbabilities[i] = pattern[i];
                 this.steps[i] = pattern[i] > 0.5;
             } else {
-                this.stepProbabilities[i] = Math.random();
-                this.steps[i] = Math.random() > 0.5;
+                this.stepProbabilities[i] = this.random();
+                this.steps[i] = this.random() > 0.5;
             }
         }
     }
@@ -147,6 +175,8 @@ export class BreitemaEngine extends AbstractSynthEngine {
         this.isPlaying = true;
         this.currentStep = 0;
         this.nextStepTime = ctx.currentTime;
+        this.sweepOrigin = ctx.currentTime;
+        performanceLog.transport(this.traceCategory, true);
 
         // Restore volume - Reduced to prevent distortion
         if (this.masterGain) {
@@ -160,6 +190,7 @@ export class BreitemaEngine extends AbstractSynthEngine {
      * Stop the sequencer
      */
     stopSequencer(): void {
+        if (this.isPlaying) performanceLog.transport(this.traceCategory, false);
         this.isPlaying = false;
         if (this.schedulerTimerId) {
             clearTimeout(this.schedulerTimerId);
@@ -185,7 +216,7 @@ export class BreitemaEngine extends AbstractSynthEngine {
             this.advanceStep();
         }
 
-        if (this.isPlaying) {
+        if (this.isPlaying && !this.manualClock) {
             this.schedulerTimerId = window.setTimeout(() => this.scheduler(), this.LOOK_AHEAD_MS);
         }
     }
@@ -196,6 +227,9 @@ export class BreitemaEngine extends AbstractSynthEngine {
     private scheduleStep(step: number, time: number): void {
         const ctx = this.getContext();
         if (!ctx || !this.filter) return;
+        if (__TRACE__) tracer.instant(this.traceCategory, 'step', step);
+        // Offline renders are not live timing
+        if (!this.manualClock) timingTelemetry.recordSlack(this.traceCategory, time - ctx.currentTime);
 
         // Base probability is the step's own probability
         const baseProb = this.stepProbabilities[step];
@@ -205,13 +239,16 @@ export class BreitemaEngine extends AbstractSynthEngine {
         let prob = baseProb + (1 - baseProb) * (this.fogDensity - 0.2) / 0.8;
 
         // Add periodic modulation (fog movement)
-        prob += (Math.sin(time * this.fogMovement * Math.PI) * 0.15);
+        prob += (Math.sin((time - this.sweepOrigin) * this.fogMovement * Math.PI) * 0.15);
 
         // Clamp to [0.05, 1.0] so active steps have at least a small chance or full certainty
         prob = Math.max(0.05, Math.min(1, prob));
 
         // Probabilistic trigger: if step is active and passes random check
-        if (this.steps[step] && Math.random() < prob) {
+        if (this.steps[step] && this.random() < prob) {
+            if (__TRACE__) tracer.instant(this.traceCategory, 'note', step);
+            // A step queued after its time has passed sounds immediately, i.e. late
+            if (!this.manualClock) timingTelemetry.recordHit(this.traceCategory, time, Math.max(time, ctx.currentTime));
             this.playFMNote(time, step);
         }
     }
@@ -277,11 +314,69 @@ export class BreitemaEngine extends AbstractSynthEngine {
         this.currentStep = (this.currentStep + 1) % this.NUM_STEPS;
     }
 
+    /**
+     * Offline rendering: schedule every step before `time`. The first call
+     * hands the sequencer over to the caller (no more timers).
+     */
+    advanceTo(time: number): void {
+        if (!this.manualClock) {
+            this.manualClock = true;
+            if (this.schedulerTimerId) {
+                clearTimeout(this.schedulerTimerId);
+                this.schedulerTimerId = null;
+            }
+        }
+        if (!this.isPlaying) return;
+
+        while (this.nextStepTime < time) {
+            this.scheduleStep(this.currentStep, this.nextStepTime);
+            this.advanceStep();
+        }
+    }
+
+    saveState(): BreitemaSnapshot {
+        const now = this.ctx?.currentTime ?? 0;
+        return {
+            playing: this.isPlaying,
+            step: this.currentStep,
+            nextStepIn: this.nextStepTime - now,
+            sweepElapsed: now - this.sweepOrigin,
+            steps: [...this.steps],
+            probabilities: [...this.stepProbabilities],
+            rhythmMode: this.rhythmMode
+        };
+    }
+
+    restoreState(snapshot: unknown): void {
+        const ctx = this.getContext();
+        if (!ctx) return;
+        const s = snapshot as BreitemaSnapshot;
+        const now = ctx.currentTime;
+
+        this.currentStep = s.step;
+        this.nextStepTime = now + s.nextStepIn;
+        this.sweepOrigin = now - s.sweepElapsed;
+        this.steps = [...s.steps];
+        this.stepProbabilities = [...s.probabilities];
+        this.rhythmMode = s.rhythmMode;
+        this.hasPattern = true;
+
+        this.isPlaying = s.playing;
+        if (s.playing) this.masterGain?.gain.setValueAtTime(1.0, now);
+        // A live engine rebuilt mid-pattern keeps playing; offline renders advance it themselves
+        if (s.playing && !this.manualClock) {
+            if (this.schedulerTimerId) clearTimeout(this.schedulerTimerId);
+            this.schedulerTimerId = null;
+            this.scheduler();
+        }
+    }
+
     /**
      * Toggle a step on/off
      */
     toggleStep(step: number): void {
         if (step >= 0 && step < this.NUM_STEPS) {
+            performanceLog.step(this.traceCategory, step);
             this.steps[step] = !this.steps[step];
         }
     }
@@ -290,8 +385,28 @@ export class BreitemaEngine extends AbstractSynthEngine {
      * Set rhythm mode
      */
     setRhythmMode(mode: 'libre' | 'muineira' | 'ribeirada'): void {
+        performanceLog.rhythm(this.traceCategory, mode);
         this.rhythmMode = mode;
-        this.generateRandomPattern();
+        this.fillPattern();
+    }
+
+    /**
+     * Load a full step pattern (e.g. from a scene). Probabilities follow the
+     * rhythm mode's accent table, or stay as they are in 'libre'.
+     */
+    setPattern(pattern: StepPattern): void {
+        if (pattern.rhythmMode) {
+            this.rhythmMode = pattern.rhythmMode;
+        }
+        const accents = this.rhythmMode === 'muineira' ? this.MUINEIRA_PATTERN :
+            this.rhythmMode === 'ribeirada' ? this.RIBEIRADA_PATTERN :
+                null;
+
+        for (let i = 0; i < this.NUM_STEPS; i++) {
+            this.steps[i] = !!pattern.steps[i];
+            if (accents) this.stepProbabilities[i] = accents[i];
+        }
+        this.hasPattern = true;
     }
 
     /**
@@ -308,6 +423,13 @@ export class BreitemaEngine extends AbstractSynthEngine {
         };
     }
 
+    /**
+     * Sequencer tempo in BPM, the shared clock loops can be fitted to
+     */
+    getTempo(): number {
+        return this.tempo;
+    }
+
     getRhythmMode(): string {
         return this.rhythmMode;
     }
@@ -332,9 +454,10 @@ export class BreitemaEngine extends AbstractSynthEngine {
 
         // Turbulence -> Fog movement (LFO speed)
         this.fogMovement = state.turbulence * 2;
-        this.fogLfo?.frequency.setTargetAtTime(0.05 + state.turbulence * 0.5, t, 0.1);
+        this.fogModulation?.setLfo(0, 0.05 + state.turbulence * 0.5, 'sine');
 
-        // Diffusion -> Reverb mix
+        // Diffusion -> Reverb mix (the fog swell stays within the send level)
+        this.fogModulation?.route('lfo1', 0, state.diffusion * 0.3 * Math.min(1, this.fogMovement));
         this.reverbGain?.gain.setTargetAtTime(state.diffusion * 0.6, t, 0.1);
         this.dryGain?.gain.setTargetAtTime(1 - state.diffusion * 0.4, t, 0.1);
 
@@ -354,4 +477,24 @@ export class BreitemaEngine extends AbstractSynthEngine {
     reset(): void {
         this.stopSequencer();
     }
+
+    /**
+     * Cleanup method to be called when destroying the engine.
+     */
+    public destroy(): void {
+        // Torn down, not stopped: no transport event for the performance log
+        this.isPlaying = false;
+        if (this.schedulerTimerId) {
+            clearTimeout(this.schedulerTimerId);
+            this.schedulerTimerId = null;
+        }
+        this.fogModulation?.dispose();
+        this.fogModulation = null;
+        this.bitcrusher?.disconnect();
+        this.filter?.disconnect();
+        this.reverb?.disconnect();
+        this.reverbGain?.disconnect();
+        this.dryGain?.disconnect();
+        this.masterGain?.disconnect();
+    }
 }
@@ -1,31 +1,49 @@
 import { SynthState } from '../../types';
 import { AbstractSynthEngine } from '../AbstractSynthEngine';
-import { makeDistortionCurve, createReverbImpulse, createNoiseBuffer } from '../audioUtils';
+import { sharedDistortionCurve, sharedReverbImpulse, sharedNoiseBuffer } from '../audioUtils';
+import { AdditiveBank } from '../AdditiveBank';
+import { EXPRESSION_LANES, EXPRESSION_STRIDE } from '../dsp/AdditiveBank';
+import { DelayNetwork } from '../DelayNetwork';
+import { ModMatrix } from '../ModMatrix';
+import { VoiceExpression } from '../VoiceExpression';
+import { PitchTracker } from '../PitchTracker';
+
+const REVERB_SECONDS = 6;
+// Delay settings for a state (also used by tailSeconds)
+const delayTime = (state: SynthState) => 0.1 + state.diffusion * 2.5;
+const delayFeedback = (state: SynthState) => 0.1 + state.resonance * 0.85;
 
 /**
  * Criosfera Armónica - Deep resonance physical modeling synthesizer
  * Simulates giant organic pipes in cryogenic methane oceans.
  */
 export class CriosferaEngine extends AbstractSynthEngine {
+  protected readonly traceCategory = 'criosfera';
+
   private oscillators: Map<number, {
-    osc1: OscillatorNode;
-    osc2: OscillatorNode;
+    voiceId: number;
     noise: AudioBufferSourceNode;
+    noiseFilter: BiquadFilterNode;
     filter: BiquadFilterNode;
-    gain: GainNode
+    gain: GainNode;
+    // Expression lane driving this note (touch surface), if any
+    lane?: number;
   }> = new Map();
 
   private reverb: ConvolverNode | null = null;
-  private delay: DelayNode | null = null;
-  private delayFeedback: GainNode | null = null;
+  private delay: DelayNetwork | null = null;
   private lowPass: BiquadFilterNode | null = null;
   private distortion: WaveShaperNode | null = null;
 
   // Audio output tap for vocoder carrier
   private outputTap: GainNode | null = null;
-  private lfo: OscillatorNode | null = null;
-  private lfoFilterGain: GainNode | null = null;
-  private lfoDelayGain: GainNode | null = null;
+  // Filter LFO and drift, evaluated on the audio thread (target 0 = lowPass.frequency)
+  private modulation: ModMatrix | null = null;
+
+  // Ghost harmonics: every note's tonal partials live in one additive bank
+  private harmonics: AdditiveBank | null = null;
+  // Tracked voice the keyboard voices are transposed by, if any
+  private pitchSource: PitchTracker | null = null;
 
   private noiseBuffer: AudioBuffer | null = null;
   private currentState: SynthState | null = null;
@@ -43,7 +61,12 @@ export class CriosferaEngine extends AbstractSynthEngine {
     // Set custom master gain - boosted from 0.8
     masterGain.gain.value = 1.0;
 
-    this.noiseBuffer = createNoiseBuffer(ctx, 2);
+    this.noiseBuffer = sharedNoiseBuffer(ctx, 2);
+
+    this.harmonics = new AdditiveBank(ctx);
+    this.harmonics.output.connect(masterGain);
+    // Tonal partials read the lanes themselves; the noise layer follows once per frame
+    this.harmonics.expression.onFrame(() => this.followExpression());
 
     this.lowPass = ctx.createBiquadFilter();
     this.lowPass.type = 'lowpass';
@@ -51,26 +74,18 @@ export class CriosferaEngine extends AbstractSynthEngine {
     this.lowPass.Q.value = 1;
 
     this.distortion = ctx.createWaveShaper();
-    this.distortion.curve = makeDistortionCurve(0);
+    this.distortion.curve = sharedDistortionCurve(0);
     this.distortion.oversample = '4x';
 
     this.reverb = ctx.createConvolver();
-    this.reverb.buffer = createReverbImpulse(ctx, 6, 2);
+    this.reverb.buffer = sharedReverbImpulse(ctx, REVERB_SECONDS, 2);
 
-    this.delay = ctx.createDelay(4.0);
-    this.delay.delayTime.value = 0.5;
-    this.delayFeedback = ctx.createGain();
-    this.delayFeedback.gain.value = 0.4;
+    // Feedback loop, its damping and the time modulation all run inside one node
+    this.delay = new DelayNetwork(ctx, 4.0, { time: 0.5, feedback: 0.4, modRate: 0.1 });
 
-    this.lfo = ctx.createOscillator();
-    this.lfo.type = 'sawtooth';
-    this.lfo.frequency.value = 0.1;
-
-    this.lfoFilterGain = ctx.createGain();
-    this.lfoFilterGain.gain.value = 0;
-
-    this.lfoDelayGain = ctx.createGain();
-    this.lfoDelayGain.gain.value = 0;
+    this.modulation = new ModMatrix(ctx, [this.lowPass.frequency]);
+    this.modulation.setLfo(0, 0.1, 'saw');
+    this.modulation.setRandom(0.3);
 
     // Connect main chain: masterGain -> distortion -> lowPass -> Global Master Bus
     // NOTE: No internal compressor - we use the global masterLimiter only
@@ -85,17 +100,14 @@ export class CriosferaEngine extends AbstractSynthEngine {
 
     // Connect reverb and delay in parallel to masterBus
     this.lowPass.connect(this.reverb!);
-    this.lowPass.connect(this.delay!);
-
-    this.delay!.connect(this.delayFeedback!);
-    this.delayFeedback!.connect(this.delay!);
+    this.lowPass.connect(this.delay.input);
 
     // Route effects to masterBus (not the removed compressor)
     if (this.masterBus) {
-      this.delay!.connect(this.masterBus);
+      this.delay.output.connect(this.masterBus);
       this.reverb!.connect(this.masterBus);
     } else {
-      this.delay!.connect(ctx.destination);
+      this.delay.output.connect(ctx.destination);
       this.reverb!.connect(ctx.destination);
     }
 
@@ -106,20 +118,12 @@ export class CriosferaEngine extends AbstractSynthEngine {
     this.lowPass.connect(this.outputTap);
     // The outputTap itself should not connect to ctx.destination directly,
     // but rather be available for external connections (e.g., vocoder)
-
-    this.lfo.connect(this.lfoFilterGain);
-    this.lfoFilterGain.connect(this.lowPass.frequency);
-
-    this.lfo.connect(this.lfoDelayGain);
-    this.lfoDelayGain.connect(this.delay.delayTime);
-
-    this.lfo.start();
   }
 
   updateParameters(state: SynthState) {
     const ctx = this.getContext();
     const masterGain = this.getMasterGain();
-    if (!ctx || !masterGain || !this.lowPass || !this.delayFeedback || !this.distortion) return;
+    if (!ctx || !masterGain || !this.lowPass || !this.delay || !this.distortion) return;
 
     this.currentState = state;
     const timeConstant = 0.2;
@@ -127,16 +131,22 @@ export class CriosferaEngine extends AbstractSynthEngine {
     const targetGain = 0.3 + (state.pressure * 0.7); // Boosted from 0.2 + 0.6
     masterGain.gain.setTargetAtTime(targetGain, ctx.currentTime, timeConstant);
 
-    if (this.lfo && this.lfoFilterGain && this.lfoDelayGain) {
+    this.harmonics?.setShape(state, timeConstant);
+
+    if (this.modulation) {
       // Turbulence controls LFO - softened curve for less aggressive modulation
       const lfoSpeed = 0.1 + state.turbulence * 8; // Was pow(t,2)*25, now linear 0.1-8.1 Hz
-      this.lfo.frequency.setTargetAtTime(lfoSpeed, ctx.currentTime, timeConstant);
+      this.modulation.setLfo(0, lfoSpeed, 'saw');
 
       const filterDepth = 50 + state.turbulence * 1200; // Was pow(t,2)*3000, now linear 50-1250 Hz
-      this.lfoFilterGain.gain.setTargetAtTime(filterDepth, ctx.currentTime, timeConstant);
+      this.modulation.route('lfo1', 0, filterDepth);
+      // Slow random drift on top, so the sweep never repeats exactly
+      this.modulation.route('random', 0, state.turbulence * 300);
 
+      // Same rate drives the delay's own (interpolated) time modulation
+      this.delay.set('modRate', lfoSpeed, timeConstant);
       const delayModDepth = state.turbulence * 0.015; // Slightly reduced
-      this.lfoDelayGain.gain.setTargetAtTime(delayModDepth, ctx.currentTime, timeConstant);
+      this.delay.set('modDepth', delayModDepth, timeConstant);
     }
 
     const minFreq = 100;
@@ -145,30 +155,30 @@ export class CriosferaEngine extends AbstractSynthEngine {
     this.lowPass.frequency.setTargetAtTime(Math.max(minFreq, viscosityFreq), ctx.currentTime, timeConstant);
 
     this.lowPass.Q.setTargetAtTime(0.5 + (state.resonance * 15), ctx.currentTime, timeConstant);
-    this.delayFeedback.gain.setTargetAtTime(0.1 + (state.resonance * 0.85), ctx.currentTime, timeConstant);
+    this.delay.set('feedback', delayFeedback(state), timeConstant);
+    this.delay.set('time', delayTime(state), 1.0);
+  }
 
-    if (this.delay) {
-      this.delay.delayTime.setTargetAtTime(0.1 + state.diffusion * 2.5, ctx.currentTime, 1.0);
-    }
+  /**
+   * -60 dB decay for a state: the reverb impulse, or the delay's echoes when they
+   * ring longer (up to minutes with high resonance and long diffusion)
+   */
+  static tailSeconds(state: SynthState): number {
+    const echoes = delayTime(state) * Math.log(1000) / -Math.log(delayFeedback(state));
+    return Math.max(REVERB_SECONDS, echoes);
   }
 
   playNote(frequency: number, velocity: number = 0.8): number | undefined {
     const ctx = this.getContext();
     const masterGain = this.getMasterGain();
-    if (!ctx || !masterGain || !this.noiseBuffer) return;
+    if (!ctx || !masterGain || !this.noiseBuffer || !this.harmonics) return;
 
     const t = ctx.currentTime;
 
-    const osc1 = ctx.createOscillator();
-    osc1.type = 'sawtooth';
-    osc1.frequency.setValueAtTime(frequency, t);
-    osc1.detune.setValueAtTime((Math.random() - 0.5) * 15, t);
-
-    const osc2 = ctx.createOscillator();
-    osc2.type = 'triangle';
-    osc2.frequency.setValueAtTime(frequency, t);
-    osc2.detune.setValueAtTime((Math.random() - 0.5) * 25 - 15, t);
+    // Tonal part: harmonic + ghost partials from the shared bank (its own envelope and sweep)
+    const voiceId = this.harmonics.noteOn(frequency, velocity);
 
+    // Atmospheric part: filtered noise per note
     const noise = ctx.createBufferSource();
     noise.buffer = this.noiseBuffer;
     noise.loop = true;
@@ -178,10 +188,6 @@ export class CriosferaEngine extends AbstractSynthEngine {
     noiseFilter.frequency.value = frequency * 2;
     noiseFilter.Q.value = 1;
 
-    const toneHighPass = ctx.createBiquadFilter();
-    toneHighPass.type = 'highpass';
-    toneHighPass.frequency.setValueAtTime(frequency * 0.9, t);
-
     const filter = ctx.createBiquadFilter();
     filter.type = 'lowpass';
     filter.frequency.setValueAtTime(frequency * 0.8, t);
@@ -193,52 +199,144 @@ export class CriosferaEngine extends AbstractSynthEngine {
     // Smooth attack ramp to avoid clicks (increased to 0.05 for "organic" feel and safety)
     gain.gain.linearRampToValueAtTime(velocity * 0.8, t + 0.05); // Boosted from 0.6
 
-    // Start oscillator gains at 0 and ramp up to avoid clicks
-    // Less tonal: oscillators reduced, noise boosted for atmospheric sound
-    const osc1Gain = ctx.createGain();
-    osc1Gain.gain.value = 0;
-    osc1Gain.gain.setValueAtTime(0, t);
-    osc1Gain.gain.linearRampToValueAtTime(0.12, t + 0.05); // Boosted from 0.08
-
-    const osc2Gain = ctx.createGain();
-    osc2Gain.gain.value = 0;
-    osc2Gain.gain.setValueAtTime(0, t);
-    osc2Gain.gain.linearRampToValueAtTime(0.09, t + 0.05); // Boosted from 0.06
-
     const noiseGain = ctx.createGain();
     noiseGain.gain.value = 0;
     noiseGain.gain.setValueAtTime(0, t);
     noiseGain.gain.linearRampToValueAtTime(0.8, t + 0.05); // Boosted from 0.7
 
-    osc1.connect(toneHighPass);
-    osc2.connect(toneHighPass);
-
-    toneHighPass.connect(osc1Gain).connect(filter);
-    toneHighPass.connect(osc2Gain).connect(filter);
-
     noise.connect(noiseFilter).connect(noiseGain).connect(filter);
 
     filter.connect(gain);
     gain.connect(masterGain);
 
-    osc1.start();
-    osc2.start();
     noise.start();
 
     const id = Date.now() + Math.random();
-    this.oscillators.set(id, { osc1, osc2, noise, filter, gain });
+    this.oscillators.set(id, { voiceId, noise, noiseFilter, filter, gain });
+
+    return id;
+  }
+
+  protected onSeed(seed: number): void {
+    this.harmonics?.setSeed(seed);
+    this.modulation?.setSeed(seed);
+  }
+
+  /**
+   * Touch-surface lanes, so a held lane voice resumes where its finger was
+   */
+  saveState(): { lanes: number[] } | undefined {
+    const expression = this.getExpression();
+    return expression ? { lanes: Array.from(expression.values) } : undefined;
+  }
+
+  restoreState(snapshot: unknown): void {
+    const expression = this.getExpression();
+    const lanes = (snapshot as { lanes?: number[] } | undefined)?.lanes;
+    if (!expression || !lanes) return;
+    for (let lane = 0; lane < EXPRESSION_LANES; lane++) {
+      const i = lane * EXPRESSION_STRIDE;
+      expression.set(lane, lanes[i], lanes[i + 1], lanes[i + 2]);
+    }
+    expression.flush();
+  }
+
+  /**
+   * Expression lanes for the touch surface: write a lane, then playExpressive(lane)
+   */
+  getExpression(): VoiceExpression | null {
+    return this.harmonics?.expression ?? null;
+  }
+
+  /**
+   * Start a note whose pitch, brightness and pressure follow an expression lane
+   * until it is stopped. The lane must already hold the starting values.
+   */
+  playExpressive(lane: number, velocity: number = 0.8): number | undefined {
+    const ctx = this.getContext();
+    const masterGain = this.getMasterGain();
+    const expression = this.getExpression();
+    if (!ctx || !masterGain || !this.noiseBuffer || !this.harmonics || !expression) return;
 
+    const t = ctx.currentTime;
+    const frequency = expression.getFrequency(lane);
+    const voiceId = this.harmonics.noteOn(frequency, velocity, lane);
+
+    const noise = ctx.createBufferSource();
+    noise.buffer = this.noiseBuffer;
+    noise.loop = true;
+
+    const noiseFilter = ctx.createBiquadFilter();
+    noiseFilter.type = 'bandpass';
+    noiseFilter.frequency.value = frequency * 2;
+    noiseFilter.Q.value = 1;
+
+    // No opening sweep: the finger's brightness sets the cutoff from the start
+    const filter = ctx.createBiquadFilter();
+    filter.type = 'lowpass';
+    filter.frequency.value = this.expressiveCutoff(lane);
+
+    const gain = ctx.createGain();
+    gain.gain.value = 0;
+    gain.gain.setValueAtTime(0, t);
+    gain.gain.linearRampToValueAtTime(velocity * 0.8, t + 0.05);
+
+    const noiseGain = ctx.createGain();
+    noiseGain.gain.value = 0.8;
+
+    noise.connect(noiseFilter).connect(noiseGain).connect(filter);
+    filter.connect(gain);
+    gain.connect(masterGain);
+    noise.start();
+
+    const id = Date.now() + Math.random();
+    this.oscillators.set(id, { voiceId, noise, noiseFilter, filter, gain, lane });
     return id;
   }
 
+  /**
+   * Transpose the tonal partials of every keyboard note by a tracked pitch
+   * (relative to C3), so held chords move with a singer. Touch-surface notes
+   * keep their own pitch; the noise layer stays where it was played.
+   */
+  setPitchSource(tracker: PitchTracker | null) {
+    if (tracker === this.pitchSource || !this.harmonics) return;
+    this.pitchSource?.frequency.disconnect(this.harmonics.follow);
+    this.pitchSource = tracker;
+    tracker?.frequency.connect(this.harmonics.follow);
+  }
+
+  // Noise lowpass for a lane: opens with brightness, closes as the finger lifts off
+  private expressiveCutoff(lane: number): number {
+    const expression = this.getExpression()!;
+    const frequency = expression.getFrequency(lane);
+    return frequency * (0.8 + expression.getBrightness(lane) * 4) * (0.5 + expression.getPressure(lane) * 0.5);
+  }
+
+  private followExpression() {
+    const ctx = this.getContext();
+    const expression = this.getExpression();
+    if (!ctx || !expression) return;
+    const t = ctx.currentTime;
+    this.oscillators.forEach(note => {
+      if (note.lane === undefined) return;
+      note.noiseFilter.frequency.setTargetAtTime(expression.getFrequency(note.lane) * 2, t, 0.02);
+      note.filter.frequency.setTargetAtTime(this.expressiveCutoff(note.lane), t, 0.02);
+    });
+  }
+
   stopNote(id: number) {
     const note = this.oscillators.get(id);
     const ctx = this.getContext();
     if (note && ctx) {
+      // Released notes stop following their lane, which may go to another finger
+      note.lane = undefined;
       const releaseTime = 1.0 + (this.currentState ? this.currentState.viscosity * 3 : 0);
 
       const t = ctx.currentTime;
 
+      this.harmonics?.noteOff(note.voiceId, releaseTime * 0.3);
+
       // Get current value first, then cancel, then set from current value to avoid clicks
       const currentGain = note.gain.gain.value;
       note.gain.gain.cancelScheduledValues(t);
@@ -252,11 +350,7 @@ export class CriosferaEngine extends AbstractSynthEngine {
 
       setTimeout(() => {
         if (this.oscillators.has(id)) {
-          note.osc1.stop();
-          note.osc2.stop();
           note.noise.stop();
-          note.osc1.disconnect();
-          note.osc2.disconnect();
           note.noise.disconnect();
           this.oscillators.delete(id);
         }
@@ -270,4 +364,25 @@ export class CriosferaEngine extends AbstractSynthEngine {
   public getOutputTap(): GainNode | null {
     return this.outputTap;
   }
+
+  /**
+   * Cleanup method to be called when destroying the engine.
+   */
+  public destroy(): void {
+    // Pending release timers find their note gone and do nothing
+    this.oscillators.forEach(note => {
+      note.noise.stop();
+      note.noise.disconnect();
+    });
+    this.oscillators.clear();
+    this.setPitchSource(null);
+    this.harmonics?.expression.dispose();
+    this.harmonics?.output.disconnect();
+    this.modulation?.dispose();
+    this.delay?.output.disconnect();
+    this.reverb?.disconnect();
+    this.lowPass?.disconnect();
+    this.outputTap?.disconnect();
+    this.masterGain?.disconnect();
+  }
 }
@@ -1,25 +1,48 @@
 import { SynthState } from '../../types';
 import { AbstractSynthEngine } from '../AbstractSynthEngine';
-import { makeDistortionCurve } from '../audioUtils';
-import { TextToSpeech } from '@capacitor-community/text-to-speech';
+import { tracer } from '../Tracer';
+import { sharedDistortionCurve } from '../audioUtils';
+import { OracleVoice } from '../speech/OracleVoice';
+import { takeRegistry } from '../TakeRegistry';
+import { LoopPlayer } from '../LoopPlayer';
+import { DelayNetwork } from '../DelayNetwork';
+import { PrunableSend } from '../PrunableSend';
+import { FeedbackSuppressor } from '../FeedbackSuppressor';
+import { performanceLog } from '../PerformanceLog';
+
+// Echo send stays connected this long after muting (the delay line's length);
+// once cut, the delay rings out on its own and then idles
+const ECHO_TAIL_SECONDS = 2.0;
 
 type VialType = 'mercury' | 'amber' | 'neutral';
 
+// Raw capture: no platform echo cancellation (and its latency); howl is
+// handled by the feedback suppressor instead
+const RAW_MIC: MediaTrackConstraints = {
+    echoCancellation: false,
+    noiseSuppression: false,
+    autoGainControl: false
+};
+
 /**
  * Echo Vessel Engine - Microphone effects processor with spatial audio.
  * Now extends AbstractSynthEngine for consistent architecture.
  */
 export class EchoVesselEngine extends AbstractSynthEngine {
+    protected readonly traceCategory = 'echo-vessel';
+
     // Input & Routing
     private micStream: MediaStream | null = null;
     private mediaRecorder: MediaRecorder | null = null;
     private audioChunks: Blob[] = [];
     private recordedBuffer: AudioBuffer | null = null;
-    private bufferSource: AudioBufferSourceNode | null = null;
+    private loopPlayer: LoopPlayer | null = null;
 
     private inputGain: GainNode | null = null;
     private dryGain: GainNode | null = null;
     private wetGain: GainNode | null = null;
+    // Neutral vial: inputGain → delay, off while the echo amount is 0
+    private echoSend: PrunableSend | null = null;
     private analyser: AnalyserNode | null = null;
     private panner: PannerNode | null = null;
 
@@ -29,20 +52,28 @@ export class EchoVesselEngine extends AbstractSynthEngine {
 
     // Amber Vial (Distortion + Delay)
     private distortion: WaveShaperNode | null = null;
-    private delay: DelayNode | null = null;
-    private delayFeedback: GainNode | null = null;
+    private delay: DelayNetwork | null = null;
 
     // Anti-feedback filter
     private antiCouplingFilter: BiquadFilterNode | null = null;
 
+    // Open mic: live input through the adaptive howl suppressor
+    private feedbackSuppressor: FeedbackSuppressor | null = null;
+    private micSource: MediaStreamAudioSourceNode | null = null;
+    // Suppressed live input, recorded instead of the raw stream while the mic is open
+    private micRecordTap: MediaStreamAudioDestinationNode | null = null;
+    private isOpenMic = false;
+
     // State
     private currentVial: VialType = 'neutral';
     private isRecording: boolean = false;
     private isPlayingBuffer: boolean = false;
 
-    // AI Speech Generator
+    // AI Speech Generator (formant voice rendered inside the graph)
+    private oracleVoice: OracleVoice | null = null;
     private speechActive: boolean = false;
     private currentSpeechText: string = "";
+    private speechToken = 0;
 
     // Sympathetic Resonance (Drone for TTS)
     private sympatheticOsc: OscillatorNode | null = null;
@@ -107,6 +138,18 @@ export class EchoVesselEngine extends AbstractSynthEngine {
             this.analyser.connect(ctx.destination);
         }
 
+        // Oracle voice enters like any other source, so it goes through vials, panner and recorders
+        this.oracleVoice = new OracleVoice(ctx);
+        this.oracleVoice.output.connect(this.inputGain);
+
+        // Recorded takes loop through the WSOLA player (independent tempo and pitch)
+        this.loopPlayer = new LoopPlayer(ctx);
+        this.loopPlayer.output.connect(this.antiCouplingFilter);
+
+        // Live mic enters before the high-pass, like the loop
+        this.feedbackSuppressor = new FeedbackSuppressor(ctx);
+        this.feedbackSuppressor.output.connect(this.antiCouplingFilter);
+
         // Initialize Effects
         this.setupDelay();
         this.setupMercury();
@@ -115,6 +158,29 @@ export class EchoVesselEngine extends AbstractSynthEngine {
         this.setVial('neutral');
     }
 
+    /**
+     * Rebuild the graph in place on the new context (Android volume restore),
+     * keeping the vial and the recorded take with its tempo and pitch.
+     * The mic belongs to the old graph: it is released, and reopened if it was open.
+     */
+    protected onContextReinit(): void {
+        const vial = this.currentVial;
+        const wasPlaying = this.isPlayingBuffer;
+        const wasOpenMic = this.isOpenMic;
+        const speed = this.loopPlayer?.getTimeStretch() ?? 1;
+        const semitones = this.loopPlayer?.getPitch() ?? 0;
+
+        this.releaseMic();
+        this.releaseGraph();
+        this.initializeEngine();
+
+        this.setVial(vial);
+        this.loopPlayer?.setTimeStretch(speed);
+        this.loopPlayer?.setPitch(semitones);
+        if (wasPlaying) this.startPlaybackLoop();
+        if (wasOpenMic) this.setOpenMic(true);
+    }
+
     // --- Microphone Handling ---
 
     async prepareMic() {
@@ -126,13 +192,7 @@ export class EchoVesselEngine extends AbstractSynthEngine {
 
         this.micPreparationPromise = (async () => {
             try {
-                this.micStream = await navigator.mediaDevices.getUserMedia({
-                    audio: {
-                        echoCancellation: true,
-                        noiseSuppression: false,
-                        autoGainControl: false
-                    }
-                });
+                this.micStream = await navigator.mediaDevices.getUserMedia({ audio: RAW_MIC });
             } catch (err) {
                 console.error("Error accessing microphone:", err);
             } finally {
@@ -152,14 +212,12 @@ export class EchoVesselEngine extends AbstractSynthEngine {
         this.stopPlayback();
 
         try {
-            const stream = await navigator.mediaDevices.getUserMedia({
-                audio: {
-                    echoCancellation: false,
-                    noiseSuppression: false,
-                    autoGainControl: false
-                }
-            });
-            this.micStream = stream;
+            // With the mic open, record what is heard (after howl suppression)
+            const openMic = this.isOpenMic && this.micRecordTap !== null;
+            const stream = openMic
+                ? this.micRecordTap!.stream
+                : await navigator.mediaDevices.getUserMedia({ audio: RAW_MIC });
+            if (!openMic) this.micStream = stream;
             this.audioChunks = [];
 
             this.mediaRecorder = new MediaRecorder(stream);
@@ -174,10 +232,13 @@ export class EchoVesselEngine extends AbstractSynthEngine {
                     // Decode needs to happen on context
                     this.recordedBuffer = await ctx.decodeAudioData(arrayBuffer);
                     this.normalizeBuffer(this.recordedBuffer);
+                    takeRegistry.publish('echo-vessel', this.recordedBuffer);
 
-                    // Stop stream tracks
-                    stream.getTracks().forEach(track => track.stop());
-                    this.micStream = null;
+                    // Stop stream tracks (unless the open mic is using them)
+                    if (!openMic && !this.isOpenMic) {
+                        stream.getTracks().forEach(track => track.stop());
+                        this.micStream = null;
+                    }
 
                     // Start Playing loop immediately
                     this.startPlaybackLoop();
@@ -188,6 +249,7 @@ export class EchoVesselEngine extends AbstractSynthEngine {
 
             this.mediaRecorder.start();
             this.isRecording = true;
+            if (__TRACE__) tracer.instant(this.traceCategory, 'recordStart');
 
         } catch (err) {
             console.error("Mic access denied", err);
@@ -196,6 +258,7 @@ export class EchoVesselEngine extends AbstractSynthEngine {
 
     stopRecording() {
         if (!this.isRecording || !this.mediaRecorder) return;
+        if (__TRACE__) tracer.instant(this.traceCategory, 'recordStop');
         this.mediaRecorder.stop();
         this.isRecording = false;
     }
@@ -224,40 +287,92 @@ export class EchoVesselEngine extends AbstractSynthEngine {
         this.stopPlayback(); // Stop existing
 
         const ctx = this.getContext();
-        if (!ctx || !this.inputGain) return;
-
-        this.bufferSource = ctx.createBufferSource();
-        this.bufferSource.buffer = this.recordedBuffer;
-        this.bufferSource.loop = true;
+        if (!ctx || !this.inputGain || !this.loopPlayer) return;
 
         // Connect through the existing chain
-        this.bufferSource.connect(this.antiCouplingFilter!);
-        if (this.antiCouplingFilter) { // Re-verify just in case
-            this.antiCouplingFilter.connect(this.inputGain);
-        } else {
-            this.bufferSource.connect(this.inputGain);
-        }
+        this.antiCouplingFilter?.connect(this.inputGain);
 
         // Fade in
         const t = ctx.currentTime;
         this.inputGain.gain.setValueAtTime(0, t);
         this.inputGain.gain.linearRampToValueAtTime(0.85, t + 0.1);
 
-        this.bufferSource.start(0);
+        this.loopPlayer.setBuffer(this.recordedBuffer);
+        this.loopPlayer.start();
         this.isPlayingBuffer = true;
     }
 
     stopPlayback() {
-        if (this.bufferSource) {
-            try {
-                this.bufferSource.stop();
-                this.bufferSource.disconnect();
-            } catch (e) { /* ignore */ }
-            this.bufferSource = null;
-        }
+        this.loopPlayer?.stop();
         this.isPlayingBuffer = false;
     }
 
+    /**
+     * Loop tempo: 1 = original speed, keeps pitch
+     */
+    setLoopTimeStretch(speed: number) {
+        this.loopPlayer?.setTimeStretch(speed);
+    }
+
+    /**
+     * Loop transposition in semitones, keeps tempo
+     */
+    setLoopPitch(semitones: number) {
+        this.loopPlayer?.setPitch(semitones);
+    }
+
+    /**
+     * Stretch the loop so one pass lasts `beats` beats at `bpm`; returns the speed applied
+     */
+    fitLoopToTempo(bpm: number, beats: number): number {
+        return this.loopPlayer?.fitToTempo(bpm, beats) ?? 1;
+    }
+
+    /**
+     * Open mic: raw, unprocessed live input into the vials and speakers, with
+     * the adaptive feedback suppressor notching out howl as it builds up.
+     */
+    async setOpenMic(enabled: boolean) {
+        const ctx = this.getContext();
+        if (!ctx || !this.feedbackSuppressor || !this.inputGain) return;
+
+        if (!enabled) {
+            if (!this.isOpenMic) return;
+            this.isOpenMic = false;
+            this.micSource?.disconnect();
+            this.micSource = null;
+            // A fresh tap is made each time the mic opens; detach this one
+            if (this.micRecordTap) this.feedbackSuppressor.output.disconnect(this.micRecordTap);
+            this.micRecordTap = null;
+            if (!this.isRecording) {
+                this.micStream?.getTracks().forEach(track => track.stop());
+                this.micStream = null;
+            }
+            if (__TRACE__) tracer.instant(this.traceCategory, 'openMicOff');
+            return;
+        }
+
+        if (this.isOpenMic) return;
+        await this.prepareMic();
+        if (!this.micStream) return;
+
+        this.micSource = ctx.createMediaStreamSource(this.micStream);
+        this.micSource.connect(this.feedbackSuppressor.input);
+        this.micRecordTap = ctx.createMediaStreamDestination();
+        this.feedbackSuppressor.output.connect(this.micRecordTap);
+        this.antiCouplingFilter?.connect(this.inputGain);
+        this.inputGain.gain.setTargetAtTime(0.85, ctx.currentTime, 0.05);
+        this.isOpenMic = true;
+        if (__TRACE__) tracer.instant(this.traceCategory, 'openMicOn');
+    }
+
+    getIsOpenMic() { return this.isOpenMic; }
+
+    /** The open mic's howl suppressor (notch list, reset) */
+    getFeedbackSuppressor(): FeedbackSuppressor | null {
+        return this.feedbackSuppressor;
+    }
+
     // Facade methods for UI
     getIsRecording() { return this.isRecording; }
     getIsPlayingBuffer() { return this.isPlayingBuffer; }
@@ -269,6 +384,7 @@ export class EchoVesselEngine extends AbstractSynthEngine {
         } else {
             this.stopRecording();
             this.stopPlayback();
+            this.setOpenMic(false);
         }
     }
 
@@ -283,14 +399,8 @@ export class EchoVesselEngine extends AbstractSynthEngine {
         const ctx = this.getContext();
         if (!ctx) return;
 
-        this.delay = ctx.createDelay(2.0);
-        this.delay.delayTime.value = 0.35;
-
-        this.delayFeedback = ctx.createGain();
-        this.delayFeedback.gain.value = 0.3;
-
-        this.delay.connect(this.delayFeedback);
-        this.delayFeedback.connect(this.delay);
+        // Feedback loop lives inside the node; setVial only rewires its input and output
+        this.delay = new DelayNetwork(ctx, 2.0, { time: 0.35, feedback: 0.3, damping: 8000 });
     }
 
     private setupMercury() {
@@ -313,7 +423,7 @@ export class EchoVesselEngine extends AbstractSynthEngine {
         if (!ctx) return;
 
         this.distortion = ctx.createWaveShaper();
-        this.distortion.curve = makeDistortionCurve(100);
+        this.distortion.curve = sharedDistortionCurve(100);
         this.distortion.oversample = '4x';
 
         const filter = ctx.createBiquadFilter();
@@ -322,32 +432,42 @@ export class EchoVesselEngine extends AbstractSynthEngine {
 
         this.distortion.connect(filter);
         if (this.delay) {
-            filter.connect(this.delay);
+            filter.connect(this.delay.input);
         }
     }
 
+    /** Selected vial, for a recorded performance to start from */
+    public saveState(): { vial: VialType } {
+        return { vial: this.currentVial };
+    }
+
+    public restoreState(snapshot: unknown) {
+        this.setVial((snapshot as { vial: VialType }).vial);
+    }
+
     public setVial(vial: VialType) {
         const ctx = this.getContext();
         if (!ctx || !this.inputGain) return;
+        performanceLog.vial(this.traceCategory, vial);
         this.currentVial = vial;
 
         this.inputGain.disconnect();
         this.mercuryGain?.disconnect();
         this.distortion?.disconnect();
-        this.delay?.disconnect();
-
-        if (this.delay && this.delayFeedback) {
-            this.delay.connect(this.delayFeedback);
-            this.delayFeedback.connect(this.delay);
-        }
+        this.delay?.output.disconnect();
+        // The disconnects above dropped its edge too
+        this.echoSend?.dispose();
+        this.echoSend = null;
 
         this.inputGain.connect(this.dryGain!);
 
         if (vial === 'neutral') {
-            this.inputGain.connect(this.delay!);
-            this.delay!.connect(this.wetGain!);
+            this.echoSend = new PrunableSend(ctx, this.inputGain, this.delay!.input, this.wetGain!.gain, ECHO_TAIL_SECONDS);
+            this.delay!.output.connect(this.wetGain!);
+            this.delay!.set('drive', 0);
+            this.delay!.set('damping', 8000);
             this.dryGain!.gain.setTargetAtTime(1.0, ctx.currentTime, 0.1);
-            this.wetGain!.gain.setTargetAtTime(0.5, ctx.currentTime, 0.1);
+            this.echoSend.setTargetAtTime(0.5, ctx.currentTime, 0.1);
         } else if (vial === 'mercury') {
             this.inputGain.connect(this.mercuryGain!);
             this.mercuryGain!.connect(this.wetGain!);
@@ -356,8 +476,11 @@ export class EchoVesselEngine extends AbstractSynthEngine {
         } else if (vial === 'amber') {
             this.inputGain.connect(this.distortion!);
             this.distortion!.connect(this.wetGain!);
-            this.distortion!.connect(this.delay!);
-            this.delay!.connect(this.wetGain!);
+            this.distortion!.connect(this.delay!.input);
+            this.delay!.output.connect(this.wetGain!);
+            // Darker, saturating repeats for the amber vial
+            this.delay!.set('drive', 0.5);
+            this.delay!.set('damping', 2500);
             this.dryGain!.gain.setTargetAtTime(0.4, ctx.currentTime, 0.1);
             this.wetGain!.gain.setTargetAtTime(0.6, ctx.currentTime, 0.1);
         }
@@ -385,40 +508,28 @@ export class EchoVesselEngine extends AbstractSynthEngine {
         if (active && this.currentSpeechText) {
             this.speakOnce();
         } else if (!active) {
-            window.speechSynthesis.cancel();
+            this.stopSpeech();
         }
     }
 
     public async speakOnce() {
-        if (!this.currentSpeechText) return;
+        if (!this.currentSpeechText || !this.oracleVoice) return;
 
+        // A newer utterance owns the drone if this one gets superseded
+        const token = ++this.speechToken;
         try {
-            await TextToSpeech.stop();
             this.startSympatheticResonance();
-
-            await TextToSpeech.speak({
-                text: this.currentSpeechText,
-                lang: 'es-ES',
-                rate: 1.0,
-                pitch: 1.0,
-                volume: 1.0,
-                category: 'ambient',
-            });
-
-            this.stopSympatheticResonance();
+            await this.oracleVoice.speak(this.currentSpeechText);
+            if (token === this.speechToken) this.stopSympatheticResonance();
         } catch (e) {
-            console.error("TTS Error:", e);
+            console.error("Oracle voice error:", e);
             this.stopSympatheticResonance();
         }
     }
 
     public async stopSpeech() {
-        try {
-            this.stopSympatheticResonance();
-            await TextToSpeech.stop();
-        } catch (e) {
-            console.error("TTS Stop Error:", e);
-        }
+        this.stopSympatheticResonance();
+        this.oracleVoice?.stop();
     }
 
     private startSympatheticResonance() {
@@ -433,7 +544,7 @@ export class EchoVesselEngine extends AbstractSynthEngine {
         this.sympatheticGain = ctx.createGain();
 
         this.sympatheticOsc.type = 'triangle';
-        this.sympatheticOsc.frequency.value = 55 + (Math.random() * 20);
+        this.sympatheticOsc.frequency.value = 55 + (this.random() * 20);
 
         this.sympatheticOsc.connect(this.sympatheticGain);
         this.sympatheticGain.connect(this.inputGain);
@@ -474,14 +585,14 @@ export class EchoVesselEngine extends AbstractSynthEngine {
             this.mercuryOsc?.frequency.setTargetAtTime(freq, t, 0.1);
         } else if (this.currentVial === 'amber') {
             const feedback = state.pressure * 0.9;
-            this.delayFeedback?.gain.setTargetAtTime(feedback, t, 0.1);
+            this.delay?.set('feedback', feedback, 0.1);
 
             const dTime = 0.1 + (state.viscosity * 1.0);
-            this.delay?.delayTime.setTargetAtTime(dTime, t, 0.1);
+            this.delay?.set('time', dTime, 0.1);
         } else if (this.currentVial === 'neutral') {
             const echoAmount = state.viscosity;
-            this.wetGain?.gain.setTargetAtTime(echoAmount * 0.8, t, 0.1);
-            this.delayFeedback?.gain.setTargetAtTime(echoAmount * 0.75, t, 0.1);
+            this.echoSend?.setTargetAtTime(echoAmount * 0.8, t, 0.1);
+            this.delay?.set('feedback', echoAmount * 0.75, 0.1);
         }
     }
 
@@ -497,6 +608,50 @@ export class EchoVesselEngine extends AbstractSynthEngine {
         this.stopRecording();
         this.stopPlayback();
         this.stopSpeech();
+        this.setOpenMic(false);
+    }
+
+    /**
+     * Cleanup method to be called when destroying the engine.
+     */
+    public destroy(): void {
+        this.releaseMic();
+        this.releaseGraph();
+        this.masterGain?.disconnect();
+    }
+
+    /**
+     * Let go of the mic: a take still being recorded is dropped (its context
+     * is going away), the open mic is closed and the tracks are stopped.
+     */
+    private releaseMic(): void {
+        if (this.mediaRecorder) {
+            this.mediaRecorder.onstop = null;
+            if (this.mediaRecorder.state !== 'inactive') this.mediaRecorder.stop();
+            this.mediaRecorder = null;
+        }
+        this.isRecording = false;
+        this.micSource?.disconnect();
+        this.micSource = null;
+        this.micRecordTap = null;
+        this.isOpenMic = false;
+        this.micStream?.getTracks().forEach(track => track.stop());
+        this.micStream = null;
+    }
+
+    /**
+     * Stop what would outlive the graph: the loop, the voice and drone, the
+     * echo send's prune timer and the worklet nodes.
+     */
+    private releaseGraph(): void {
+        this.stopPlayback();
+        this.stopSpeech();
+        this.echoSend?.dispose();
+        this.echoSend = null;
+        this.feedbackSuppressor?.dispose();
+        this.loopPlayer?.disconnect();
+        this.mercuryOsc?.stop();
+        this.analyser?.disconnect();
     }
 
     // --- Accessors for UI ---
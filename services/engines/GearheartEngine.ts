@@ -1,6 +1,10 @@
 import { SynthState } from '../../types';
 import { AbstractSynthEngine } from '../AbstractSynthEngine';
-import { makeDistortionCurve, createReverbImpulse, createNoiseBuffer } from '../audioUtils';
+import { tracer } from '../Tracer';
+import { timingTelemetry } from '../TimingTelemetry';
+import { sharedDistortionCurve, sharedReverbImpulse, sharedNoiseBuffer } from '../audioUtils';
+import { PrunableSend } from '../PrunableSend';
+import { performanceLog } from '../PerformanceLog';
 
 // Physics constants
 const GEAR_CONNECTION_MARGIN_PX = 18;        // Margin for gear connection detection
@@ -12,6 +16,8 @@ const KICK_BASE_DECAY = 0.4;                 // Base decay time for kick drum
 const KICK_START_FREQUENCY_HZ = 55;          // Starting frequency for kick sub-bass
 const KICK_END_FREQUENCY_HZ = 30;            // Ending frequency for kick sub-bass
 const MOTOR_BASE_SPEED = 0.02;               // Base rotation speed for the motor gear
+const NOISE_TABLE_SECONDS = 2;               // Shared noise table; hits play a random slice of it
+const REVERB_SECONDS = 2.0;                  // Impulse length, also the reverb's tail
 
 export interface Gear {
   id: number;
@@ -29,9 +35,12 @@ export interface Gear {
 }
 
 export class GearheartEngine extends AbstractSynthEngine {
+  protected readonly traceCategory = 'gearheart';
+
   // Reverb
   private reverb: ConvolverNode | null = null;
   private reverbGain: GainNode | null = null;
+  private reverbSend: PrunableSend | null = null; // percussionFilter → reverb, off while diffusion is 0
 
   // Percussion chain
   private percussionFilter: BiquadFilterNode | null = null;
@@ -43,6 +52,7 @@ export class GearheartEngine extends AbstractSynthEngine {
   // Physics & Sequencer State
   private gears: Gear[] = [];
   private animationFrameId: number | null = null;
+  private lastPhysicsAudioTime = -1; // Audio clock at the previous physics tick
 
   // State from React (mirrored here for physics)
   private speedMultiplier: number = 1;
@@ -65,8 +75,10 @@ export class GearheartEngine extends AbstractSynthEngine {
 
   protected initializeEngine(): void {
     this.setupAudioNodes();
-    // Initialize gears and start physics loop
-    this.initGears();
+    // Initialize gears (unless a scene already laid them out) and start physics loop
+    if (!this.lastConfig) {
+      this.initGears();
+    }
     this.startPhysicsLoop();
   }
 
@@ -107,7 +119,7 @@ export class GearheartEngine extends AbstractSynthEngine {
 
     // Distortion for percussive sound
     this.distortion = ctx.createWaveShaper();
-    this.distortion.curve = makeDistortionCurve(0.05);
+    this.distortion.curve = sharedDistortionCurve(0.05);
 
     // Simplified routing: masterGain -> percussionFilter -> masterBus
     // (skip distortion to preserve volume)
@@ -120,7 +132,9 @@ export class GearheartEngine extends AbstractSynthEngine {
       this.percussionFilter.connect(ctx.destination);
     }
 
-    this.percussionFilter.connect(this.reverb);       // Wet Send
+    // Wet send: starts pruned (reverbGain is 0) until diffusion turns it up
+    this.reverbSend?.dispose();
+    this.reverbSend = new PrunableSend(ctx, this.percussionFilter, this.reverb, this.reverbGain.gain, REVERB_SECONDS);
     this.reverb.connect(this.reverbGain);
     if (this.masterBus) {
       this.reverbGain.connect(this.masterBus);
@@ -136,13 +150,14 @@ export class GearheartEngine extends AbstractSynthEngine {
 
   private buildImpulse(): AudioBuffer | null {
     if (!this.ctx) return null;
-    return createReverbImpulse(this.ctx, 2.0, 4);
+    return sharedReverbImpulse(this.ctx, REVERB_SECONDS, 4);
   }
 
   // --- Physics Engine ---
 
   public initGears() {
-    // Default initial gears
+    // Default initial gears (forget any scene layout so it can be applied again)
+    this.lastConfig = '';
     const width = typeof window !== 'undefined' ? window.innerWidth : 800;
     const height = typeof window !== 'undefined' ? window.innerHeight * 0.6 : 600;
     const centerX = width / 2;
@@ -203,7 +218,7 @@ export class GearheartEngine extends AbstractSynthEngine {
     let direction = -1; // Start going up
 
     for (let i = 1; i < count; i++) {
-      const r = 25 + Math.random() * 25;
+      const r = 25 + this.random() * 25;
       const spacing = lastRadius + r + 5; // Slight overlap for guaranteed connection
 
       let x, y;
@@ -218,7 +233,7 @@ export class GearheartEngine extends AbstractSynthEngine {
         y = motorY + Math.sin(angle) * (spacing * 0.8 * i);
       } else {
         // Vertical chain going up from motor
-        x = lastX + (Math.random() - 0.5) * 40;
+        x = lastX + (this.random() - 0.5) * 40;
         y = lastY - spacing * 0.9;
       }
 
@@ -261,6 +276,7 @@ export class GearheartEngine extends AbstractSynthEngine {
   public updateGearPosition(id: number, x: number, y: number) {
     const gear = this.gears.find(g => g.id === id);
     if (gear) {
+      performanceLog.gearMove(this.traceCategory, id, x, y);
       gear.x = x;
       gear.y = y;
       gear.isDragging = true; // Mark as dragging so physics knows
@@ -270,15 +286,35 @@ export class GearheartEngine extends AbstractSynthEngine {
   public endDrag(id: number) {
     const gear = this.gears.find(g => g.id === id);
     if (gear) {
+      performanceLog.gearRelease(this.traceCategory, id);
       gear.isDragging = false;
     }
   }
 
   public toggleMotor() {
+    performanceLog.motor(this.traceCategory);
     this.isMotorActive = !this.isMotorActive;
     this.gears[0].isConnected = this.isMotorActive;
   }
 
+  /**
+   * Gear layout and motor, for a recorded performance to start from
+   */
+  public saveState(): { gears: Gear[]; motor: boolean; config: string } {
+    return {
+      gears: this.gears.map(g => ({ ...g, isDragging: false })),
+      motor: this.isMotorActive,
+      config: this.lastConfig
+    };
+  }
+
+  public restoreState(snapshot: unknown) {
+    const s = snapshot as { gears: Gear[]; motor: boolean; config: string };
+    this.gears = s.gears.map(g => ({ ...g }));
+    this.isMotorActive = s.motor;
+    this.lastConfig = s.config;
+  }
+
   public startPhysicsLoop() {
     const loop = () => {
       this.updatePhysics();
@@ -294,6 +330,7 @@ export class GearheartEngine extends AbstractSynthEngine {
     if (this.animationFrameId !== null) {
       cancelAnimationFrame(this.animationFrameId);
       this.animationFrameId = null;
+      this.lastPhysicsAudioTime = -1;
     }
   }
 
@@ -302,6 +339,7 @@ export class GearheartEngine extends AbstractSynthEngine {
    */
   public destroy() {
     this.stopPhysicsLoop();
+    this.reverbSend?.dispose();
     this.gears = [];
   }
 
@@ -362,6 +400,11 @@ export class GearheartEngine extends AbstractSynthEngine {
       }
     }
 
+    // Audio clock now and at the previous tick, to place each trigger inside the frame
+    const now = this.ctx ? this.ctx.currentTime : 0;
+    const tickDuration = this.lastPhysicsAudioTime >= 0 ? now - this.lastPhysicsAudioTime : 0;
+    this.lastPhysicsAudioTime = now;
+
     // Update Angles and Trigger Sound
     gears.forEach(g => {
       if (g.isConnected) {
@@ -370,15 +413,24 @@ export class GearheartEngine extends AbstractSynthEngine {
 
         // Check for full rotation change
         if (currentRotation !== g.lastRotation) {
+          // The boundary was crossed part-way through the frame: the overshoot past it
+          // tells how long ago the trigger was really due
+          const boundary = Math.max(currentRotation, g.lastRotation) * Math.PI * 2;
+          const overshoot = Math.min(1, Math.abs(g.angle - boundary) / Math.max(Math.abs(g.speed), 1e-6));
+          const intended = now - overshoot * tickDuration;
+
           // INTERNAL AUDIO TRIGGER
-          this.internalTrigger(g.radius, g.id);
+          this.internalTrigger(g.radius, g.id, intended);
           g.lastRotation = currentRotation;
         }
       }
     });
   }
 
-  private internalTrigger(radius: number, id: number) {
+  private internalTrigger(radius: number, id: number, intendedTime: number) {
+    if (__TRACE__) tracer.instant(this.traceCategory, 'gearTrigger', id);
+    // Voices start at ctx.currentTime, so that is when the hit is actually scheduled
+    if (this.ctx) timingTelemetry.recordHit(this.traceCategory, intendedTime, this.ctx.currentTime);
     // Play sound
     this.playNote(radius, undefined, id);
 
@@ -408,9 +460,7 @@ export class GearheartEngine extends AbstractSynthEngine {
     // Resonance: Q range 0.7 - 12 (reduced from 20 to avoid extreme kick variations)
     this.percussionFilter.Q.setTargetAtTime(0.7 + (state.resonance * 11.3), t, 0.1);
 
-    if (this.reverbGain) {
-      this.reverbGain.gain.setTargetAtTime(state.diffusion * 1.5, t, 0.1);
-    }
+    this.reverbSend?.setTargetAtTime(state.diffusion * 1.5, t, 0.1);
   }
 
   // --- Audio Methods ---
@@ -453,8 +503,8 @@ export class GearheartEngine extends AbstractSynthEngine {
     const now = this.ctx.currentTime;
     const duration = 0.05;
 
-    // Use shared noise buffer utility
-    const buffer = createNoiseBuffer(this.ctx, duration);
+    // Slice of the shared noise table (no buffer allocated per hit)
+    const buffer = sharedNoiseBuffer(this.ctx, NOISE_TABLE_SECONDS);
 
     const noise = this.ctx.createBufferSource();
     noise.buffer = buffer;
@@ -474,7 +524,7 @@ export class GearheartEngine extends AbstractSynthEngine {
     filter.connect(env);
     env.connect(this.masterGain);
 
-    noise.start(now);
+    noise.start(now, this.random() * (NOISE_TABLE_SECONDS - duration));
     noise.stop(now + duration);
   }
 
@@ -483,8 +533,8 @@ export class GearheartEngine extends AbstractSynthEngine {
     const now = this.ctx.currentTime;
     const duration = 0.15;
 
-    // Noise component (the "brush" stroke) - using shared utility
-    const buffer = createNoiseBuffer(this.ctx, duration);
+    // Noise component (the "brush" stroke) - slice of the shared noise table
+    const buffer = sharedNoiseBuffer(this.ctx, NOISE_TABLE_SECONDS);
 
     const noise = this.ctx.createBufferSource();
     noise.buffer = buffer;
@@ -524,7 +574,7 @@ export class GearheartEngine extends AbstractSynthEngine {
     bodyHighPass.connect(bodyEnv);
     bodyEnv.connect(this.masterGain);
 
-    noise.start(now);
+    noise.start(now, this.random() * (NOISE_TABLE_SECONDS - duration));
     noise.stop(now + duration);
     bodyOsc.start(now);
     bodyOsc.stop(now + 0.05); // Shortened to 0.05s
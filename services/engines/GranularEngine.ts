@@ -0,0 +1,179 @@
+import { SynthState } from '../../types';
+import { AbstractSynthEngine } from '../AbstractSynthEngine';
+import { tracer } from '../Tracer';
+import { takeRegistry, RecordedTake } from '../TakeRegistry';
+import { ensureWorklets } from '../worklets/workletLoader';
+
+export type GranularSource = 'echo-vessel' | 'vocoder' | 'latest';
+
+/**
+ * Nube de Grans - Granular cloud over recorded takes.
+ * Reads the take recorded by Echo Vessel or the Vocoder and scatters up to
+ * 256 windowed grains from a preallocated pool inside a single worklet.
+ */
+export class GranularEngine extends AbstractSynthEngine {
+    protected readonly traceCategory = 'grans';
+
+    private cloudNode: AudioWorkletNode | null = null;
+    private cloudReady: Promise<void> | null = null;
+
+    private source: GranularSource = 'latest';
+    private currentTake: RecordedTake | null = null;
+    private unsubscribe: (() => void) | null = null;
+
+    // State
+    private isRunning = false;
+    private liveGrains = 0;
+    private position = 0.5;
+    private spray = 0.1;
+    // Applied once the worklet node exists, if it arrives first
+    private lastState: SynthState | null = null;
+
+    protected useDefaultRouting(): boolean {
+        return false;
+    }
+
+    protected initializeEngine(): void {
+        const ctx = this.getContext();
+        const masterGain = this.getMasterGain();
+        if (!ctx || !masterGain) return;
+
+        masterGain.gain.value = 0.9;
+
+        // NOTE: No internal compressor - we use the global masterLimiter only
+        if (this.masterBus) {
+            masterGain.connect(this.masterBus);
+        } else {
+            masterGain.connect(ctx.destination);
+        }
+
+        this.cloudReady = ensureWorklets(ctx).then(() => {
+            this.cloudNode = new AudioWorkletNode(ctx, 'granular-cloud', {
+                numberOfInputs: 0,
+                numberOfOutputs: 1,
+                outputChannelCount: [2]
+            });
+            this.cloudNode.port.onmessage = (e: MessageEvent) => {
+                if (e.data.type === 'grains') this.liveGrains = e.data.count;
+            };
+            this.cloudNode.connect(masterGain);
+
+            // Push whatever was recorded before the engine existed
+            this.selectTake();
+            if (this.isRunning) this.cloudNode.port.postMessage({ type: 'run', running: true });
+            if (this.lastState) this.updateParameters(this.lastState);
+        });
+        this.cloudReady.catch((err) => console.error('[Granular] Worklet load failed:', err));
+
+        this.unsubscribe = takeRegistry.subscribe(() => this.selectTake());
+    }
+
+    protected onSeed(seed: number): void {
+        this.cloudReady?.then(() => this.cloudNode?.port.postMessage({ type: 'seed', seed }));
+    }
+
+    /**
+     * Choose which engine's take feeds the cloud
+     */
+    setSource(source: GranularSource): void {
+        this.source = source;
+        this.selectTake();
+    }
+
+    getSource(): GranularSource {
+        return this.source;
+    }
+
+    getTake(): RecordedTake | null {
+        return this.currentTake;
+    }
+
+    private selectTake(): void {
+        const take = this.source === 'latest' ? takeRegistry.getLatest() : takeRegistry.get(this.source);
+        if (!take || take === this.currentTake || !this.cloudNode) return;
+        this.currentTake = take;
+
+        // Copy channel data: the take stays usable by its recorder
+        const channels: Float32Array[] = [];
+        for (let ch = 0; ch < Math.min(2, take.buffer.numberOfChannels); ch++) {
+            channels.push(take.buffer.getChannelData(ch).slice());
+        }
+        this.cloudNode.port.postMessage({ type: 'source', channels }, channels.map(c => c.buffer));
+    }
+
+    startCloud(): void {
+        if (__TRACE__) tracer.instant(this.traceCategory, 'cloudStart');
+        this.isRunning = true;
+        this.cloudNode?.port.postMessage({ type: 'run', running: true });
+    }
+
+    stopCloud(): void {
+        if (__TRACE__) tracer.instant(this.traceCategory, 'cloudStop');
+        this.isRunning = false;
+        this.cloudNode?.port.postMessage({ type: 'run', running: false });
+    }
+
+    isCloudRunning(): boolean {
+        return this.isRunning;
+    }
+
+    getLiveGrainCount(): number {
+        return this.liveGrains;
+    }
+
+    /**
+     * Current position/spray for drawing the read window
+     */
+    getReadWindow(): { position: number; spray: number } {
+        return { position: this.position, spray: this.spray };
+    }
+
+    updateParameters(state: SynthState): void {
+        this.lastState = state;
+        const ctx = this.getContext();
+        if (!ctx || !this.cloudNode) return;
+        const t = ctx.currentTime;
+        const params = this.cloudNode.parameters;
+
+        // Pressure -> Density (2-150 grains/s, exponential feel)
+        params.get('density')?.setTargetAtTime(2 * Math.pow(75, state.pressure), t, 0.1);
+
+        // Resonance -> Pitch (±12 semitones around the original)
+        params.get('pitch')?.setTargetAtTime(Math.pow(2, (state.resonance - 0.5) * 2), t, 0.1);
+
+        // Viscosity -> Read position in the take
+        this.position = state.viscosity;
+        params.get('position')?.setTargetAtTime(state.viscosity, t, 0.1);
+
+        // Turbulence -> Spray (position, pitch and pan scatter)
+        this.spray = state.turbulence;
+        params.get('spray')?.setTargetAtTime(state.turbulence, t, 0.1);
+
+        // Diffusion -> Grain size (20-400 ms)
+        params.get('size')?.setTargetAtTime(0.02 + state.diffusion * 0.38, t, 0.1);
+    }
+
+    playNote(frequency: number, velocity?: number): number | undefined {
+        // Not used - the cloud runs continuously
+        return undefined;
+    }
+
+    stopNote(id: number): void {
+        // Not used
+    }
+
+    reset(): void {
+        this.stopCloud();
+    }
+
+    /**
+     * Cleanup method to be called when destroying the engine.
+     */
+    public destroy(): void {
+        this.stopCloud();
+        this.unsubscribe?.();
+        this.unsubscribe = null;
+        this.cloudNode?.disconnect();
+        this.cloudNode = null;
+    }
+}
@@ -0,0 +1,217 @@
+import { SynthState } from '../../types';
+import { AbstractSynthEngine } from '../AbstractSynthEngine';
+import { tracer } from '../Tracer';
+import { ensureWorklets } from '../worklets/workletLoader';
+import SampleStreamWorker from '../sampler/sampleStream.worker?worker';
+
+// Resident start of every sample: covers the reader's latency on a note-on
+const HEAD_SECONDS = 0.25;
+// Start offset (viscosity) reaches this fraction of the head
+const START_SPAN = 0.5;
+
+export interface SamplerZoneInfo {
+    rootHz: number;
+    sampleRate: number;
+    frames: number;
+    headFrames: number;
+}
+
+export interface SamplerStats {
+    voices: number;
+    underruns: number;
+}
+
+/**
+ * Arquivo Sonoro - Streaming multisample player.
+ * Instruments live in the app's private storage (see sampler/SampleLibrary);
+ * only the first HEAD_SECONDS of each sample is kept in memory and the rest is
+ * streamed by a worker into the playback worklet as notes play.
+ */
+export class SamplerEngine extends AbstractSynthEngine {
+    protected readonly traceCategory = 'sampler';
+
+    private node: AudioWorkletNode | null = null;
+    private ready: Promise<void> | null = null;
+    private worker: Worker | null = null;
+    private filter: BiquadFilterNode | null = null;
+
+    private instrument: string | null = null;
+    private zones: SamplerZoneInfo[] = [];
+    private pendingOpen: { resolve: (zones: SamplerZoneInfo[]) => void; reject: (err: Error) => void } | null = null;
+    private nextNoteId = 1;
+    private stats: SamplerStats = { voices: 0, underruns: 0 };
+
+    // Driven by SynthState
+    private startOffset = 0;
+    private crossfade = 0.3;
+    private release = 0.4;
+
+    protected useDefaultRouting(): boolean {
+        return false;
+    }
+
+    protected initializeEngine(): void {
+        const ctx = this.getContext();
+        const masterGain = this.getMasterGain();
+        if (!ctx || !masterGain) return;
+
+        masterGain.gain.value = 0.9;
+
+        this.filter = ctx.createBiquadFilter();
+        this.filter.type = 'lowpass';
+        this.filter.frequency.value = 16000;
+        this.filter.Q.value = 0.7;
+        this.filter.connect(masterGain);
+
+        // NOTE: No internal compressor - we use the global masterLimiter only
+        if (this.masterBus) {
+            masterGain.connect(this.masterBus);
+        } else {
+            masterGain.connect(ctx.destination);
+        }
+
+        this.worker?.terminate();
+        this.worker = new SampleStreamWorker();
+        this.worker.onmessage = (e: MessageEvent) => this.onWorkerMessage(e.data);
+
+        this.ready = ensureWorklets(ctx).then(() => {
+            this.node = new AudioWorkletNode(ctx, 'stream-sampler', {
+                numberOfInputs: 0,
+                numberOfOutputs: 1,
+                outputChannelCount: [2]
+            });
+            this.node.port.onmessage = (e: MessageEvent) => {
+                if (e.data.type === 'stats') this.stats = { voices: e.data.voices, underruns: e.data.underruns };
+            };
+            this.node.connect(this.filter!);
+
+            // Chunks go straight from the reader to the worklet
+            const channel = new MessageChannel();
+            this.node.port.postMessage({ type: 'stream', port: channel.port1 }, [channel.port1]);
+            this.worker!.postMessage({ type: 'port', port: channel.port2 }, [channel.port2]);
+        });
+        this.ready.catch((err) => console.error('[Sampler] Worklet load failed:', err));
+    }
+
+    /**
+     * Open an instrument from the library; resolves with its zones once the
+     * heads are resident and notes can play
+     */
+    loadInstrument(name: string): Promise<SamplerZoneInfo[]> {
+        if (!this.ready || !this.worker) return Promise.reject(new Error('Sampler not initialised'));
+        if (__TRACE__) tracer.instant(this.traceCategory, 'loadInstrument');
+        this.instrument = name;
+        this.zones = [];
+
+        return this.ready.then(() => new Promise<SamplerZoneInfo[]>((resolve, reject) => {
+            this.pendingOpen?.reject(new Error('Superseded by another instrument'));
+            this.pendingOpen = { resolve, reject };
+            this.worker!.postMessage({ type: 'open', name, headSeconds: HEAD_SECONDS });
+        }));
+    }
+
+    private onWorkerMessage(msg: any): void {
+        if (msg.name !== this.instrument) return;
+        if (msg.type === 'opened') {
+            this.zones = msg.zones;
+            this.pendingOpen?.resolve(this.zones);
+        } else if (msg.type === 'error') {
+            console.error('[Sampler] Could not open instrument:', msg.message);
+            this.pendingOpen?.reject(new Error(msg.message));
+        }
+        this.pendingOpen = null;
+    }
+
+    getInstrument(): string | null {
+        return this.instrument;
+    }
+
+    getZones(): SamplerZoneInfo[] {
+        return this.zones;
+    }
+
+    getStats(): SamplerStats {
+        return this.stats;
+    }
+
+    /**
+     * Zones to play for a pitch, with equal-power gains. Between two roots the
+     * nearer zone plays alone, except inside a blend region around the midpoint
+     * whose width (crossfade, 0..1) is a fraction of the gap.
+     */
+    private pickZones(freq: number): { zone: number; gain: number }[] {
+        const zones = this.zones;
+        const hi = zones.findIndex(zone => zone.rootHz > freq);
+        if (hi === -1) return [{ zone: zones.length - 1, gain: 1 }];
+        if (hi === 0) return [{ zone: 0, gain: 1 }];
+        const lo = hi - 1;
+
+        const span = 12 * Math.log2(zones[hi].rootHz / zones[lo].rootHz);
+        const distance = 12 * Math.log2(freq / zones[lo].rootHz);
+        const width = this.crossfade * span;
+        const t = width > 0
+            ? Math.max(0, Math.min(1, (distance - span / 2) / width + 0.5))
+            : (distance < span / 2 ? 0 : 1);
+
+        if (t === 0) return [{ zone: lo, gain: 1 }];
+        if (t === 1) return [{ zone: hi, gain: 1 }];
+        return [
+            { zone: lo, gain: Math.cos(t * Math.PI / 2) },
+            { zone: hi, gain: Math.sin(t * Math.PI / 2) }
+        ];
+    }
+
+    // --- Abstract method implementations ---
+
+    updateParameters(state: SynthState): void {
+        const ctx = this.getContext();
+        if (!ctx) return;
+        const t = ctx.currentTime;
+
+        // Pressure -> Brightness (200 Hz - 16 kHz)
+        this.filter?.frequency.setTargetAtTime(200 * Math.pow(80, state.pressure), t, 0.05);
+        // Resonance -> Filter Q
+        this.filter?.Q.setTargetAtTime(0.7 + state.resonance * 11, t, 0.05);
+        // Viscosity -> Start offset into the sample (applies to new notes)
+        this.startOffset = state.viscosity;
+        // Turbulence -> Crossfade between neighbouring zones
+        this.crossfade = state.turbulence;
+        // Diffusion -> Release (0.05 - 3 s)
+        this.release = 0.05 + state.diffusion * 2.95;
+    }
+
+    playNote(freq: number, vel: number = 1): number | undefined {
+        const ctx = this.getContext();
+        if (!ctx || !this.node || this.zones.length === 0) return undefined;
+
+        const id = this.nextNoteId++;
+        for (const { zone, gain } of this.pickZones(freq)) {
+            const info = this.zones[zone];
+            this.node.port.postMessage({
+                type: 'noteOn',
+                id,
+                zone,
+                increment: (freq / info.rootHz) * (info.sampleRate / ctx.sampleRate),
+                gain: gain * vel,
+                start: Math.floor(this.startOffset * START_SPAN * info.headFrames)
+            });
+        }
+        if (__TRACE__) tracer.instant(this.traceCategory, 'noteOn', freq);
+        return id;
+    }
+
+    stopNote(id: number): void {
+        this.node?.port.postMessage({ type: 'noteOff', id, release: this.release });
+    }
+
+    reset(): void {
+        this.node?.port.postMessage({ type: 'allOff' });
+    }
+
+    destroy(): void {
+        this.worker?.terminate();
+        this.worker = null;
+        this.node?.disconnect();
+        this.node = null;
+    }
+}
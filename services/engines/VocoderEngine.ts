@@ -1,6 +1,14 @@
 import { SynthState } from '../../types';
 import { AbstractSynthEngine } from '../AbstractSynthEngine';
-import { createReverbImpulse, createNoiseBuffer } from '../audioUtils';
+import { tracer } from '../Tracer';
+import { sharedReverbImpulse, sharedNoiseBuffer } from '../audioUtils';
+import { takeRegistry } from '../TakeRegistry';
+import { LoopPlayer } from '../LoopPlayer';
+import { PrunableSend } from '../PrunableSend';
+import { PitchTracker } from '../PitchTracker';
+
+const REVERB_SECONDS = 8; // Impulse length, also the reverb's tail
+const CARRIER_HARMONICS = [110, 220, 330, 440]; // A2 and harmonics
 
 /**
  * Vocoder das Covas - Cave Vocoder
@@ -8,6 +16,8 @@ import { createReverbImpulse, createNoiseBuffer } from '../audioUtils';
  * Features massive convolution reverb and spectral-driven particle visualization.
  */
 export class VocoderEngine extends AbstractSynthEngine {
+    protected readonly traceCategory = 'vocoder';
+
     // Vocoder bands
     private readonly NUM_BANDS = 12;
     private modulatorBands: BiquadFilterNode[] = [];
@@ -19,19 +29,23 @@ export class VocoderEngine extends AbstractSynthEngine {
     private mediaRecorder: MediaRecorder | null = null;
     private audioChunks: Blob[] = [];
     private recordedBuffer: AudioBuffer | null = null;
-    private bufferSource: AudioBufferSourceNode | null = null;
+    private loopPlayer: LoopPlayer | null = null;
 
     private micGain: GainNode | null = null;
     private carrierGain: GainNode | null = null;
     private dryGain: GainNode | null = null;
     private wetGain: GainNode | null = null;
     private reverb: ConvolverNode | null = null;
+    private reverbSend: PrunableSend | null = null; // wetGain → reverb, off while pressure is 0
     private outputAnalyser: AnalyserNode | null = null;
 
     // Internal carrier sources
     private internalNoise: AudioBufferSourceNode | null = null;
     private internalOscillators: OscillatorNode[] = [];
     private internalCarrierGain: GainNode | null = null;
+    // Tracks the modulator's pitch; the oscillators follow it while carrierFollow is on
+    private pitchTracker: PitchTracker | null = null;
+    private carrierFollow: boolean = false;
 
     // External carrier taps (from other engines) - TODO: implement
     private criosferaTap: GainNode | null = null;
@@ -58,6 +72,14 @@ export class VocoderEngine extends AbstractSynthEngine {
         this.micGain = ctx.createGain();
         this.micGain.gain.value = 8.0; // Higher gain for more sensitive microphone input
 
+        // Recorded takes loop through the WSOLA player into micGain (-> modulator bands)
+        this.loopPlayer = new LoopPlayer(ctx);
+        this.loopPlayer.output.connect(this.micGain);
+
+        this.pitchTracker?.dispose();
+        this.pitchTracker = new PitchTracker(ctx);
+        this.micGain.connect(this.pitchTracker.input);
+
         this.carrierGain = ctx.createGain();
         this.carrierGain.gain.value = 1.0;
 
@@ -72,7 +94,7 @@ export class VocoderEngine extends AbstractSynthEngine {
 
         // Create massive reverb (the "caves")
         this.reverb = ctx.createConvolver();
-        this.reverb.buffer = createReverbImpulse(ctx, 8, 3); // Long, dense reverb
+        this.reverb.buffer = sharedReverbImpulse(ctx, REVERB_SECONDS, 3); // Long, dense reverb
 
         // Output analyser for visualization
         this.outputAnalyser = ctx.createAnalyser();
@@ -89,8 +111,9 @@ export class VocoderEngine extends AbstractSynthEngine {
         // Mic -> Vocoder Modulator Bands -> Envelope Followers -> Control Carrier Band Gains
         // Vocoder Output -> Dry/Wet Split -> Reverb -> Master
 
-        // Connect wet path through reverb
-        this.wetGain.connect(this.reverb);
+        // Connect wet path through reverb (taken out of the graph while the wet level is 0)
+        this.reverbSend?.dispose();
+        this.reverbSend = new PrunableSend(ctx, this.wetGain, this.reverb, this.wetGain.gain, REVERB_SECONDS);
         this.reverb.connect(masterGain);
 
         // Connect dry path
@@ -110,7 +133,7 @@ export class VocoderEngine extends AbstractSynthEngine {
         if (!ctx || !this.internalCarrierGain) return;
 
         // Create white noise buffer using shared utility
-        const noiseBuffer = createNoiseBuffer(ctx, 2);
+        const noiseBuffer = sharedNoiseBuffer(ctx, 2);
 
         // Noise source - create fresh each time
         this.internalNoise = ctx.createBufferSource();
@@ -120,14 +143,13 @@ export class VocoderEngine extends AbstractSynthEngine {
         this.internalNoise.start();
 
         // Add harmonic oscillators for tonal content
-        const harmonics = [110, 220, 330, 440]; // A2 and harmonics
         this.internalOscillators = []; // Clear any old references
-        harmonics.forEach(freq => {
+        CARRIER_HARMONICS.forEach((freq, i) => {
             const osc = ctx.createOscillator();
             osc.type = 'sawtooth';
-            osc.frequency.value = freq;
+            this.setOscillatorFollow(osc, i + 1, freq);
             const gain = ctx.createGain();
-            gain.gain.value = 0.3 / harmonics.length; // Increased gain for more tonal content
+            gain.gain.value = 0.3 / CARRIER_HARMONICS.length; // Increased gain for more tonal content
             osc.connect(gain);
             gain.connect(this.internalCarrierGain!);
             osc.start();
@@ -149,6 +171,7 @@ export class VocoderEngine extends AbstractSynthEngine {
 
         // Stop and disconnect oscillators
         this.internalOscillators.forEach(osc => {
+            this.pitchTracker?.disconnectFrequency(osc.frequency);
             try {
                 osc.stop();
                 osc.disconnect();
@@ -321,6 +344,39 @@ export class VocoderEngine extends AbstractSynthEngine {
         this.internalCarrierGain.gain.setTargetAtTime(internalGain, ctx.currentTime, 0.1);
     }
 
+    /**
+     * Tune the internal carrier to the modulator's pitch: oscillator n plays
+     * n × the tracked fundamental instead of the fixed A2 series, so the
+     * vocoded voice keeps its own melody. The tracker holds the last voiced
+     * pitch through consonants and pauses.
+     */
+    setCarrierFollow(enabled: boolean) {
+        if (this.carrierFollow === enabled) return;
+        this.carrierFollow = enabled;
+        this.internalOscillators.forEach((osc, i) => this.setOscillatorFollow(osc, i + 1, CARRIER_HARMONICS[i]));
+    }
+
+    getCarrierFollow() { return this.carrierFollow; }
+
+    /** Current modulator pitch estimate, for display */
+    getModulatorPitch() {
+        return this.pitchTracker?.getPitch() ?? null;
+    }
+
+    private setOscillatorFollow(osc: OscillatorNode, harmonic: number, fixedFreq: number) {
+        const ctx = this.getContext();
+        if (!ctx) return;
+        osc.frequency.cancelScheduledValues(ctx.currentTime);
+        if (this.carrierFollow && this.pitchTracker) {
+            // The tracker's signal is added to the param, so its own value is 0
+            osc.frequency.value = 0;
+            this.pitchTracker.connectFrequency(osc.frequency, harmonic);
+        } else {
+            this.pitchTracker?.disconnectFrequency(osc.frequency);
+            osc.frequency.value = fixedFreq;
+        }
+    }
+
     /**
      * Enable/disable microphone input
      */
@@ -356,6 +412,7 @@ export class VocoderEngine extends AbstractSynthEngine {
                     // Decode needs to happen on context
                     this.recordedBuffer = await ctx.decodeAudioData(arrayBuffer);
                     this.normalizeBuffer(this.recordedBuffer);
+                    takeRegistry.publish('vocoder', this.recordedBuffer);
 
                     // Stop stream tracks
                     stream.getTracks().forEach(track => track.stop());
@@ -370,6 +427,7 @@ export class VocoderEngine extends AbstractSynthEngine {
 
             this.mediaRecorder.start();
             this.isRecording = true;
+            if (__TRACE__) tracer.instant(this.traceCategory, 'recordStart');
 
         } catch (err) {
             console.error("Mic access denied", err);
@@ -378,6 +436,7 @@ export class VocoderEngine extends AbstractSynthEngine {
 
     stopRecording() {
         if (!this.isRecording || !this.mediaRecorder) return;
+        if (__TRACE__) tracer.instant(this.traceCategory, 'recordStop');
         this.mediaRecorder.stop();
         this.isRecording = false;
     }
@@ -410,32 +469,39 @@ export class VocoderEngine extends AbstractSynthEngine {
         // Re-create internal carrier
         this.createInternalCarrier();
 
-        this.bufferSource = ctx.createBufferSource();
-        this.bufferSource.buffer = this.recordedBuffer;
-        this.bufferSource.loop = true;
-
-        // Connect buffer to micGain which goes to modulator bands
-        this.bufferSource.connect(this.micGain);
-
-        // Ensure micGain is connected to bands (done in setup but just to be sure)
-        // this.modulatorBands.forEach(...) - assumig already connected from initialize
-
-        this.bufferSource.start(0);
+        if (!this.loopPlayer) return;
+        this.loopPlayer.setBuffer(this.recordedBuffer);
+        this.loopPlayer.start();
         this.isPlayingBuffer = true;
     }
 
     stopPlayback() {
-        if (this.bufferSource) {
-            try {
-                this.bufferSource.stop();
-                this.bufferSource.disconnect();
-            } catch (e) { /* ignore */ }
-            this.bufferSource = null;
-        }
+        this.loopPlayer?.stop();
         this.stopInternalCarrier();
         this.isPlayingBuffer = false;
     }
 
+    /**
+     * Loop tempo: 1 = original speed, keeps pitch
+     */
+    setLoopTimeStretch(speed: number) {
+        this.loopPlayer?.setTimeStretch(speed);
+    }
+
+    /**
+     * Loop transposition in semitones, keeps tempo (e.g. to sit in the carrier key)
+     */
+    setLoopPitch(semitones: number) {
+        this.loopPlayer?.setPitch(semitones);
+    }
+
+    /**
+     * Stretch the loop so one pass lasts `beats` beats at `bpm`; returns the speed applied
+     */
+    fitLoopToTempo(bpm: number, beats: number): number {
+        return this.loopPlayer?.fitToTempo(bpm, beats) ?? 1;
+    }
+
     // Facade methods for UI
     getIsRecording() { return this.isRecording; }
     getIsPlayingBuffer() { return this.isPlayingBuffer; }
@@ -463,7 +529,7 @@ export class VocoderEngine extends AbstractSynthEngine {
 
         // Pressure -> Dry/Wet mix
         const wet = state.pressure;
-        this.wetGain?.gain.setTargetAtTime(wet, t, 0.1);
+        this.reverbSend?.setTargetAtTime(wet, t, 0.1);
         this.dryGain?.gain.setTargetAtTime(1 - wet, t, 0.1);
 
         // Resonance -> Band resonance (Q value)
@@ -532,4 +598,28 @@ export class VocoderEngine extends AbstractSynthEngine {
         // Disconnect from external carrier sources
         this.setCarrierSources(null, null);
     }
+
+    /**
+     * Cleanup method to be called when destroying the engine.
+     */
+    public destroy(): void {
+        // A take still being recorded is dropped, not decoded onto a closed context
+        if (this.mediaRecorder) {
+            this.mediaRecorder.onstop = null;
+            if (this.mediaRecorder.state !== 'inactive') this.mediaRecorder.stop();
+            this.mediaRecorder = null;
+        }
+        this.isRecording = false;
+        this.micStream?.getTracks().forEach(track => track.stop());
+        this.micStream = null;
+
+        this.reset();
+        this.reverbSend?.dispose();
+        this.reverbSend = null;
+        this.loopPlayer?.disconnect();
+        this.pitchTracker?.dispose();
+        this.pitchTracker = null;
+        this.outputAnalyser?.disconnect();
+        this.masterGain?.disconnect();
+    }
 }
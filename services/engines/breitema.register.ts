@@ -1,3 +1,4 @@
+import { Type } from '@google/genai';
 import { engineRegistry } from '../EngineRegistry';
 import { BreitemaEngine } from './BreitemaEngine';
 
@@ -24,5 +25,20 @@ engineRegistry.register({
     displayName: 'Reixa da Brétema',
     factory: () => new BreitemaEngine(),
     paramLabels: PARAM_LABELS,
-    theme: THEME
+    theme: THEME,
+    sceneSchema: {
+        pattern: {
+            type: Type.OBJECT,
+            properties: {
+                rhythmMode: { type: Type.STRING, enum: ["libre", "muineira", "ribeirada"] },
+                steps: { type: Type.ARRAY, items: { type: Type.BOOLEAN }, minItems: "16", maxItems: "16" }
+            },
+            required: ["steps"]
+        }
+    },
+    applyScene: (engine, condition) => {
+        if (condition.pattern) {
+            (engine as BreitemaEngine).setPattern(condition.pattern);
+        }
+    }
 });
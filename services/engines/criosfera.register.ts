@@ -24,5 +24,6 @@ engineRegistry.register({
     displayName: 'Criosfera Armónica',
     factory: () => new CriosferaEngine(),
     paramLabels: PARAM_LABELS,
-    theme: THEME
+    theme: THEME,
+    tailSeconds: CriosferaEngine.tailSeconds
 });
@@ -1,3 +1,4 @@
+import { Type } from '@google/genai';
 import { engineRegistry } from '../EngineRegistry';
 import { GearheartEngine } from './GearheartEngine';
 
@@ -24,5 +25,20 @@ engineRegistry.register({
     displayName: 'Gearheart Forge',
     factory: () => new GearheartEngine(),
     paramLabels: PARAM_LABELS,
-    theme: THEME
+    theme: THEME,
+    sceneSchema: {
+        gearConfig: {
+            type: Type.OBJECT,
+            properties: {
+                numGears: { type: Type.NUMBER },
+                arrangement: { type: Type.STRING, enum: ["linear", "cluster", "chaotic"] }
+            },
+            required: ["numGears", "arrangement"]
+        }
+    },
+    applyScene: (engine, condition) => {
+        if (condition.gearConfig) {
+            (engine as GearheartEngine).setGearConfig(condition.gearConfig);
+        }
+    }
 });
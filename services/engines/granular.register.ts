@@ -0,0 +1,28 @@
+import { engineRegistry } from '../EngineRegistry';
+import { GranularEngine } from './GranularEngine';
+
+// Parameter labels for Nube de Grans
+const PARAM_LABELS = {
+    pressure: "DENSIDADE",
+    resonance: "TONO",
+    viscosity: "POSICIÓN",
+    turbulence: "DISPERSIÓN",
+    diffusion: "TAMAÑO GRAN"
+};
+
+// Theme for Nube de Grans (sand/dust aesthetic)
+const THEME = {
+    bg: 'bg-[#14110d]',
+    text: 'text-amber-100',
+    accent: 'text-amber-300',
+    border: 'border-amber-900/30'
+};
+
+// Register the engine
+engineRegistry.register({
+    name: 'grans',
+    displayName: 'Nube de Grans',
+    factory: () => new GranularEngine(),
+    paramLabels: PARAM_LABELS,
+    theme: THEME
+});
@@ -9,6 +9,8 @@ import './gearheart.register';
 import './echoVessel.register';
 import './vocoder.register';
 import './breitema.register';
+import './granular.register';
+import './sampler.register';
 
 // Re-export vial labels for Echo Vessel (specific to that engine's UI)
 export { ECHO_VESSEL_VIAL_LABELS } from './echoVessel.register';
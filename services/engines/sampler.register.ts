@@ -0,0 +1,28 @@
+import { engineRegistry } from '../EngineRegistry';
+import { SamplerEngine } from './SamplerEngine';
+
+// Parameter labels for Arquivo Sonoro
+const PARAM_LABELS = {
+    pressure: "BRILLO",
+    resonance: "RESONANCIA",
+    viscosity: "INICIO",
+    turbulence: "FUNDIDO",
+    diffusion: "LIBERACIÓN"
+};
+
+// Theme for Arquivo Sonoro (archive/violet aesthetic)
+const THEME = {
+    bg: 'bg-[#100d16]',
+    text: 'text-violet-100',
+    accent: 'text-violet-300',
+    border: 'border-violet-900/30'
+};
+
+// Register the engine
+engineRegistry.register({
+    name: 'sampler',
+    displayName: 'Arquivo Sonoro',
+    factory: () => new SamplerEngine(),
+    paramLabels: PARAM_LABELS,
+    theme: THEME
+});
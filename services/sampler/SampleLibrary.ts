@@ -0,0 +1,121 @@
+import { LIBRARY_DIR, LIBRARY_INDEX, MANIFEST_FILE, InstrumentManifest, ZoneManifest } from './format';
+
+// Frames converted and written per step, so an import never holds a second full copy
+const WRITE_FRAMES = 65536;
+const DEFAULT_ROOT_HZ = 261.63; // C4
+
+const NOTE_OFFSETS: Record<string, number> = { c: 0, d: 2, e: 4, f: 5, g: 7, a: 9, b: 11 };
+
+/**
+ * Sampler instrument library in the origin private file system (see format.ts).
+ * Runs on the main thread for imports and listing; playback reads go through
+ * the sample stream worker.
+ */
+
+export function isLibrarySupported(): boolean {
+    return typeof navigator !== 'undefined' && !!navigator.storage?.getDirectory;
+}
+
+async function libraryRoot(): Promise<FileSystemDirectoryHandle> {
+    const root = await navigator.storage.getDirectory();
+    return root.getDirectoryHandle(LIBRARY_DIR, { create: true });
+}
+
+async function readIndex(root: FileSystemDirectoryHandle): Promise<string[]> {
+    try {
+        const file = await (await root.getFileHandle(LIBRARY_INDEX)).getFile();
+        return JSON.parse(await file.text());
+    } catch {
+        return [];
+    }
+}
+
+async function writeJson(dir: FileSystemDirectoryHandle, name: string, value: unknown): Promise<void> {
+    const writable = await (await dir.getFileHandle(name, { create: true })).createWritable();
+    await writable.write(JSON.stringify(value));
+    await writable.close();
+}
+
+/**
+ * Root pitch from a sample's file name: a note name ("Piano_C#4.wav", "harp-Eb2")
+ * or a MIDI note number ("vln_060.wav"); C4 when neither is present.
+ */
+export function rootFromFileName(fileName: string): number {
+    const stem = fileName.replace(/\.[^.]+$/, '');
+    const notes = [...stem.matchAll(/(?:^|[^A-Za-z])([A-Ga-g])([#b]?)(-?\d)(?!\d)/g)];
+    if (notes.length > 0) {
+        const [, letter, accidental, octave] = notes[notes.length - 1];
+        const midi = 12 * (Number(octave) + 1) + NOTE_OFFSETS[letter.toLowerCase()] +
+            (accidental === '#' ? 1 : accidental === 'b' ? -1 : 0);
+        return 440 * Math.pow(2, (midi - 69) / 12);
+    }
+
+    const numbers = stem.match(/\d{2,3}/g);
+    const midi = numbers ? Number(numbers[numbers.length - 1]) : NaN;
+    if (midi >= 21 && midi <= 108) return 440 * Math.pow(2, (midi - 69) / 12);
+    return DEFAULT_ROOT_HZ;
+}
+
+/**
+ * Names of the imported instruments
+ */
+export async function listInstruments(): Promise<string[]> {
+    return readIndex(await libraryRoot());
+}
+
+/**
+ * Decode audio files and store them as one instrument (a zone per file).
+ * Files are decoded one at a time, so memory peaks at a single sample.
+ */
+export async function importInstrument(
+    ctx: BaseAudioContext,
+    name: string,
+    files: File[],
+    onProgress?: (done: number, total: number) => void
+): Promise<InstrumentManifest> {
+    const safeName = name.replace(/[\\/:*?"<>|]/g, '_').trim() || 'Instrumento';
+    const root = await libraryRoot();
+    await root.removeEntry(safeName, { recursive: true }).catch(() => { });
+    const dir = await root.getDirectoryHandle(safeName, { create: true });
+
+    const zones: ZoneManifest[] = [];
+    for (let i = 0; i < files.length; i++) {
+        onProgress?.(i, files.length);
+        const buffer = await ctx.decodeAudioData(await files[i].arrayBuffer());
+        const channels = Math.min(2, buffer.numberOfChannels);
+        const data = Array.from({ length: channels }, (_, ch) => buffer.getChannelData(ch));
+
+        const file = `${i}.pcm`;
+        const writable = await (await dir.getFileHandle(file, { create: true })).createWritable();
+        for (let start = 0; start < buffer.length; start += WRITE_FRAMES) {
+            const frames = Math.min(WRITE_FRAMES, buffer.length - start);
+            const pcm = new Int16Array(frames * channels);
+            for (let f = 0; f < frames; f++) {
+                for (let ch = 0; ch < channels; ch++) {
+                    const x = Math.max(-1, Math.min(1, data[ch][start + f]));
+                    pcm[f * channels + ch] = Math.round(x * 32767);
+                }
+            }
+            await writable.write(pcm);
+        }
+        await writable.close();
+
+        zones.push({ file, rootHz: rootFromFileName(files[i].name), sampleRate: buffer.sampleRate, channels, frames: buffer.length });
+    }
+    onProgress?.(files.length, files.length);
+
+    zones.sort((a, b) => a.rootHz - b.rootHz);
+    const manifest: InstrumentManifest = { name: safeName, zones };
+    await writeJson(dir, MANIFEST_FILE, manifest);
+
+    const index = await readIndex(root);
+    if (!index.includes(safeName)) await writeJson(root, LIBRARY_INDEX, [...index, safeName]);
+    return manifest;
+}
+
+export async function deleteInstrument(name: string): Promise<void> {
+    const root = await libraryRoot();
+    await root.removeEntry(name, { recursive: true }).catch(() => { });
+    const index = await readIndex(root);
+    await writeJson(root, LIBRARY_INDEX, index.filter(entry => entry !== name));
+}
@@ -0,0 +1,31 @@
+/**
+ * On-disk layout of the sampler library, in the origin private file system:
+ *
+ *   sampler/library.json           names of the imported instruments
+ *   sampler/<name>/instrument.json InstrumentManifest
+ *   sampler/<name>/<n>.pcm         zone n: interleaved 16-bit PCM, no header
+ *
+ * Samples are decoded once, at import, so playback can read any frame range
+ * with a plain byte-range read instead of decoding a compressed file.
+ */
+
+export const LIBRARY_DIR = 'sampler';
+export const LIBRARY_INDEX = 'library.json';
+export const MANIFEST_FILE = 'instrument.json';
+export const BYTES_PER_SAMPLE = 2;
+
+export interface ZoneManifest {
+    /** PCM file inside the instrument directory */
+    file: string;
+    /** Pitch the sample was recorded at */
+    rootHz: number;
+    sampleRate: number;
+    channels: number;
+    frames: number;
+}
+
+export interface InstrumentManifest {
+    name: string;
+    /** Sorted by rootHz */
+    zones: ZoneManifest[];
+}
@@ -0,0 +1,117 @@
+import { LIBRARY_DIR, MANIFEST_FILE, BYTES_PER_SAMPLE, InstrumentManifest } from './format';
+
+/**
+ * Sample stream worker: reads sampler instruments from the origin private file
+ * system and feeds the streaming sampler worklet directly over a MessagePort.
+ *
+ * Messages in (main):    { type: 'port', port } | { type: 'open', name, headSeconds }
+ * Messages out (main):   { type: 'opened', name, zones } | { type: 'error', name, message }
+ * Messages in (worklet): { type: 'read', slot, token, zone, frame, frames }
+ * Messages out (worklet): { type: 'zones', zones } | { type: 'chunk', slot, token, frame, channels }
+ *
+ * Reads are served one at a time, in request order, which is what the worklet
+ * expects for each voice.
+ */
+
+interface ReadRequest {
+    slot: number;
+    token: number;
+    zone: number;
+    frame: number;
+    frames: number;
+}
+
+let worklet: MessagePort | null = null;
+let manifest: InstrumentManifest | null = null;
+let files: File[] = [];
+let queue: ReadRequest[] = [];
+let reading = false;
+
+/**
+ * Read a frame range of one zone as planar float channels
+ */
+async function readFrames(zone: number, frame: number, count: number): Promise<Float32Array[]> {
+    const info = manifest!.zones[zone];
+    const frameBytes = info.channels * BYTES_PER_SAMPLE;
+    const bytes = await files[zone].slice(frame * frameBytes, (frame + count) * frameBytes).arrayBuffer();
+    const pcm = new Int16Array(bytes);
+    const frames = pcm.length / info.channels;
+
+    const channels = Array.from({ length: info.channels }, () => new Float32Array(frames));
+    for (let f = 0; f < frames; f++) {
+        for (let ch = 0; ch < info.channels; ch++) {
+            channels[ch][f] = pcm[f * info.channels + ch] / 32768;
+        }
+    }
+    return channels;
+}
+
+async function pump(): Promise<void> {
+    if (reading) return;
+    reading = true;
+    while (queue.length > 0) {
+        const request = queue.shift()!;
+        // Requests for an instrument that has since been replaced
+        if (!manifest || request.zone >= files.length) continue;
+        try {
+            const channels = await readFrames(request.zone, request.frame, request.frames);
+            worklet?.postMessage(
+                { type: 'chunk', slot: request.slot, token: request.token, frame: request.frame, channels },
+                channels.map(channel => channel.buffer)
+            );
+        } catch (err) {
+            console.error('[SampleStream] Read failed:', err);
+        }
+    }
+    reading = false;
+}
+
+async function open(name: string, headSeconds: number): Promise<void> {
+    const root = await (await navigator.storage.getDirectory()).getDirectoryHandle(LIBRARY_DIR);
+    const dir = await root.getDirectoryHandle(name);
+    const next: InstrumentManifest = JSON.parse(await (await (await dir.getFileHandle(MANIFEST_FILE)).getFile()).text());
+    const nextFiles = await Promise.all(next.zones.map(async zone => (await dir.getFileHandle(zone.file)).getFile()));
+
+    manifest = next;
+    files = nextFiles;
+    queue = [];
+
+    // Heads stay resident in the worklet; everything after them is streamed
+    const heads: Float32Array[][] = [];
+    for (let z = 0; z < next.zones.length; z++) {
+        const zone = next.zones[z];
+        heads.push(await readFrames(z, 0, Math.min(zone.frames, Math.round(headSeconds * zone.sampleRate))));
+    }
+    worklet?.postMessage(
+        { type: 'zones', zones: heads.map((head, z) => ({ head, frames: next.zones[z].frames })) },
+        heads.flatMap(head => head.map(channel => channel.buffer))
+    );
+
+    self.postMessage({
+        type: 'opened',
+        name,
+        zones: next.zones.map((zone, z) => ({
+            rootHz: zone.rootHz,
+            sampleRate: zone.sampleRate,
+            frames: zone.frames,
+            headFrames: heads[z][0].length
+        }))
+    });
+}
+
+self.onmessage = (e: MessageEvent) => {
+    const msg = e.data;
+    if (msg.type === 'port') {
+        worklet = msg.port as MessagePort;
+        worklet.onmessage = (event: MessageEvent) => {
+            if (event.data.type === 'read') {
+                queue.push(event.data);
+                pump();
+            }
+        };
+    } else if (msg.type === 'open') {
+        open(msg.name, msg.headSeconds).catch(err => {
+            self.postMessage({ type: 'error', name: msg.name, message: String(err) });
+        });
+    }
+};
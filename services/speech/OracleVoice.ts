@@ -0,0 +1,75 @@
+import { ensureWorklets } from '../worklets/workletLoader';
+import { buildVoiceScore } from './galicianPhonemes';
+
+/**
+ * In-graph oracle voice.
+ * Wraps the formant-voice worklet so speech renders inside the Web Audio graph
+ * (routable through effects, pannable and recordable) instead of platform TTS.
+ */
+export class OracleVoice {
+    /** Connect this to wherever the voice should enter the graph */
+    public readonly output: GainNode;
+
+    private node: AudioWorkletNode | null = null;
+    private readonly ready: Promise<void>;
+    private nextId = 1;
+    private pending = new Map<number, () => void>();
+
+    constructor(ctx: BaseAudioContext) {
+        this.output = ctx.createGain();
+        this.output.gain.value = 1.0;
+
+        // Load eagerly so the first utterance starts within a render quantum
+        this.ready = ensureWorklets(ctx).then(() => {
+            this.node = new AudioWorkletNode(ctx, 'formant-voice', {
+                numberOfInputs: 0,
+                numberOfOutputs: 1,
+                outputChannelCount: [1]
+            });
+            this.node.port.onmessage = (e: MessageEvent) => {
+                if (e.data.type === 'done') {
+                    this.resolve(e.data.id);
+                }
+            };
+            this.node.connect(this.output);
+        });
+        this.ready.catch((err) => console.error('[OracleVoice] Worklet load failed:', err));
+    }
+
+    /**
+     * Speak the text. Resolves when the utterance finishes or is stopped.
+     */
+    async speak(text: string): Promise<void> {
+        await this.ready;
+        if (!this.node) return;
+
+        const score = buildVoiceScore(text);
+        if (score.length === 0) return;
+
+        // Only one utterance at a time: release any previous waiter
+        this.pending.forEach(done => done());
+        this.pending.clear();
+
+        const id = this.nextId++;
+        return new Promise<void>((resolve) => {
+            this.pending.set(id, resolve);
+            this.node!.port.postMessage({ type: 'speak', id, score }, [score.buffer]);
+        });
+    }
+
+    stop(): void {
+        this.node?.port.postMessage({ type: 'stop' });
+    }
+
+    isSpeaking(): boolean {
+        return this.pending.size > 0;
+    }
+
+    private resolve(id: number): void {
+        const done = this.pending.get(id);
+        if (done) {
+            this.pending.delete(id);
+            done();
+        }
+    }
+}
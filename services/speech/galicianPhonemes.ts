@@ -0,0 +1,197 @@
+/**
+ * Rule-based Galician grapheme-to-phoneme conversion and prosody.
+ * Turns the oracle's short description into a formant score for FormantVoiceKernel.
+ */
+
+type PhonemeKind = 'vowel' | 'glide' | 'nasal' | 'liquid' | 'tap' | 'fricative' | 'stop' | 'affricate';
+
+interface PhonemeSpec {
+    kind: PhonemeKind;
+    formants?: [number, number, number];
+    voice: number;
+    noise: number;
+    noiseFreq: number;
+    duration: number;
+}
+
+// Low male register; the oracle speaks slowly
+const BASE_F0 = 104;
+const RATE = 1.15;
+
+const PHONEMES: Record<string, PhonemeSpec> = {
+    a: { kind: 'vowel', formants: [700, 1220, 2600], voice: 1, noise: 0, noiseFreq: 0, duration: 0.09 },
+    e: { kind: 'vowel', formants: [470, 1850, 2550], voice: 1, noise: 0, noiseFreq: 0, duration: 0.085 },
+    i: { kind: 'vowel', formants: [290, 2250, 2900], voice: 0.95, noise: 0, noiseFreq: 0, duration: 0.08 },
+    o: { kind: 'vowel', formants: [480, 880, 2500], voice: 1, noise: 0, noiseFreq: 0, duration: 0.09 },
+    u: { kind: 'vowel', formants: [320, 750, 2400], voice: 0.9, noise: 0, noiseFreq: 0, duration: 0.08 },
+    j: { kind: 'glide', formants: [300, 2200, 2900], voice: 0.8, noise: 0, noiseFreq: 0, duration: 0.04 },
+    w: { kind: 'glide', formants: [330, 700, 2300], voice: 0.8, noise: 0, noiseFreq: 0, duration: 0.04 },
+    m: { kind: 'nasal', formants: [280, 1100, 2300], voice: 0.55, noise: 0, noiseFreq: 0, duration: 0.06 },
+    n: { kind: 'nasal', formants: [280, 1600, 2500], voice: 0.55, noise: 0, noiseFreq: 0, duration: 0.055 },
+    ny: { kind: 'nasal', formants: [280, 2100, 2700], voice: 0.55, noise: 0, noiseFreq: 0, duration: 0.07 },
+    ng: { kind: 'nasal', formants: [280, 1300, 2400], voice: 0.5, noise: 0, noiseFreq: 0, duration: 0.06 },
+    l: { kind: 'liquid', formants: [360, 1300, 2700], voice: 0.7, noise: 0, noiseFreq: 0, duration: 0.055 },
+    ll: { kind: 'liquid', formants: [300, 2000, 2800], voice: 0.7, noise: 0, noiseFreq: 0, duration: 0.07 },
+    r: { kind: 'tap', formants: [420, 1300, 1800], voice: 0.6, noise: 0.05, noiseFreq: 1500, duration: 0.03 },
+    rr: { kind: 'tap', formants: [420, 1300, 1800], voice: 0.6, noise: 0.05, noiseFreq: 1500, duration: 0.09 },
+    b: { kind: 'liquid', formants: [300, 900, 2200], voice: 0.5, noise: 0, noiseFreq: 0, duration: 0.045 },
+    d: { kind: 'liquid', formants: [300, 1600, 2600], voice: 0.5, noise: 0.04, noiseFreq: 4000, duration: 0.045 },
+    g: { kind: 'liquid', formants: [300, 1300, 2400], voice: 0.5, noise: 0, noiseFreq: 0, duration: 0.045 },
+    f: { kind: 'fricative', voice: 0, noise: 0.3, noiseFreq: 6500, duration: 0.09 },
+    s: { kind: 'fricative', voice: 0, noise: 0.55, noiseFreq: 5500, duration: 0.095 },
+    th: { kind: 'fricative', voice: 0, noise: 0.3, noiseFreq: 7500, duration: 0.09 },
+    sh: { kind: 'fricative', voice: 0, noise: 0.55, noiseFreq: 3000, duration: 0.1 },
+    kh: { kind: 'fricative', voice: 0, noise: 0.4, noiseFreq: 1600, duration: 0.085 },
+    p: { kind: 'stop', voice: 0, noise: 0.5, noiseFreq: 900, duration: 0.055 },
+    t: { kind: 'stop', voice: 0, noise: 0.55, noiseFreq: 3800, duration: 0.055 },
+    k: { kind: 'stop', voice: 0, noise: 0.6, noiseFreq: 2000, duration: 0.06 },
+    ch: { kind: 'affricate', voice: 0, noise: 0.55, noiseFreq: 3000, duration: 0.1 }
+};
+
+const VOWEL_LETTERS = 'aeiouáéíóúü';
+const ACCENTED: Record<string, string> = { 'á': 'a', 'é': 'e', 'í': 'i', 'ó': 'o', 'ú': 'u', 'ü': 'u' };
+
+interface Phone {
+    symbol: string;
+    stressed: boolean;
+}
+
+const isVowelLetter = (c: string | undefined) => !!c && VOWEL_LETTERS.includes(c);
+const isFrontVowel = (c: string | undefined) => !!c && 'eiéí'.includes(c);
+
+/**
+ * Convert a single lowercase word into phones with lexical stress.
+ */
+function wordToPhones(word: string): Phone[] {
+    const phones: Phone[] = [];
+    // Index into `phones` of every vowel nucleus, plus the one carrying a written accent
+    const nuclei: number[] = [];
+    let accented = -1;
+
+    for (let i = 0; i < word.length; i++) {
+        const c = word[i];
+        const next = word[i + 1];
+
+        if (isVowelLetter(c)) {
+            const plain = ACCENTED[c] ?? c;
+            const hasAccent = c in ACCENTED && c !== 'ü';
+            // Unstressed i/u next to another vowel become glides (diphthongs)
+            const nearVowel = isVowelLetter(word[i - 1]) || isVowelLetter(next);
+            if (!hasAccent && nearVowel && (plain === 'i' || plain === 'u')) {
+                phones.push({ symbol: plain === 'i' ? 'j' : 'w', stressed: false });
+                continue;
+            }
+            if (hasAccent) accented = phones.length;
+            nuclei.push(phones.length);
+            phones.push({ symbol: plain, stressed: false });
+            continue;
+        }
+
+        let symbol: string | null = null;
+        switch (c) {
+            case 'c':
+                if (next === 'h') { symbol = 'ch'; i++; }
+                else symbol = isFrontVowel(next) ? 'th' : 'k';
+                break;
+            case 'q':
+                symbol = 'k';
+                if (next === 'u' && isFrontVowel(word[i + 2])) i++;
+                break;
+            case 'g':
+                if (next === 'u' && isFrontVowel(word[i + 2])) { symbol = 'g'; i++; }
+                else symbol = isFrontVowel(next) ? 'sh' : 'g';
+                break;
+            case 'l':
+                if (next === 'l') { symbol = 'll'; i++; }
+                else symbol = 'l';
+                break;
+            case 'n':
+                if (next === 'h') { symbol = 'ng'; i++; }
+                else symbol = 'n';
+                break;
+            case 'ñ': symbol = 'ny'; break;
+            case 'r':
+                if (next === 'r') { symbol = 'rr'; i++; }
+                else symbol = i === 0 ? 'rr' : 'r';
+                break;
+            case 'x': symbol = 'sh'; break;
+            case 'z': symbol = 'th'; break;
+            case 'j': symbol = 'kh'; break;
+            case 'v':
+            case 'w': symbol = 'b'; break;
+            case 'y': symbol = 'j'; break;
+            case 'h': symbol = null; break;
+            default:
+                symbol = PHONEMES[c] ? c : null;
+        }
+        if (symbol) phones.push({ symbol, stressed: false });
+    }
+
+    if (nuclei.length > 0) {
+        let stressIndex = accented;
+        if (stressIndex < 0) {
+            // Paroxytone by default for words ending in vowel, -n or -s
+            const last = word[word.length - 1];
+            const paroxytone = isVowelLetter(last) || last === 'n' || last === 's';
+            stressIndex = paroxytone && nuclei.length > 1 ? nuclei[nuclei.length - 2] : nuclei[nuclei.length - 1];
+        }
+        phones[stressIndex].stressed = true;
+    }
+    return phones;
+}
+
+/**
+ * Build a formant score (see FormantVoiceKernel) for the given Galician text.
+ */
+export function buildVoiceScore(text: string): Float32Array {
+    const segments: number[] = [];
+    let formants: [number, number, number] = [500, 1500, 2500];
+
+    const push = (duration: number, f0: number, voice: number, noise: number, noiseFreq: number) => {
+        segments.push(duration * RATE, f0, formants[0], formants[1], formants[2], voice, noise, noiseFreq);
+    };
+
+    // Split into phrases on punctuation so pitch declination resets and pauses land naturally
+    const phrases = text.toLowerCase().split(/([.,;:!?¡¿…\n]+)/);
+    for (let p = 0; p < phrases.length; p += 2) {
+        const words = phrases[p].split(/[^a-záéíóúüñ]+/).filter(Boolean);
+        const punctuation = phrases[p + 1] ?? '.';
+        const isQuestion = punctuation.includes('?');
+        const phones = words.flatMap(wordToPhones);
+
+        phones.forEach((phone, index) => {
+            const spec = PHONEMES[phone.symbol];
+            if (!spec) return;
+            const progress = phones.length > 1 ? index / (phones.length - 1) : 0;
+            // Gentle declination; questions rise over the last third instead
+            let f0 = BASE_F0 * (1 - 0.18 * progress);
+            if (isQuestion && progress > 0.66) f0 = BASE_F0 * (1 + (progress - 0.66) * 0.8);
+            if (phone.stressed) f0 *= 1.12;
+
+            if (spec.formants) formants = spec.formants;
+
+            switch (spec.kind) {
+                case 'stop':
+                    // Closure silence, then a short burst
+                    push(spec.duration, f0, 0, 0, spec.noiseFreq);
+                    push(0.015, f0, 0, spec.noise, spec.noiseFreq);
+                    break;
+                case 'affricate':
+                    push(0.04, f0, 0, 0, spec.noiseFreq);
+                    push(spec.duration * 0.6, f0, 0, spec.noise, spec.noiseFreq);
+                    break;
+                default: {
+                    const duration = phone.stressed ? spec.duration * 1.45 : spec.duration;
+                    push(duration, f0, spec.voice, spec.noise, spec.noiseFreq);
+                }
+            }
+        });
+
+        if (phones.length > 0) {
+            const pause = /[.!?…\n]/.test(punctuation) ? 0.32 : 0.14;
+            push(pause, BASE_F0 * 0.8, 0, 0, 4000);
+        }
+    }
+
+    return new Float32Array(segments);
+}
@@ -0,0 +1,68 @@
+import { WavWriter, WavSink } from './WavWriter';
+
+/**
+ * WAV file worker: converts and writes one file in the origin private file
+ * system, off the main thread, through a synchronous access handle (the fast
+ * path that only workers have).
+ *
+ * Messages in:  { type: 'open', dir, name, sampleRate } | { type: 'write', frames } | { type: 'finish' }
+ * Messages out: { type: 'ok' } after each message, or { type: 'error', message }
+ */
+
+// Worker-only API, missing from the DOM lib the app compiles against
+interface SyncAccessHandle {
+    write(data: ArrayBuffer, options: { at: number }): number;
+    truncate(size: number): void;
+    flush(): void;
+    close(): void;
+}
+
+let writer: WavWriter | null = null;
+
+async function open(dirName: string, name: string, sampleRate: number): Promise<void> {
+    let dir = await navigator.storage.getDirectory();
+    for (const part of dirName.split('/')) {
+        if (part) dir = await dir.getDirectoryHandle(part, { create: true });
+    }
+    const file = await dir.getFileHandle(name, { create: true });
+    const handle = await (file as unknown as { createSyncAccessHandle(): Promise<SyncAccessHandle> }).createSyncAccessHandle();
+    handle.truncate(0);
+
+    let position = 0;
+    const sink: WavSink = {
+        write: async (data) => {
+            position += handle.write(data, { at: position });
+        },
+        seek: async (at) => {
+            position = at;
+        },
+        close: async () => {
+            handle.flush();
+            handle.close();
+        }
+    };
+    writer = new WavWriter(sink, sampleRate);
+    await writer.begin();
+}
+
+// Messages are handled one at a time, in order
+let queue: Promise<void> = Promise.resolve();
+
+self.onmessage = (e: MessageEvent) => {
+    const msg = e.data;
+    queue = queue.then(async () => {
+        try {
+            if (msg.type === 'open') {
+                await open(msg.dir, msg.name, msg.sampleRate);
+            } else if (msg.type === 'write') {
+                await writer!.write(msg.frames);
+            } else if (msg.type === 'finish') {
+                await writer!.finish();
+                writer = null;
+            }
+            self.postMessage({ type: 'ok' });
+        } catch (err) {
+            self.postMessage({ type: 'error', message: String(err) });
+        }
+    });
+};
@@ -0,0 +1,71 @@
+import { AdditiveBankKernel, AdditiveShape, EXPRESSION_LANES, EXPRESSION_STRIDE } from '../dsp/AdditiveBank';
+
+/**
+ * Additive bank processor: all voices' partials rendered in one node.
+ * Messages in: { type: 'noteOn', id, frequency, velocity, lane?, brightness?, pressure? } | { type: 'noteOff', id, release }
+ *            | { type: 'allOff' } | { type: 'seed', seed }
+ *            | { type: 'expression', buffer } (shared block, read in place from then on)
+ *            | { type: 'expression', values } (copy of the block, once per UI frame)
+ * Input 0 (optional): pitch to follow in Hz, e.g. a PitchTracker's frequency output.
+ */
+export class AdditiveBankProcessor extends AudioWorkletProcessor {
+    static get parameterDescriptors(): AudioParamDescriptor[] {
+        return [
+            { name: 'pressure', defaultValue: 0.7, minValue: 0, maxValue: 1, automationRate: 'k-rate' },
+            { name: 'resonance', defaultValue: 0.6, minValue: 0, maxValue: 1, automationRate: 'k-rate' },
+            { name: 'turbulence', defaultValue: 0.2, minValue: 0, maxValue: 1, automationRate: 'k-rate' }
+        ];
+    }
+
+    private kernel = new AdditiveBankKernel(sampleRate);
+    private shape: AdditiveShape = { pressure: 0.7, resonance: 0.6, turbulence: 0.2 };
+    private expression = new Float32Array(EXPRESSION_LANES * EXPRESSION_STRIDE);
+
+    constructor() {
+        super();
+        this.kernel.setExpression(this.expression);
+        this.port.onmessage = (e: MessageEvent) => {
+            const msg = e.data;
+            if (msg.type === 'noteOn') {
+                if (msg.lane !== undefined) {
+                    this.expression.set([msg.frequency, msg.brightness, msg.pressure], msg.lane * EXPRESSION_STRIDE);
+                }
+                this.kernel.noteOn(msg.id, msg.frequency, msg.velocity, msg.lane ?? -1);
+            } else if (msg.type === 'expression') {
+                if (msg.buffer) {
+                    this.expression = new Float32Array(msg.buffer);
+                    this.kernel.setExpression(this.expression);
+                } else {
+                    this.expression.set(msg.values);
+                }
+            } else if (msg.type === 'noteOff') {
+                this.kernel.noteOff(msg.id, msg.release);
+            } else if (msg.type === 'allOff') {
+                this.kernel.allNotesOff();
+            } else if (msg.type === 'seed') {
+                this.kernel.setSeed(msg.seed);
+            }
+        };
+    }
+
+    process(inputs: Float32Array[][], outputs: Float32Array[][], parameters: Record<string, Float32Array>): boolean {
+        const output = outputs[0];
+        const mono = output[0];
+        if (!mono) return true;
+
+        const shape = this.shape;
+        shape.pressure = parameters.pressure[0];
+        shape.resonance = parameters.resonance[0];
+        shape.turbulence = parameters.turbulence[0];
+
+        // Nothing connected: no channels, voices play as triggered
+        const follow = inputs[0]?.[0];
+        this.kernel.setFollow(follow ? follow[follow.length - 1] : 0);
+
+        this.kernel.process(mono, shape);
+        for (let ch = 1; ch < output.length; ch++) {
+            output[ch].set(mono);
+        }
+        return true;
+    }
+}
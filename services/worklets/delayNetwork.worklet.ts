@@ -0,0 +1,45 @@
+import { DelayNetworkKernel, DelayNetworkParams, MAX_TAPS } from '../dsp/DelayNetwork';
+
+/**
+ * Delay network processor: the whole feedback loop in one node.
+ * Options: processorOptions.maxSeconds (longest delay, default 4).
+ * Parameters are k-rate; the kernel smooths time changes itself.
+ */
+export class DelayNetworkProcessor extends AudioWorkletProcessor {
+    static get parameterDescriptors(): AudioParamDescriptor[] {
+        return [
+            { name: 'time', defaultValue: 0.5, minValue: 0, maxValue: 60, automationRate: 'k-rate' },
+            { name: 'feedback', defaultValue: 0.4, minValue: 0, maxValue: 0.98, automationRate: 'k-rate' },
+            { name: 'modDepth', defaultValue: 0, minValue: 0, maxValue: 1, automationRate: 'k-rate' },
+            { name: 'modRate', defaultValue: 0.1, minValue: 0, maxValue: 50, automationRate: 'k-rate' },
+            { name: 'damping', defaultValue: 12000, minValue: 20, maxValue: 24000, automationRate: 'k-rate' },
+            { name: 'drive', defaultValue: 0, minValue: 0, maxValue: 1, automationRate: 'k-rate' },
+            { name: 'taps', defaultValue: 1, minValue: 1, maxValue: MAX_TAPS, automationRate: 'k-rate' }
+        ];
+    }
+
+    private kernel: DelayNetworkKernel;
+    private params: DelayNetworkParams = { time: 0.5, feedback: 0.4, modDepth: 0, modRate: 0.1, damping: 12000, drive: 0, taps: 1 };
+
+    constructor(options?: AudioWorkletNodeOptions) {
+        super();
+        this.kernel = new DelayNetworkKernel(sampleRate, options?.processorOptions?.maxSeconds ?? 4, 2);
+    }
+
+    process(inputs: Float32Array[][], outputs: Float32Array[][], parameters: Record<string, Float32Array>): boolean {
+        const output = outputs[0];
+        if (!output || output.length === 0) return true;
+
+        const p = this.params;
+        p.time = parameters.time[0];
+        p.feedback = parameters.feedback[0];
+        p.modDepth = parameters.modDepth[0];
+        p.modRate = parameters.modRate[0];
+        p.damping = parameters.damping[0];
+        p.drive = parameters.drive[0];
+        p.taps = parameters.taps[0];
+
+        this.kernel.process(inputs[0] ?? [], output, p);
+        return true;
+    }
+}
@@ -0,0 +1,36 @@
+import { FeedbackSuppressorKernel } from '../dsp/FeedbackSuppressor';
+
+/**
+ * Feedback suppressor processor: notch bank in line, howl analysis on the side.
+ * Messages in:  { type: 'reset' }
+ * Messages out: { type: 'notches', notches: { frequency, depthDb }[] } whenever the bank changes
+ */
+export class FeedbackSuppressorProcessor extends AudioWorkletProcessor {
+    private kernel = new FeedbackSuppressorKernel(sampleRate);
+
+    constructor() {
+        super();
+        this.port.onmessage = (e: MessageEvent) => {
+            if (e.data.type === 'reset') this.kernel.reset();
+        };
+    }
+
+    process(inputs: Float32Array[][], outputs: Float32Array[][]): boolean {
+        const input = inputs[0];
+        const output = outputs[0];
+        if (!input || input.length === 0) {
+            output.forEach(channel => channel.fill(0));
+            return true;
+        }
+
+        for (let ch = 0; ch < output.length; ch++) {
+            output[ch].set(input[Math.min(ch, input.length - 1)]);
+        }
+        this.kernel.process(output);
+
+        if (this.kernel.takeChanged()) {
+            this.port.postMessage({ type: 'notches', notches: this.kernel.getNotches() });
+        }
+        return true;
+    }
+}
@@ -0,0 +1,48 @@
+import { FormantVoiceKernel } from '../dsp/FormantVoice';
+
+/**
+ * Oracle voice processor: renders phoneme scores posted from the main thread.
+ * Messages in:  { type: 'speak', id, score: Float32Array } | { type: 'stop' }
+ * Messages out: { type: 'done', id }
+ */
+export class FormantVoiceProcessor extends AudioWorkletProcessor {
+    private kernel = new FormantVoiceKernel(sampleRate);
+    private currentId = 0;
+
+    constructor() {
+        super();
+        this.port.onmessage = (e: MessageEvent) => {
+            const msg = e.data;
+            if (msg.type === 'speak') {
+                this.notifyDone();
+                this.currentId = msg.id;
+                this.kernel.load(msg.score);
+            } else if (msg.type === 'stop') {
+                this.kernel.stop();
+            }
+        };
+    }
+
+    process(_inputs: Float32Array[][], outputs: Float32Array[][]): boolean {
+        const output = outputs[0];
+        const mono = output[0];
+        if (!mono) return true;
+
+        const wasActive = this.kernel.isActive();
+        this.kernel.process(mono);
+        for (let ch = 1; ch < output.length; ch++) {
+            output[ch].set(mono);
+        }
+
+        if (wasActive && !this.kernel.isActive()) {
+            this.notifyDone();
+        }
+        return true;
+    }
+
+    private notifyDone(): void {
+        if (this.currentId === 0) return;
+        this.port.postMessage({ type: 'done', id: this.currentId });
+        this.currentId = 0;
+    }
+}
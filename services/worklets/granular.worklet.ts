@@ -0,0 +1,59 @@
+import { GrainCloudKernel, GrainCloudParams } from '../dsp/GrainCloud';
+
+/**
+ * Granular cloud processor. Grain scheduling happens entirely on the audio thread.
+ * Messages in:  { type: 'source', channels: Float32Array[] } | { type: 'run', running: boolean }
+ *               | { type: 'seed', seed }
+ * Messages out: { type: 'grains', count } (a few times per second, for the UI)
+ */
+export class GranularProcessor extends AudioWorkletProcessor {
+    static get parameterDescriptors(): AudioParamDescriptor[] {
+        return [
+            { name: 'position', defaultValue: 0.5, minValue: 0, maxValue: 1, automationRate: 'k-rate' },
+            { name: 'spray', defaultValue: 0.1, minValue: 0, maxValue: 1, automationRate: 'k-rate' },
+            { name: 'density', defaultValue: 20, minValue: 0.5, maxValue: 400, automationRate: 'k-rate' },
+            { name: 'size', defaultValue: 0.1, minValue: 0.005, maxValue: 1, automationRate: 'k-rate' },
+            { name: 'pitch', defaultValue: 1, minValue: 0.125, maxValue: 8, automationRate: 'k-rate' }
+        ];
+    }
+
+    private kernel = new GrainCloudKernel(sampleRate);
+    private params: GrainCloudParams = { position: 0.5, spray: 0.1, density: 20, size: 0.1, pitch: 1 };
+    private blocksSinceReport = 0;
+
+    constructor() {
+        super();
+        this.port.onmessage = (e: MessageEvent) => {
+            const msg = e.data;
+            if (msg.type === 'source') {
+                this.kernel.setSource(msg.channels);
+            } else if (msg.type === 'run') {
+                this.kernel.setRunning(msg.running);
+            } else if (msg.type === 'seed') {
+                this.kernel.setSeed(msg.seed);
+            }
+        };
+    }
+
+    process(_inputs: Float32Array[][], outputs: Float32Array[][], parameters: Record<string, Float32Array>): boolean {
+        const output = outputs[0];
+        const outL = output[0];
+        if (!outL) return true;
+        const outR = output[1] ?? outL;
+
+        const p = this.params;
+        p.position = parameters.position[0];
+        p.spray = parameters.spray[0];
+        p.density = parameters.density[0];
+        p.size = parameters.size[0];
+        p.pitch = parameters.pitch[0];
+
+        this.kernel.process(outL, outR, p);
+
+        if (++this.blocksSinceReport >= 64) {
+            this.blocksSinceReport = 0;
+            this.port.postMessage({ type: 'grains', count: this.kernel.getLiveGrainCount() });
+        }
+        return true;
+    }
+}
@@ -0,0 +1,37 @@
+import { AdditiveBankProcessor } from './additiveBank.worklet';
+import { DelayNetworkProcessor } from './delayNetwork.worklet';
+import { FeedbackSuppressorProcessor } from './feedbackSuppressor.worklet';
+import { FormantVoiceProcessor } from './formantVoice.worklet';
+import { GranularProcessor } from './granular.worklet';
+import { LoopPlayerProcessor } from './loopPlayer.worklet';
+import { LoudnessMeterProcessor } from './loudnessMeter.worklet';
+import { ModMatrixProcessor } from './modMatrix.worklet';
+import { OnsetProbeProcessor } from './onsetProbe.worklet';
+import { PitchTrackerProcessor } from './pitchTracker.worklet';
+import { RenderWatchProcessor } from './renderWatch.worklet';
+import { StreamSamplerProcessor } from './streamSampler.worklet';
+
+/**
+ * Processor registry: the single AudioWorklet module the app loads.
+ * Every processor is bundled here, so a context (including one recreated by
+ * resetAudioContext/restoreAudioVolume) costs one module fetch and compile.
+ * New processors export their class and get an entry below.
+ */
+const PROCESSORS: Record<string, AudioWorkletProcessorConstructor> = {
+    'additive-bank': AdditiveBankProcessor,
+    'delay-network': DelayNetworkProcessor,
+    'feedback-suppressor': FeedbackSuppressorProcessor,
+    'formant-voice': FormantVoiceProcessor,
+    'granular-cloud': GranularProcessor,
+    'wsola-loop': LoopPlayerProcessor,
+    'loudness-meter': LoudnessMeterProcessor,
+    'mod-matrix': ModMatrixProcessor,
+    'onset-probe': OnsetProbeProcessor,
+    'pitch-tracker': PitchTrackerProcessor,
+    'render-watch': RenderWatchProcessor,
+    'stream-sampler': StreamSamplerProcessor
+};
+
+for (const [name, processor] of Object.entries(PROCESSORS)) {
+    registerProcessor(name, processor);
+}
@@ -0,0 +1,45 @@
+import { WsolaKernel } from '../dsp/Wsola';
+
+/**
+ * Loop player processor: WSOLA time-stretch and pitch-shift of a looped take.
+ * Messages in:  { type: 'source', channels: Float32Array[] } | { type: 'play', playing: boolean }
+ * Messages out: { type: 'position', value } (a few times per second, for the UI)
+ */
+export class LoopPlayerProcessor extends AudioWorkletProcessor {
+    static get parameterDescriptors(): AudioParamDescriptor[] {
+        return [
+            { name: 'speed', defaultValue: 1, minValue: 0, maxValue: 4, automationRate: 'k-rate' },
+            { name: 'pitch', defaultValue: 1, minValue: 0.25, maxValue: 4, automationRate: 'k-rate' }
+        ];
+    }
+
+    private kernel = new WsolaKernel(sampleRate);
+    private blocksSinceReport = 0;
+
+    constructor() {
+        super();
+        this.port.onmessage = (e: MessageEvent) => {
+            const msg = e.data;
+            if (msg.type === 'source') {
+                this.kernel.setSource(msg.channels);
+            } else if (msg.type === 'play') {
+                this.kernel.setPlaying(msg.playing);
+            }
+        };
+    }
+
+    process(_inputs: Float32Array[][], outputs: Float32Array[][], parameters: Record<string, Float32Array>): boolean {
+        const output = outputs[0];
+        const outL = output[0];
+        if (!outL) return true;
+        const outR = output[1] ?? outL;
+
+        this.kernel.process(outL, outR, parameters.speed[0], parameters.pitch[0]);
+
+        if (this.kernel.isPlaying() && ++this.blocksSinceReport >= 64) {
+            this.blocksSinceReport = 0;
+            this.port.postMessage({ type: 'position', value: this.kernel.getPosition() });
+        }
+        return true;
+    }
+}
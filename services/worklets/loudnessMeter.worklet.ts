@@ -0,0 +1,43 @@
+import { LoudnessMeterKernel, LUFS_FLOOR } from '../dsp/LoudnessMeter';
+
+/**
+ * Loudness meter processor: one kernel per input, so a single node meters
+ * every engine bus plus the master. Inputs with nothing connected are skipped.
+ * Options: processorOptions.inputs (number of metered inputs).
+ * Messages out, every 100 ms: { type: 'loudness', momentary: number[], shortTerm: number[] }
+ */
+export class LoudnessMeterProcessor extends AudioWorkletProcessor {
+    private kernels: LoudnessMeterKernel[];
+    private momentary: number[];
+    private shortTerm: number[];
+
+    constructor(options?: AudioWorkletNodeOptions) {
+        super();
+        const count = options?.processorOptions?.inputs ?? 1;
+        this.kernels = Array.from({ length: count }, () => new LoudnessMeterKernel(sampleRate, 2));
+        this.momentary = new Array(count).fill(LUFS_FLOOR);
+        this.shortTerm = new Array(count).fill(LUFS_FLOOR);
+    }
+
+    process(inputs: Float32Array[][]): boolean {
+        let blockDone = false;
+        for (let i = 0; i < this.kernels.length; i++) {
+            const input = inputs[i];
+            if (!input || input.length === 0) {
+                this.momentary[i] = LUFS_FLOOR;
+                this.shortTerm[i] = LUFS_FLOOR;
+                continue;
+            }
+            if (this.kernels[i].process(input)) {
+                this.momentary[i] = this.kernels[i].momentary();
+                this.shortTerm[i] = this.kernels[i].shortTerm();
+                blockDone = true;
+            }
+        }
+
+        if (blockDone) {
+            this.port.postMessage({ type: 'loudness', momentary: this.momentary, shortTerm: this.shortTerm });
+        }
+        return true;
+    }
+}
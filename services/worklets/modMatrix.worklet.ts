@@ -0,0 +1,42 @@
+import { ModMatrixKernel } from '../dsp/ModMatrix';
+
+/**
+ * Modulation matrix processor. One mono output per target; input 0 feeds the
+ * envelope follower.
+ * Options: processorOptions.targets (number of outputs).
+ * Messages in: { type: 'lfo', index, rate, shape } | { type: 'envelope', attack, release }
+ *            | { type: 'random', rate } | { type: 'route', source, target, depth }
+ */
+export class ModMatrixProcessor extends AudioWorkletProcessor {
+    private kernel: ModMatrixKernel;
+    private outputBuffers: Float32Array[] = [];
+
+    constructor(options?: AudioWorkletNodeOptions) {
+        super();
+        this.kernel = new ModMatrixKernel(sampleRate, options?.processorOptions?.targets ?? 1);
+        this.port.onmessage = (e: MessageEvent) => {
+            const msg = e.data;
+            if (msg.type === 'lfo') {
+                this.kernel.setLfo(msg.index, msg.rate, msg.shape);
+            } else if (msg.type === 'envelope') {
+                this.kernel.setEnvelope(msg.attack, msg.release);
+            } else if (msg.type === 'random') {
+                this.kernel.setRandom(msg.rate);
+            } else if (msg.type === 'route') {
+                this.kernel.setRoute(msg.source, msg.target, msg.depth);
+            } else if (msg.type === 'seed') {
+                this.kernel.setSeed(msg.seed);
+            }
+        };
+    }
+
+    process(inputs: Float32Array[][], outputs: Float32Array[][]): boolean {
+        const buffers = this.outputBuffers;
+        buffers.length = outputs.length;
+        for (let t = 0; t < outputs.length; t++) buffers[t] = outputs[t][0];
+
+        const input = inputs[0] && inputs[0].length > 0 ? inputs[0][0] : undefined;
+        this.kernel.process(input, buffers, buffers[0] ? buffers[0].length : 128);
+        return true;
+    }
+}
@@ -0,0 +1,21 @@
+import { OnsetDetectorKernel } from '../dsp/OnsetDetector';
+
+/**
+ * Onset probe processor: listens to its input (no output) and reports onsets.
+ * Messages out: { type: 'onset', time } with time on the audio clock in seconds.
+ */
+export class OnsetProbeProcessor extends AudioWorkletProcessor {
+    private kernel = new OnsetDetectorKernel(sampleRate);
+
+    process(inputs: Float32Array[][]): boolean {
+        const input = inputs[0];
+        const mono = input && input[0];
+        if (!mono) return true;
+
+        const offset = this.kernel.process(mono);
+        if (offset >= 0) {
+            this.port.postMessage({ type: 'onset', time: (currentFrame + offset) / sampleRate });
+        }
+        return true;
+    }
+}
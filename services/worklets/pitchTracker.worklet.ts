@@ -0,0 +1,53 @@
+import { PitchTrackerKernel, DEFAULT_PITCH_HZ } from '../dsp/PitchTracker';
+
+// Without a shared slot the estimate is posted at most this often
+const POST_INTERVAL = 0.03;
+
+/**
+ * Pitch tracker processor. Output 0 carries the held pitch in Hz and output 1
+ * the confidence (0..1), both at audio rate so they can drive AudioParams with
+ * no main-thread hop. Each block ramps from the previous estimate to the new
+ * one to avoid zipper noise.
+ * Messages in:  { type: 'slot', buffer: SharedArrayBuffer } — [frequency, confidence] written in place
+ * Messages out: { type: 'pitch', frequency, confidence } every 30 ms when no slot was given
+ */
+export class PitchTrackerProcessor extends AudioWorkletProcessor {
+    private kernel = new PitchTrackerKernel(sampleRate);
+    private slot: Float32Array | null = null;
+    private frequency = DEFAULT_PITCH_HZ;
+    private confidence = 0;
+    private lastPost = 0;
+
+    constructor() {
+        super();
+        this.port.onmessage = (e: MessageEvent) => {
+            if (e.data.type === 'slot') this.slot = new Float32Array(e.data.buffer);
+        };
+    }
+
+    process(inputs: Float32Array[][], outputs: Float32Array[][]): boolean {
+        const input = inputs[0];
+        if (input && input.length > 0) this.kernel.process(input[0]);
+
+        const frequency = this.kernel.getFrequency();
+        const confidence = this.kernel.getConfidence();
+        this.ramp(outputs[0][0], this.frequency, frequency);
+        this.ramp(outputs[1][0], this.confidence, confidence);
+        this.frequency = frequency;
+        this.confidence = confidence;
+
+        if (this.slot) {
+            this.slot[0] = frequency;
+            this.slot[1] = confidence;
+        } else if (currentTime - this.lastPost >= POST_INTERVAL) {
+            this.lastPost = currentTime;
+            this.port.postMessage({ type: 'pitch', frequency, confidence });
+        }
+        return true;
+    }
+
+    private ramp(out: Float32Array, from: number, to: number): void {
+        const step = (to - from) / out.length;
+        for (let i = 0; i < out.length; i++) out[i] = from + step * (i + 1);
+    }
+}
@@ -0,0 +1,17 @@
+import { RenderGapDetector } from '../dsp/RenderGapDetector';
+
+/**
+ * Render watch processor: passes nothing through, reports render-thread gaps.
+ * Messages out: { type: 'gap', gapMs, time } (time on the audio clock, seconds).
+ */
+export class RenderWatchProcessor extends AudioWorkletProcessor {
+    private detector = new RenderGapDetector();
+
+    process(): boolean {
+        const gap = this.detector.tick(Date.now());
+        if (gap >= 0) {
+            this.port.postMessage({ type: 'gap', gapMs: gap, time: currentTime });
+        }
+        return true;
+    }
+}
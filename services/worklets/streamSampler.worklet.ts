@@ -0,0 +1,63 @@
+import { StreamSamplerKernel } from '../dsp/StreamSampler';
+
+/**
+ * Streaming sampler processor. Sample data comes from the sample stream worker
+ * over a second port, so neither heads nor chunks pass through the main thread.
+ * Messages in (main):   { type: 'stream', port } | { type: 'noteOn', id, zone, increment, gain, start }
+ *                     | { type: 'noteOff', id, release } | { type: 'allOff' }
+ * Messages in (stream): { type: 'zones', zones } | { type: 'chunk', slot, token, frame, channels }
+ * Messages out (stream): { type: 'read', slot, token, zone, frame, frames }
+ * Messages out (main):  { type: 'stats', voices, underruns } (a few times per second)
+ */
+export class StreamSamplerProcessor extends AudioWorkletProcessor {
+    private kernel = new StreamSamplerKernel(sampleRate);
+    private stream: MessagePort | null = null;
+    private blocksSinceReport = 0;
+
+    constructor() {
+        super();
+        this.kernel.onRead = (slot, token, zone, frame, frames) => {
+            this.stream?.postMessage({ type: 'read', slot, token, zone, frame, frames });
+        };
+        this.port.onmessage = (e: MessageEvent) => {
+            const msg = e.data;
+            if (msg.type === 'noteOn') {
+                this.kernel.noteOn(msg.id, msg.zone, msg.increment, msg.gain, msg.start);
+            } else if (msg.type === 'noteOff') {
+                this.kernel.noteOff(msg.id, msg.release);
+            } else if (msg.type === 'allOff') {
+                this.kernel.allOff();
+            } else if (msg.type === 'stream') {
+                this.stream = msg.port;
+                this.stream!.onmessage = (event: MessageEvent) => this.onStream(event.data);
+            }
+        };
+    }
+
+    private onStream(msg: any): void {
+        if (msg.type === 'chunk') {
+            this.kernel.writeChunk(msg.slot, msg.token, msg.frame, msg.channels);
+        } else if (msg.type === 'zones') {
+            this.kernel.setZones(msg.zones);
+        }
+    }
+
+    process(_inputs: Float32Array[][], outputs: Float32Array[][]): boolean {
+        const output = outputs[0];
+        const outL = output[0];
+        if (!outL) return true;
+        const outR = output[1] ?? outL;
+
+        this.kernel.process(outL, outR);
+
+        if (++this.blocksSinceReport >= 64) {
+            this.blocksSinceReport = 0;
+            this.port.postMessage({
+                type: 'stats',
+                voices: this.kernel.getActiveVoiceCount(),
+                underruns: this.kernel.getUnderrunCount()
+            });
+        }
+        return true;
+    }
+}
@@ -0,0 +1,26 @@
+/**
+ * Ambient declarations for the AudioWorkletGlobalScope.
+ * The DOM lib used by the rest of the app does not ship these, and the
+ * "AudioWorklet" lib cannot be combined with it in a single tsconfig.
+ */
+
+declare abstract class AudioWorkletProcessor {
+    readonly port: MessagePort;
+    constructor(options?: AudioWorkletNodeOptions);
+    abstract process(
+        inputs: Float32Array[][],
+        outputs: Float32Array[][],
+        parameters: Record<string, Float32Array>
+    ): boolean;
+}
+
+interface AudioWorkletProcessorConstructor {
+    new(options?: AudioWorkletNodeOptions): AudioWorkletProcessor;
+    parameterDescriptors?: AudioParamDescriptor[];
+}
+
+declare function registerProcessor(name: string, processorCtor: AudioWorkletProcessorConstructor): void;
+
+declare const sampleRate: number;
+declare const currentTime: number;
+declare const currentFrame: number;
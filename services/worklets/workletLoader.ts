@@ -0,0 +1,27 @@
+import workletsUrl from './index.worklet?worker&url';
+
+/**
+ * Shared AudioWorklet module loading.
+ * All processors live in one bundled module (index.worklet.ts), added once per
+ * context; later callers receive the same promise, even if the first load is
+ * still in flight.
+ */
+
+const loaded = new WeakMap<BaseAudioContext, Promise<void>>();
+
+/**
+ * Make every processor available on the context (one module load per context).
+ * @param ctx - Target audio context
+ */
+export function ensureWorklets(ctx: BaseAudioContext): Promise<void> {
+    let pending = loaded.get(ctx);
+    if (!pending) {
+        pending = ctx.audioWorklet.addModule(workletsUrl).catch((err) => {
+            // Allow a later retry instead of caching the failure forever
+            loaded.delete(ctx);
+            throw err;
+        });
+        loaded.set(ctx, pending);
+    }
+    return pending;
+}
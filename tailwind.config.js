@@ -0,0 +1,16 @@
+/** @type {import('tailwindcss').Config} */
+export default {
+  // Engine themes (services/engines/*.register.ts) carry class names too
+  content: [
+    './index.html',
+    './index.tsx',
+    './App.tsx',
+    './components/**/*.{ts,tsx}',
+    './hooks/**/*.{ts,tsx}',
+    './services/**/*.ts'
+  ],
+  theme: {
+    extend: {}
+  },
+  plugins: []
+};
@@ -7,6 +7,11 @@ export interface SynthState {
   diffusion: number;
 }
 
+export interface StepPattern {
+  rhythmMode?: 'libre' | 'muineira' | 'ribeirada';
+  steps: boolean[];
+}
+
 export interface PlanetaryCondition {
   stormLevel: number;
   temperature: number;
@@ -16,6 +21,15 @@ export interface PlanetaryCondition {
     numGears: number;
     arrangement: 'linear' | 'cluster' | 'chaotic';
   };
+  pattern?: StepPattern;
+}
+
+/**
+ * One oracle answer for every registered engine (keyed by engine name)
+ */
+export interface TitanScene {
+  description: string;
+  engines: Record<string, PlanetaryCondition>;
 }
 
 export enum ParameterType {
@@ -0,0 +1,4 @@
+/// <reference types="vite/client" />
+
+/** False when built with TRACE=0: tracer call sites are compiled out */
+declare const __TRACE__: boolean;